@@ -17,6 +17,11 @@ public class CelestialSyndicate : ModuleRules
             "GameplayAbilities"
         });
 
-        PrivateDependencyModuleNames.AddRange(new string[] { });
+        PrivateDependencyModuleNames.AddRange(new string[] { 
+            "HTTP",
+            "Json",
+            "MassEntity",
+            "MassCommon"
+        });
     }
 } 
\ No newline at end of file
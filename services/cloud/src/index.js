@@ -10,6 +10,7 @@ const rateLimit = require('express-rate-limit');
 const slowDown = require('express-slow-down');
 const cluster = require('cluster');
 const os = require('os');
+const crypto = require('crypto');
 require('dotenv').config();
 
 // Import service modules
@@ -60,19 +61,47 @@ const logger = winston.createLogger({
   ]
 });
 
+// Game servers export analytics in batches; they authenticate with a server key and have their own limit
+const ANALYTICS_BATCH_ROUTE = '/api/analytics/track-batch';
+const isServerRoute = (req) => req.path === ANALYTICS_BATCH_ROUTE;
+
 // Rate limiting
 const limiter = rateLimit({
   windowMs: 15 * 60 * 1000, // 15 minutes
   max: 100, // limit each IP to 100 requests per windowMs
-  message: 'Too many requests from this IP, please try again later.'
+  message: 'Too many requests from this IP, please try again later.',
+  skip: isServerRoute
 });
 
 const speedLimiter = slowDown({
   windowMs: 15 * 60 * 1000, // 15 minutes
   delayAfter: 50, // allow 50 requests per 15 minutes, then...
-  delayMs: 500 // begin adding 500ms of delay per request above 50
+  delayMs: 500, // begin adding 500ms of delay per request above 50
+  skip: isServerRoute
+});
+
+const serverLimiter = rateLimit({
+  windowMs: 60 * 1000, // 1 minute
+  max: 600, // per server key; one host exports every 30 s for each world it runs
+  keyGenerator: (req) => req.get('X-Server-Key'),
+  message: 'Too many analytics batches for this server key, please try again later.'
 });
 
+const requireServerKey = (req, res, next) => {
+  const expected = process.env.ANALYTICS_SERVER_KEY;
+  if (!expected) {
+    return res.status(503).json({ success: false, error: 'Server analytics are not configured' });
+  }
+
+  const provided = Buffer.from(req.get('X-Server-Key') || '');
+  const required = Buffer.from(expected);
+  if (provided.length !== required.length || !crypto.timingSafeEqual(provided, required)) {
+    return res.status(401).json({ success: false, error: 'Invalid server key' });
+  }
+
+  next();
+};
+
 // Middleware
 app.use(helmet());
 app.use(cors());
@@ -313,6 +342,27 @@ app.post('/api/analytics/track', async (req, res) => {
   }
 });
 
+app.post(ANALYTICS_BATCH_ROUTE, requireServerKey, serverLimiter, async (req, res) => {
+  try {
+    const { events } = req.body;
+    if (!Array.isArray(events) || events.length > 1000) {
+      return res.status(400).json({ success: false, error: 'events must be an array of at most 1000 entries' });
+    }
+
+    const result = await analyticsService.trackEvents(events);
+    
+    res.json({
+      success: true,
+      message: 'Events tracked successfully',
+      count: result.count,
+      timestamp: new Date().toISOString()
+    });
+  } catch (error) {
+    logger.error('Batch event tracking failed:', error);
+    res.status(500).json({ success: false, error: error.message });
+  }
+});
+
 app.get('/api/analytics/reports', async (req, res) => {
   try {
     const { type, timeframe, filters } = req.query;
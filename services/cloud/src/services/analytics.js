@@ -71,6 +71,13 @@ class AnalyticsService {
         fields: ['eventType', 'playerId', 'timestamp', 'gameData']
       });
 
+      this.aggregators.set('combat_stats', {
+        type: 'latest',
+        key: 'analytics:combat_stats',
+        window: '1h',
+        fields: ['matchId', 'combatantId', 'teamId', 'kills', 'deaths', 'damageDealt']
+      });
+
       this.aggregators.set('performance_metrics', {
         type: 'histogram',
         key: 'analytics:performance',
@@ -101,64 +108,114 @@ class AnalyticsService {
 
   async trackEvent(event, data, userId = null) {
     try {
-      const eventId = this.generateEventId();
-      const timestamp = new Date().toISOString();
-      
-      const eventData = {
-        id: eventId,
-        event,
-        data,
-        userId,
-        timestamp,
-        sessionId: data.sessionId || null,
-        metadata: {
-          source: 'celestial-syndicate',
-          version: '1.0.0',
-          environment: process.env.NODE_ENV || 'development'
-        }
-      };
+      const eventData = this.createEventData(event, data, userId);
 
-      // Store raw event
-      await this.redis.lpush('analytics:events', JSON.stringify(eventData));
-      await this.redis.ltrim('analytics:events', 0, 999999); // Keep last 1M events
+      // Raw stores and aggregation go out as one round trip
+      const pipeline = this.redis.pipeline();
+      this.queueEventStorage(pipeline, eventData);
+      await this.aggregateEvent(eventData, pipeline);
+      await this.execPipeline(pipeline);
 
-      // Store by event type
-      await this.redis.lpush(`analytics:events:${event}`, JSON.stringify(eventData));
-      await this.redis.ltrim(`analytics:events:${event}`, 0, 99999); // Keep last 100K per event type
+      this.publishEvent(eventData);
 
-      // Store by user if provided
-      if (userId) {
-        await this.redis.lpush(`analytics:user:${userId}:events`, JSON.stringify(eventData));
-        await this.redis.ltrim(`analytics:user:${userId}:events`, 0, 9999); // Keep last 10K per user
-      }
+      return {
+        eventId: eventData.id,
+        success: true,
+        timestamp: eventData.timestamp
+      };
 
-      // Aggregate event
-      await this.aggregateEvent(eventData);
+    } catch (error) {
+      this.logger.error('Event tracking failed:', error);
+      throw error;
+    }
+  }
 
-      // Emit real-time event
-      this.eventEmitter.emit('event', eventData);
+  async trackEvents(events) {
+    try {
+      // Batches arrive from game servers at match intervals; one pipeline keeps their order and costs one round trip
+      const pipeline = this.redis.pipeline();
+      const tracked = [];
+      for (const { event, data, userId } of events) {
+        const eventData = this.createEventData(event, data || {}, userId || null);
+        this.queueEventStorage(pipeline, eventData);
+        await this.aggregateEvent(eventData, pipeline);
+        tracked.push(eventData);
+      }
+      await this.execPipeline(pipeline);
 
-      // Log analytics event
-      this.analyticsLogger.info('Event tracked', {
-        eventId,
-        event,
-        userId,
-        timestamp
-      });
+      for (const eventData of tracked) {
+        this.publishEvent(eventData);
+      }
 
       return {
-        eventId,
+        count: tracked.length,
         success: true,
-        timestamp
+        timestamp: new Date().toISOString()
       };
 
     } catch (error) {
-      this.logger.error('Event tracking failed:', error);
+      this.logger.error('Batch event tracking failed:', error);
       throw error;
     }
   }
 
-  async aggregateEvent(eventData) {
+  createEventData(event, data, userId) {
+    return {
+      id: this.generateEventId(),
+      event,
+      data,
+      userId,
+      timestamp: new Date().toISOString(),
+      sessionId: data.sessionId || null,
+      metadata: {
+        source: 'celestial-syndicate',
+        version: '1.0.0',
+        environment: process.env.NODE_ENV || 'development'
+      }
+    };
+  }
+
+  queueEventStorage(pipeline, eventData) {
+    const { event, userId } = eventData;
+    const serialized = JSON.stringify(eventData);
+
+    // Store raw event
+    pipeline.lpush('analytics:events', serialized);
+    pipeline.ltrim('analytics:events', 0, 999999); // Keep last 1M events
+
+    // Store by event type
+    pipeline.lpush(`analytics:events:${event}`, serialized);
+    pipeline.ltrim(`analytics:events:${event}`, 0, 99999); // Keep last 100K per event type
+
+    // Store by user if provided
+    if (userId) {
+      pipeline.lpush(`analytics:user:${userId}:events`, serialized);
+      pipeline.ltrim(`analytics:user:${userId}:events`, 0, 9999); // Keep last 10K per user
+    }
+  }
+
+  async execPipeline(pipeline) {
+    const results = await pipeline.exec();
+    const failed = results.filter(([error]) => error);
+    if (failed.length > 0) {
+      this.logger.error(`Analytics pipeline: ${failed.length} of ${results.length} commands failed:`, failed[0][0]);
+    }
+  }
+
+  publishEvent(eventData) {
+    // Emit real-time event
+    this.eventEmitter.emit('event', eventData);
+
+    // Log analytics event
+    this.analyticsLogger.info('Event tracked', {
+      eventId: eventData.id,
+      event: eventData.event,
+      userId: eventData.userId,
+      timestamp: eventData.timestamp
+    });
+  }
+
+  async aggregateEvent(eventData, pipeline) {
     try {
       const { event, data, userId, timestamp } = eventData;
 
@@ -173,18 +230,22 @@ class AnalyticsService {
       const windowKey = this.getWindowKey(aggregator.window, timestamp);
       const aggregateKey = `${aggregator.key}:${windowKey}`;
 
+      // Write-only aggregators queue onto the caller's pipeline; histograms read min/max, so they go direct
       switch (aggregator.type) {
         case 'counter':
-          await this.aggregateCounter(aggregateKey, eventData, aggregator);
+          this.aggregateCounter(pipeline, aggregateKey, eventData, aggregator);
           break;
         case 'histogram':
           await this.aggregateHistogram(aggregateKey, eventData, aggregator);
           break;
         case 'sum':
-          await this.aggregateSum(aggregateKey, eventData, aggregator);
+          this.aggregateSum(pipeline, aggregateKey, eventData, aggregator);
+          break;
+        case 'latest':
+          this.aggregateLatest(pipeline, aggregateKey, eventData, aggregator);
           break;
         default:
-          await this.aggregateCounter(aggregateKey, eventData, aggregator);
+          this.aggregateCounter(pipeline, aggregateKey, eventData, aggregator);
       }
 
     } catch (error) {
@@ -192,33 +253,28 @@ class AnalyticsService {
     }
   }
 
-  async aggregateCounter(key, eventData, aggregator) {
-    try {
-      const { event, userId, timestamp } = eventData;
-      
-      // Increment total count
-      await this.redis.hincrby(key, 'total', 1);
-      
-      // Increment by event type
-      await this.redis.hincrby(key, `event:${event}`, 1);
-      
-      // Increment by user if provided
-      if (userId) {
-        await this.redis.hincrby(key, `user:${userId}`, 1);
-      }
-      
-      // Store unique users
-      if (userId) {
-        await this.redis.sadd(`${key}:users`, userId);
-      }
-      
-      // Set expiration
-      await this.redis.expire(key, this.getWindowSeconds(aggregator.window));
-      await this.redis.expire(`${key}:users`, this.getWindowSeconds(aggregator.window));
-
-    } catch (error) {
-      this.logger.error('Counter aggregation failed:', error);
+  aggregateCounter(pipeline, key, eventData, aggregator) {
+    const { event, userId } = eventData;
+    
+    // Increment total count
+    pipeline.hincrby(key, 'total', 1);
+    
+    // Increment by event type
+    pipeline.hincrby(key, `event:${event}`, 1);
+    
+    // Increment by user if provided
+    if (userId) {
+      pipeline.hincrby(key, `user:${userId}`, 1);
     }
+    
+    // Store unique users
+    if (userId) {
+      pipeline.sadd(`${key}:users`, userId);
+    }
+    
+    // Set expiration
+    pipeline.expire(key, this.getWindowSeconds(aggregator.window));
+    pipeline.expire(`${key}:users`, this.getWindowSeconds(aggregator.window));
   }
 
   async aggregateHistogram(key, eventData, aggregator) {
@@ -255,31 +311,48 @@ class AnalyticsService {
     }
   }
 
-  async aggregateSum(key, eventData, aggregator) {
-    try {
-      const { data, userId, timestamp } = eventData;
+  aggregateSum(pipeline, key, eventData, aggregator) {
+    const { data, userId } = eventData;
+    
+    if (data.amount !== undefined) {
+      // Add to total sum
+      pipeline.hincrbyfloat(key, 'total', data.amount);
       
-      if (data.amount !== undefined) {
-        // Add to total sum
-        await this.redis.hincrbyfloat(key, 'total', data.amount);
-        
-        // Add to user sum if provided
-        if (userId) {
-          await this.redis.hincrbyfloat(key, `user:${userId}`, data.amount);
-        }
-        
-        // Add to currency sum if provided
-        if (data.currency) {
-          await this.redis.hincrbyfloat(key, `currency:${data.currency}`, data.amount);
-        }
-        
-        // Set expiration
-        await this.redis.expire(key, this.getWindowSeconds(aggregator.window));
+      // Add to user sum if provided
+      if (userId) {
+        pipeline.hincrbyfloat(key, `user:${userId}`, data.amount);
+      }
+      
+      // Add to currency sum if provided
+      if (data.currency) {
+        pipeline.hincrbyfloat(key, `currency:${data.currency}`, data.amount);
       }
+      
+      // Set expiration
+      pipeline.expire(key, this.getWindowSeconds(aggregator.window));
+    }
+  }
 
-    } catch (error) {
-      this.logger.error('Sum aggregation failed:', error);
+  aggregateLatest(pipeline, key, eventData, aggregator) {
+    const { data } = eventData;
+
+    if (!data || data.matchId === undefined || data.combatantId === undefined) {
+      return;
     }
+
+    // Exports carry running totals, so the newest snapshot replaces the old one
+    const snapshot = {};
+    for (const field of aggregator.fields) {
+      if (data[field] !== undefined) {
+        snapshot[field] = data[field];
+      }
+    }
+
+    const latestKey = `${key}:${data.matchId}:${data.combatantId}`;
+    pipeline.hset(latestKey, snapshot);
+
+    // Set expiration
+    pipeline.expire(latestKey, this.getWindowSeconds(aggregator.window));
   }
 
   async generateReports(type, timeframe = '24h', filters = {}) {
@@ -0,0 +1,670 @@
+// CelestialBenchmarkSubsystem.cpp
+// Celestial Benchmark Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements scenario spawning, warmup, per-frame sampling and the CSV/JSON baseline export
+// Feature Context: Headless dedicated-server runs that CI or a Gauntlet node launches and compares against stored baselines
+// Dependencies: Unreal Engine world subsystems, CSV profiler, JSON, OrbitalSimulationSubsystem, CombatCrowdSubsystem, CombatSystem
+// Usage Example: -CelestialBenchmark=Combat -BenchmarkCount=64 -BenchmarkClass=/Game/AI/BP_AICharacter.BP_AICharacter_C
+// Security: Spawns only in the world it was created for and exits the process when done
+// Performance: Per-subsystem timings come from the CelestialFlight and CelestialCombat CSV categories captured alongside
+
+#include "CelestialBenchmarkSubsystem.h"
+#include "CombatCrowdSubsystem.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "OrbitalMechanics.h"
+#include "OrbitalSimulationSubsystem.h"
+#include "Spacecraft.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCelestialBenchmark, Log, All);
+
+namespace
+{
+    // Same layout every run so baselines stay comparable
+    constexpr int32 BenchmarkSeed = 20251;
+
+    // Circular Earth orbits, altitudes above EarthRadius (m)
+    constexpr double MinOrbitAltitude = 400000.0;
+    constexpr double MaxOrbitAltitude = 2000000.0;
+
+    // Two facing blocks of combatants, inside the default weapon and combat ranges
+    constexpr float CombatantSpacing = 150.0f; // uu
+    constexpr float TeamSeparation = 600.0f; // uu
+
+    // Running totals of allocator calls, counted by the engine allocator in builds with stats
+    bool HasAllocationCounts()
+    {
+        return UE_STATS != 0;
+    }
+
+    void ReadAllocationCalls(uint64& OutAllocations, uint64& OutFrees)
+    {
+#if UE_STATS
+        OutAllocations = static_cast<uint64>(FMalloc::TotalMallocCalls) + static_cast<uint64>(FMalloc::TotalReallocCalls);
+        OutFrees = static_cast<uint64>(FMalloc::TotalFreeCalls);
+#else
+        OutAllocations = 0;
+        OutFrees = 0;
+#endif
+    }
+
+    // LLM can only be enabled at startup (-llm, or -llmcsv for its own CSV); -1 when it is off
+    int64 ReadTrackedMemory()
+    {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+        if (FLowLevelMemTracker::IsEnabled())
+        {
+            return FLowLevelMemTracker::Get().GetTotalTrackedMemory(ELLMTracker::Default);
+        }
+#endif
+        return -1;
+    }
+
+    TSharedRef<FJsonObject> MakeTimingSummary(TArray<float> Samples)
+    {
+        TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+        if (Samples.Num() == 0)
+        {
+            return Summary;
+        }
+
+        Samples.Sort();
+        auto Percentile = [&Samples](double Fraction)
+        {
+            return Samples[FMath::Clamp(FMath::CeilToInt32(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+        };
+
+        double Sum = 0.0;
+        for (const float Sample : Samples)
+        {
+            Sum += Sample;
+        }
+
+        Summary->SetNumberField(TEXT("avg"), Sum / Samples.Num());
+        Summary->SetNumberField(TEXT("p50"), Percentile(0.50));
+        Summary->SetNumberField(TEXT("p95"), Percentile(0.95));
+        Summary->SetNumberField(TEXT("p99"), Percentile(0.99));
+        Summary->SetNumberField(TEXT("max"), Samples.Last());
+        return Summary;
+    }
+
+    const TCHAR* GetScenarioName(ECelestialBenchmarkScenario Scenario)
+    {
+        switch (Scenario)
+        {
+        case ECelestialBenchmarkScenario::Orbital:
+            return TEXT("Orbital");
+        case ECelestialBenchmarkScenario::Combat:
+            return TEXT("Combat");
+        case ECelestialBenchmarkScenario::CrowdCombat:
+            return TEXT("CrowdCombat");
+        default:
+            return TEXT("None");
+        }
+    }
+}
+
+FCelestialBenchmarkSettings FCelestialBenchmarkSettings::FromCommandLine(const TCHAR* CommandLine)
+{
+    FCelestialBenchmarkSettings Settings;
+
+    FString ScenarioName;
+    if (!FParse::Value(CommandLine, TEXT("CelestialBenchmark="), ScenarioName))
+    {
+        return Settings;
+    }
+
+    for (const ECelestialBenchmarkScenario Scenario : { ECelestialBenchmarkScenario::Orbital, ECelestialBenchmarkScenario::Combat, ECelestialBenchmarkScenario::CrowdCombat })
+    {
+        if (ScenarioName.Equals(GetScenarioName(Scenario), ESearchCase::IgnoreCase))
+        {
+            Settings.Scenario = Scenario;
+        }
+    }
+
+    FParse::Value(CommandLine, TEXT("BenchmarkCount="), Settings.Count);
+    FParse::Value(CommandLine, TEXT("BenchmarkTimeAccel="), Settings.TimeAcceleration);
+    FParse::Value(CommandLine, TEXT("BenchmarkWarmup="), Settings.WarmupSeconds);
+    FParse::Value(CommandLine, TEXT("BenchmarkFrames="), Settings.MeasureFrames);
+    FParse::Value(CommandLine, TEXT("BenchmarkClass="), Settings.ActorClassPath);
+    FParse::Value(CommandLine, TEXT("BenchmarkName="), Settings.Name);
+    FParse::Value(CommandLine, TEXT("BenchmarkOutput="), Settings.OutputDirectory);
+    Settings.bBurning = FParse::Param(CommandLine, TEXT("BenchmarkBurn"));
+
+    Settings.Count = FMath::Max(Settings.Count, 1);
+    Settings.MeasureFrames = FMath::Max(Settings.MeasureFrames, 1);
+
+    if (Settings.Name.IsEmpty())
+    {
+        if (Settings.Scenario == ECelestialBenchmarkScenario::Orbital)
+        {
+            Settings.Name = FString::Printf(TEXT("Orbital_%d_%s_x%g"), Settings.Count, Settings.bBurning ? TEXT("Burning") : TEXT("Coasting"), Settings.TimeAcceleration);
+        }
+        else
+        {
+            Settings.Name = FString::Printf(TEXT("%s_%dv%d"), GetScenarioName(Settings.Scenario), Settings.Count, Settings.Count);
+        }
+    }
+
+    if (Settings.OutputDirectory.IsEmpty())
+    {
+        Settings.OutputDirectory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("Benchmarks"));
+    }
+
+    return Settings;
+}
+
+UCelestialBenchmarkSubsystem::UCelestialBenchmarkSubsystem()
+{
+    MemorySampleInterval = 60;
+
+    Phase = EPhase::Setup;
+    PhaseStartTime = 0.0;
+    LastUsedMemory = 0;
+    StartUsedMemory = 0;
+    PeakUsedMemory = 0;
+    NumSpawned = 0;
+    LastAllocationCalls = 0;
+    LastFreeCalls = 0;
+    MeasureStartTime = 0.0;
+    MeasureEndTime = 0.0;
+    StartInBytes = 0;
+    StartOutBytes = 0;
+    EndInBytes = 0;
+    EndOutBytes = 0;
+    bOwnsCsvCapture = false;
+}
+
+bool UCelestialBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    if (!Super::ShouldCreateSubsystem(Outer))
+    {
+        return false;
+    }
+
+    const UWorld* World = Cast<UWorld>(Outer);
+    FString ScenarioName;
+    return World && World->IsGameWorld() && FParse::Value(FCommandLine::Get(), TEXT("CelestialBenchmark="), ScenarioName);
+}
+
+void UCelestialBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    Collection.InitializeDependency<UCombatCrowdSubsystem>();
+
+    Settings = FCelestialBenchmarkSettings::FromCommandLine(FCommandLine::Get());
+}
+
+void UCelestialBenchmarkSubsystem::Deinitialize()
+{
+    // The world went away mid-run, e.g. a map change; leave no capture running
+    if (Phase == EPhase::Measure)
+    {
+        UE_LOG(LogCelestialBenchmark, Warning, TEXT("Benchmark %s ended before measurement finished; no baseline written"), *Settings.Name);
+
+#if CSV_PROFILER
+        if (bOwnsCsvCapture)
+        {
+            FCsvProfiler::Get()->EndCapture();
+            bOwnsCsvCapture = false;
+        }
+#endif
+    }
+
+    Super::Deinitialize();
+}
+
+void UCelestialBenchmarkSubsystem::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    switch (Phase)
+    {
+    case EPhase::Setup:
+        // Actors spawned before BeginPlay would miss their own BeginPlay setup
+        if (!GetWorld()->HasBegunPlay())
+        {
+            return;
+        }
+
+        if (!SpawnScenario())
+        {
+            Finish(false);
+            return;
+        }
+
+        UE_LOG(LogCelestialBenchmark, Display, TEXT("Benchmark %s: spawned %d, warming up for %.1f s"), *Settings.Name, NumSpawned, Settings.WarmupSeconds);
+        Phase = EPhase::Warmup;
+        PhaseStartTime = Now;
+        break;
+
+    case EPhase::Warmup:
+        if (Now - PhaseStartTime >= Settings.WarmupSeconds)
+        {
+            BeginMeasurement();
+        }
+        break;
+
+    case EPhase::Measure:
+        RecordFrame();
+        if (Frames.Num() >= Settings.MeasureFrames)
+        {
+            FinishMeasurement();
+            Finish(true);
+        }
+        break;
+
+    case EPhase::Finished:
+        break;
+    }
+}
+
+TStatId UCelestialBenchmarkSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCelestialBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+bool UCelestialBenchmarkSubsystem::SpawnScenario()
+{
+    if (GetWorld()->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Benchmark %s must run on a server or standalone"), *Settings.Name);
+        return false;
+    }
+
+    switch (Settings.Scenario)
+    {
+    case ECelestialBenchmarkScenario::Orbital:
+        return SpawnShips();
+    case ECelestialBenchmarkScenario::Combat:
+        return SpawnCombatants();
+    case ECelestialBenchmarkScenario::CrowdCombat:
+        return SpawnCrowdCombatants();
+    default:
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Unknown benchmark scenario; expected Orbital, Combat or CrowdCombat"));
+        return false;
+    }
+}
+
+bool UCelestialBenchmarkSubsystem::SpawnShips()
+{
+    UClass* ShipClass = Settings.ActorClassPath.IsEmpty() ? ASpacecraft::StaticClass() : LoadClass<ASpacecraft>(nullptr, *Settings.ActorClassPath);
+    if (!ShipClass)
+    {
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Benchmark ship class %s is not an ASpacecraft"), *Settings.ActorClassPath);
+        return false;
+    }
+
+    UWorld* World = GetWorld();
+    const UOrbitalSimulationSubsystem* Simulation = World->GetSubsystem<UOrbitalSimulationSubsystem>();
+    const UOrbitalMechanics* Defaults = GetDefault<UOrbitalMechanics>();
+    const double Mu = Defaults->GravitationalConstant * Defaults->EarthMass;
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    FRandomStream Random(BenchmarkSeed);
+    for (int32 i = 0; i < Settings.Count; i++)
+    {
+        // Random circular orbit about the default Earth-centred parent, facing prograde
+        const double Radius = Defaults->EarthRadius + Random.FRandRange(MinOrbitAltitude, MaxOrbitAltitude);
+        const FVector Position = Random.GetUnitVector() * Radius;
+        const FVector Prograde = FVector::CrossProduct(Position, Random.GetUnitVector()).GetSafeNormal();
+
+        const FVector WorldPosition = Simulation ? Simulation->OrbitalToWorld(Position) : Position;
+        ASpacecraft* Ship = World->SpawnActor<ASpacecraft>(ShipClass, FTransform(Prograde.Rotation(), WorldPosition), SpawnParams);
+        if (!Ship)
+        {
+            continue;
+        }
+
+        // Registering after BeginPlay runs the component's BeginPlay, which joins the simulation
+        UOrbitalMechanics* Orbital = Ship->FindComponentByClass<UOrbitalMechanics>();
+        if (!Orbital)
+        {
+            Orbital = NewObject<UOrbitalMechanics>(Ship);
+            Ship->AddInstanceComponent(Orbital);
+            Orbital->RegisterComponent();
+        }
+
+        Orbital->CurrentVelocity = Prograde * FMath::Sqrt(Mu / Orbital->CurrentPosition.Size());
+        Orbital->CalculateOrbitalElements();
+        Orbital->SetTimeAcceleration(Settings.TimeAcceleration);
+
+        if (Settings.bBurning)
+        {
+            FSpacecraftFlightCommand Command;
+            Command.Thrust = Ship->GetMaxThrust();
+            Ship->ApplyFlightCommand(Command);
+        }
+
+        NumSpawned++;
+    }
+
+    return NumSpawned > 0;
+}
+
+bool UCelestialBenchmarkSubsystem::SpawnCombatants()
+{
+    UClass* CombatantClass = Settings.ActorClassPath.IsEmpty() ? nullptr : LoadClass<APawn>(nullptr, *Settings.ActorClassPath);
+    if (!CombatantClass)
+    {
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Combat benchmark needs -BenchmarkClass=<AI pawn class with a UCombatSystem>"));
+        return false;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    for (int32 TeamId = 0; TeamId < 2; TeamId++)
+    {
+        for (int32 i = 0; i < Settings.Count; i++)
+        {
+            APawn* Pawn = GetWorld()->SpawnActor<APawn>(CombatantClass, GetCombatantTransform(TeamId, i), SpawnParams);
+            UCombatSystem* Combat = Pawn ? Pawn->FindComponentByClass<UCombatSystem>() : nullptr;
+            if (!Combat)
+            {
+                UE_LOG(LogCelestialBenchmark, Error, TEXT("Benchmark combatant class %s has no UCombatSystem"), *Settings.ActorClassPath);
+                if (Pawn)
+                {
+                    Pawn->Destroy();
+                }
+                return false;
+            }
+
+            if (!Pawn->GetController())
+            {
+                Pawn->SpawnDefaultController();
+            }
+
+            FCombatCrowdState State = Combat->GetCrowdState();
+            State.TeamId = TeamId;
+            Combat->ApplyCrowdState(State);
+            NumSpawned++;
+        }
+    }
+
+    return true;
+}
+
+bool UCelestialBenchmarkSubsystem::SpawnCrowdCombatants()
+{
+    UCombatCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UCombatCrowdSubsystem>();
+    if (!Crowd)
+    {
+        return false;
+    }
+
+    for (int32 TeamId = 0; TeamId < 2; TeamId++)
+    {
+        for (int32 i = 0; i < Settings.Count; i++)
+        {
+            // No actor class: headless runs have no players to promote for
+            FCombatCrowdState State;
+            State.TeamId = TeamId;
+            if (Crowd->SpawnCombatant(GetCombatantTransform(TeamId, i), State, nullptr).IsSet())
+            {
+                NumSpawned++;
+            }
+        }
+    }
+
+    return NumSpawned > 0;
+}
+
+FTransform UCelestialBenchmarkSubsystem::GetCombatantTransform(int32 TeamId, int32 Index) const
+{
+    const int32 Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Settings.Count)));
+    const int32 Row = Index / Columns;
+    const int32 Column = Index % Columns;
+
+    // Team 0 faces +X from the negative side, team 1 faces back
+    const float Side = TeamId == 0 ? -1.0f : 1.0f;
+    const FVector Location(Side * (TeamSeparation * 0.5f + Row * CombatantSpacing), (Column - Columns * 0.5f) * CombatantSpacing, 0.0f);
+    return FTransform(FRotator(0.0f, TeamId == 0 ? 0.0f : 180.0f, 0.0f), Location);
+}
+
+void UCelestialBenchmarkSubsystem::BeginMeasurement()
+{
+    Frames.Reset(Settings.MeasureFrames);
+
+    LastUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+    StartUsedMemory = LastUsedMemory;
+    PeakUsedMemory = LastUsedMemory;
+    ReadAllocationCalls(LastAllocationCalls, LastFreeCalls);
+
+    if (const UNetDriver* NetDriver = GetNetDriver())
+    {
+        StartInBytes = NetDriver->InTotalBytes;
+        StartOutBytes = NetDriver->OutTotalBytes;
+    }
+
+#if CSV_PROFILER
+    // Leave a capture started with -csvprofile alone
+    FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+    if (!CsvProfiler->IsCapturing())
+    {
+        CsvProfiler->BeginCapture(-1, Settings.OutputDirectory, Settings.Name + TEXT(".Profile.csv"));
+        bOwnsCsvCapture = true;
+    }
+#endif
+
+    UE_LOG(LogCelestialBenchmark, Display, TEXT("Benchmark %s: measuring %d frames"), *Settings.Name, Settings.MeasureFrames);
+    MeasureStartTime = FPlatformTime::Seconds();
+    Phase = EPhase::Measure;
+}
+
+void UCelestialBenchmarkSubsystem::RecordFrame()
+{
+    if (Frames.Num() % FMath::Max(MemorySampleInterval, 1) == 0)
+    {
+        LastUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+        PeakUsedMemory = FMath::Max(PeakUsedMemory, LastUsedMemory);
+    }
+
+    const double DeltaSeconds = FApp::GetDeltaTime();
+
+    FCelestialBenchmarkFrame& Frame = Frames.AddDefaulted_GetRef();
+    Frame.FrameMs = static_cast<float>(DeltaSeconds * 1000.0);
+    Frame.WorkMs = static_cast<float>(FMath::Max(DeltaSeconds - FApp::GetIdleTime(), 0.0) * 1000.0);
+    Frame.UsedMemory = LastUsedMemory;
+    Frame.NumSimulated = CountSimulated();
+
+    // Frames is reserved up front, so the harness adds no allocations of its own
+    uint64 AllocationCalls, FreeCalls;
+    ReadAllocationCalls(AllocationCalls, FreeCalls);
+    Frame.Allocations = HasAllocationCounts() ? static_cast<int64>(AllocationCalls - LastAllocationCalls) : -1;
+    Frame.Frees = HasAllocationCounts() ? static_cast<int64>(FreeCalls - LastFreeCalls) : -1;
+    LastAllocationCalls = AllocationCalls;
+    LastFreeCalls = FreeCalls;
+    Frame.TrackedMemory = ReadTrackedMemory();
+}
+
+void UCelestialBenchmarkSubsystem::FinishMeasurement()
+{
+    MeasureEndTime = FPlatformTime::Seconds();
+
+    LastUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+    PeakUsedMemory = FMath::Max(PeakUsedMemory, LastUsedMemory);
+
+    if (const UNetDriver* NetDriver = GetNetDriver())
+    {
+        EndInBytes = NetDriver->InTotalBytes;
+        EndOutBytes = NetDriver->OutTotalBytes;
+    }
+
+#if CSV_PROFILER
+    if (bOwnsCsvCapture)
+    {
+        FCsvProfiler::Get()->EndCapture();
+        bOwnsCsvCapture = false;
+    }
+#endif
+
+    const FString BasePath = FPaths::Combine(Settings.OutputDirectory, Settings.Name);
+    WriteFrameCsv(BasePath + TEXT(".csv"));
+    WriteSummaryJson(BasePath + TEXT(".json"));
+}
+
+void UCelestialBenchmarkSubsystem::Finish(bool bSuccess)
+{
+    Phase = EPhase::Finished;
+
+    // Gauntlet and CI read the exit code; the baselines are already on disk
+    UE_LOG(LogCelestialBenchmark, Display, TEXT("Benchmark %s %s"), *Settings.Name, bSuccess ? TEXT("complete") : TEXT("failed"));
+    FPlatformMisc::RequestExitWithStatus(false, bSuccess ? 0 : 1);
+}
+
+int32 UCelestialBenchmarkSubsystem::CountSimulated() const
+{
+    const UWorld* World = GetWorld();
+    switch (Settings.Scenario)
+    {
+    case ECelestialBenchmarkScenario::Orbital:
+        {
+            const UOrbitalSimulationSubsystem* Simulation = World->GetSubsystem<UOrbitalSimulationSubsystem>();
+            return Simulation ? Simulation->GetNumShips() : 0;
+        }
+
+    case ECelestialBenchmarkScenario::Combat:
+        {
+            int32 NumAlive = 0;
+            if (const UCombatRegistrySubsystem* Registry = World->GetSubsystem<UCombatRegistrySubsystem>())
+            {
+                for (const UCombatSystem* Combat : Registry->GetAllCombatants())
+                {
+                    NumAlive += Combat->IsAlive() ? 1 : 0;
+                }
+            }
+            return NumAlive;
+        }
+
+    case ECelestialBenchmarkScenario::CrowdCombat:
+        {
+            const UCombatCrowdSubsystem* Crowd = World->GetSubsystem<UCombatCrowdSubsystem>();
+            return Crowd ? Crowd->GetNumCrowdCombatants() : 0;
+        }
+
+    default:
+        return 0;
+    }
+}
+
+const UNetDriver* UCelestialBenchmarkSubsystem::GetNetDriver() const
+{
+    return GetWorld()->GetNetDriver();
+}
+
+void UCelestialBenchmarkSubsystem::WriteFrameCsv(const FString& Path) const
+{
+    // Allocations, Frees and TrackedMemoryMB are -1 when the build or command line does not provide them
+    FString Content = TEXT("Frame,FrameMs,WorkMs,UsedMemoryMB,Simulated,Allocations,Frees,TrackedMemoryMB\n");
+    for (int32 i = 0; i < Frames.Num(); i++)
+    {
+        const FCelestialBenchmarkFrame& Frame = Frames[i];
+        const double TrackedMemoryMB = Frame.TrackedMemory >= 0 ? Frame.TrackedMemory / (1024.0 * 1024.0) : -1.0;
+        Content += FString::Printf(TEXT("%d,%.3f,%.3f,%.1f,%d,%lld,%lld,%.1f\n"), i, Frame.FrameMs, Frame.WorkMs, Frame.UsedMemory / (1024.0 * 1024.0), Frame.NumSimulated,
+                                   Frame.Allocations, Frame.Frees, TrackedMemoryMB);
+    }
+
+    if (!FFileHelper::SaveStringToFile(Content, *Path))
+    {
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Could not write benchmark frames to %s"), *Path);
+    }
+}
+
+void UCelestialBenchmarkSubsystem::WriteSummaryJson(const FString& Path) const
+{
+    TArray<float> FrameMs;
+    TArray<float> WorkMs;
+    TArray<float> AllocationsPerFrame;
+    TArray<float> FreesPerFrame;
+    FrameMs.Reserve(Frames.Num());
+    WorkMs.Reserve(Frames.Num());
+    AllocationsPerFrame.Reserve(Frames.Num());
+    FreesPerFrame.Reserve(Frames.Num());
+    int64 TotalAllocations = 0;
+    int64 TotalFrees = 0;
+    int64 PeakTrackedMemory = -1;
+    for (const FCelestialBenchmarkFrame& Frame : Frames)
+    {
+        FrameMs.Add(Frame.FrameMs);
+        WorkMs.Add(Frame.WorkMs);
+        AllocationsPerFrame.Add(static_cast<float>(Frame.Allocations));
+        FreesPerFrame.Add(static_cast<float>(Frame.Frees));
+        TotalAllocations += FMath::Max<int64>(Frame.Allocations, 0);
+        TotalFrees += FMath::Max<int64>(Frame.Frees, 0);
+        PeakTrackedMemory = FMath::Max(PeakTrackedMemory, Frame.TrackedMemory);
+    }
+
+    const double Duration = FMath::Max(MeasureEndTime - MeasureStartTime, UE_SMALL_NUMBER);
+
+    TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+    Memory->SetNumberField(TEXT("startBytes"), static_cast<double>(StartUsedMemory));
+    Memory->SetNumberField(TEXT("endBytes"), static_cast<double>(LastUsedMemory));
+    Memory->SetNumberField(TEXT("peakBytes"), static_cast<double>(PeakUsedMemory));
+    Memory->SetNumberField(TEXT("growthBytes"), static_cast<double>(LastUsedMemory) - static_cast<double>(StartUsedMemory));
+
+    // Call counts are absent from builds without engine stats, LLM bytes from runs without -llm
+    TSharedRef<FJsonObject> Allocations = MakeShared<FJsonObject>();
+    Allocations->SetBoolField(TEXT("countsAvailable"), HasAllocationCounts());
+    if (HasAllocationCounts())
+    {
+        Allocations->SetNumberField(TEXT("total"), static_cast<double>(TotalAllocations));
+        Allocations->SetNumberField(TEXT("totalFrees"), static_cast<double>(TotalFrees));
+        Allocations->SetObjectField(TEXT("perFrame"), MakeTimingSummary(MoveTemp(AllocationsPerFrame)));
+        Allocations->SetObjectField(TEXT("freesPerFrame"), MakeTimingSummary(MoveTemp(FreesPerFrame)));
+    }
+    const bool bHasTrackedMemory = Frames.Num() > 0 && Frames[0].TrackedMemory >= 0;
+    Allocations->SetBoolField(TEXT("llmAvailable"), bHasTrackedMemory);
+    if (bHasTrackedMemory)
+    {
+        Allocations->SetNumberField(TEXT("llmStartBytes"), static_cast<double>(Frames[0].TrackedMemory));
+        Allocations->SetNumberField(TEXT("llmEndBytes"), static_cast<double>(Frames.Last().TrackedMemory));
+        Allocations->SetNumberField(TEXT("llmPeakBytes"), static_cast<double>(PeakTrackedMemory));
+    }
+
+    TSharedRef<FJsonObject> Network = MakeShared<FJsonObject>();
+    Network->SetNumberField(TEXT("inBytesPerSecond"), (EndInBytes - StartInBytes) / Duration);
+    Network->SetNumberField(TEXT("outBytesPerSecond"), (EndOutBytes - StartOutBytes) / Duration);
+
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetStringField(TEXT("name"), Settings.Name);
+    Summary->SetStringField(TEXT("scenario"), GetScenarioName(Settings.Scenario));
+    Summary->SetNumberField(TEXT("count"), Settings.Count);
+    Summary->SetNumberField(TEXT("timeAcceleration"), Settings.TimeAcceleration);
+    Summary->SetBoolField(TEXT("burning"), Settings.bBurning);
+    Summary->SetStringField(TEXT("build"), FApp::GetBuildVersion());
+    Summary->SetNumberField(TEXT("frames"), Frames.Num());
+    Summary->SetNumberField(TEXT("durationSeconds"), Duration);
+    Summary->SetNumberField(TEXT("spawned"), NumSpawned);
+    Summary->SetNumberField(TEXT("simulatedAtEnd"), Frames.Num() > 0 ? Frames.Last().NumSimulated : 0);
+    Summary->SetObjectField(TEXT("frameMs"), MakeTimingSummary(MoveTemp(FrameMs)));
+    Summary->SetObjectField(TEXT("workMs"), MakeTimingSummary(MoveTemp(WorkMs)));
+    Summary->SetObjectField(TEXT("memory"), Memory);
+    Summary->SetObjectField(TEXT("allocations"), Allocations);
+    Summary->SetObjectField(TEXT("network"), Network);
+
+    FString Content;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
+    FJsonSerializer::Serialize(Summary, Writer);
+
+    if (!FFileHelper::SaveStringToFile(Content, *Path))
+    {
+        UE_LOG(LogCelestialBenchmark, Error, TEXT("Could not write benchmark summary to %s"), *Path);
+    }
+}
@@ -0,0 +1,146 @@
+// CelestialBenchmarkSubsystem.h
+// Celestial Benchmark Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the headless benchmark scenarios and the frame, memory and bandwidth baselines they record
+// Feature Context: Measures orbital propagation and AI firefights at fixed counts so hot-path regressions show up before deploy
+// Dependencies: Unreal Engine world subsystems, CSV profiler, JSON, OrbitalSimulationSubsystem, CombatCrowdSubsystem, CombatSystem
+// Usage Example: CelestialSyndicateServer Arena -nullrhi -CelestialBenchmark=Orbital -BenchmarkCount=500 -BenchmarkTimeAccel=1000
+// Security: Only created when -CelestialBenchmark is on the command line; never present in normal sessions
+// Performance: Resident memory is sampled every MemorySampleInterval frames; allocator call counts and LLM totals are read every frame
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CelestialBenchmarkSubsystem.generated.h"
+
+// Forward declarations
+class UNetDriver;
+
+enum class ECelestialBenchmarkScenario : uint8
+{
+    None,
+    Orbital,        // ASpacecraft with UOrbitalMechanics: coasting or burning, at any time acceleration
+    Combat,         // N vs N UCombatSystem AI pawns
+    CrowdCombat     // N vs N UCombatCrowdSubsystem entities
+};
+
+// Read once from the command line when the world starts
+struct FCelestialBenchmarkSettings
+{
+    ECelestialBenchmarkScenario Scenario = ECelestialBenchmarkScenario::None;
+
+    // Result file stem; derived from the scenario when not given
+    FString Name;
+
+    // Ships, or combatants per team
+    int32 Count = 100;
+
+    float TimeAcceleration = 1.0f;
+    bool bBurning = false;
+
+    float WarmupSeconds = 5.0f; // s
+    int32 MeasureFrames = 1800;
+
+    // Ship class for Orbital (ASpacecraft when empty); AI pawn class with a UCombatSystem for Combat
+    FString ActorClassPath;
+
+    FString OutputDirectory;
+
+    static FCelestialBenchmarkSettings FromCommandLine(const TCHAR* CommandLine);
+};
+
+struct FCelestialBenchmarkFrame
+{
+    float FrameMs;
+
+    // Frame time without the idle wait of a throttled server
+    float WorkMs;
+
+    // Bytes, from the latest memory sample
+    uint64 UsedMemory;
+
+    // Allocator calls this frame (malloc and realloc, free); -1 in builds without engine stats
+    int64 Allocations;
+    int64 Frees;
+
+    // Bytes tracked by LLM at the end of the frame; -1 unless the process runs with -llm
+    int64 TrackedMemory;
+
+    // Ships or living combatants still simulated
+    int32 NumSimulated;
+};
+
+// Drives one benchmark scenario, writes its baselines and exits the process
+UCLASS()
+class CELESTIALSYNDICATE_API UCelestialBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCelestialBenchmarkSubsystem();
+
+    // USubsystem interface
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    const FCelestialBenchmarkSettings& GetSettings() const { return Settings; }
+
+    // Frames between memory samples
+    int32 MemorySampleInterval;
+
+private:
+    enum class EPhase : uint8
+    {
+        Setup,
+        Warmup,
+        Measure,
+        Finished
+    };
+
+    bool SpawnScenario();
+    bool SpawnShips();
+    bool SpawnCombatants();
+    bool SpawnCrowdCombatants();
+    FTransform GetCombatantTransform(int32 TeamId, int32 Index) const;
+
+    void BeginMeasurement();
+    void RecordFrame();
+    void FinishMeasurement();
+    void Finish(bool bSuccess);
+
+    int32 CountSimulated() const;
+    const UNetDriver* GetNetDriver() const;
+
+    void WriteFrameCsv(const FString& Path) const;
+    void WriteSummaryJson(const FString& Path) const;
+
+    FCelestialBenchmarkSettings Settings;
+    EPhase Phase;
+    double PhaseStartTime;
+
+    TArray<FCelestialBenchmarkFrame> Frames;
+    uint64 LastUsedMemory;
+    uint64 StartUsedMemory;
+    uint64 PeakUsedMemory;
+    int32 NumSpawned;
+
+    // Allocator call totals at the previous frame, for per-frame deltas
+    uint64 LastAllocationCalls;
+    uint64 LastFreeCalls;
+
+    // Real seconds and network byte totals at the start and end of measurement
+    double MeasureStartTime;
+    double MeasureEndTime;
+    uint64 StartInBytes;
+    uint64 StartOutBytes;
+    uint64 EndInBytes;
+    uint64 EndOutBytes;
+
+    // Set when this subsystem started the CSV capture and must end it
+    bool bOwnsCsvCapture;
+};
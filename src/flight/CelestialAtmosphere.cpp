@@ -0,0 +1,72 @@
+// CelestialAtmosphere.cpp
+// Celestial Atmosphere for Celestial Syndicate
+// Quantum Documentation: Implements atmosphere density profiles and their table bake
+// Feature Context: Replaces the Earth-only density function that every ship evaluated each step
+// Dependencies: Unreal Engine data assets
+// Usage Example: UOrbitalGravitySubsystem::SetCelestialBodies calls BakeDensityTable once per body
+// Security: Baking reads only asset properties and produces a new immutable table
+// Performance: The transcendental profile is evaluated CeilingAltitude / SampleSpacing times per bake, then never again
+
+#include "CelestialAtmosphere.h"
+
+UCelestialAtmosphere::UCelestialAtmosphere()
+{
+    // Mars-like defaults
+    SurfaceDensity = 0.020; // kg/m³
+    ScaleHeight = 11100.0; // m
+    CeilingAltitude = 150000.0; // m
+    EntryInterfaceAltitude = 125000.0; // m
+    SampleSpacing = 250.0; // m
+}
+
+double UCelestialAtmosphere::EvaluateDensity(double Altitude) const
+{
+    return SurfaceDensity * FMath::Exp(-FMath::Max(Altitude, 0.0) / ScaleHeight);
+}
+
+FAtmosphereDensityTablePtr UCelestialAtmosphere::BakeDensityTable() const
+{
+    TSharedRef<FAtmosphereDensityTable, ESPMode::ThreadSafe> Table = MakeShared<FAtmosphereDensityTable, ESPMode::ThreadSafe>();
+    Table->SampleSpacing = FMath::Max(SampleSpacing, 1.0);
+    Table->InvSampleSpacing = 1.0 / Table->SampleSpacing;
+    Table->CeilingAltitude = CeilingAltitude;
+    Table->EntryInterfaceAltitude = EntryInterfaceAltitude;
+
+    // One sample past the ceiling so interpolation never reads out of range
+    const int32 NumSamples = FMath::Max(FMath::CeilToInt32(CeilingAltitude * Table->InvSampleSpacing) + 1, 2);
+    Table->Densities.SetNumUninitialized(NumSamples);
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Table->Densities[i] = static_cast<float>(EvaluateDensity(i * Table->SampleSpacing));
+    }
+
+    return Table;
+}
+
+UEarthAtmosphere::UEarthAtmosphere()
+{
+    SurfaceDensity = 1.225; // kg/m³
+    ScaleHeight = 7400.0; // m
+    CeilingAltitude = 140000.0; // m
+    EntryInterfaceAltitude = 100000.0; // m
+}
+
+double UEarthAtmosphere::EvaluateDensity(double Altitude) const
+{
+    if (Altitude < 0.0)
+    {
+        return SurfaceDensity; // Sea level density
+    }
+    else if (Altitude < 11000.0) // Troposphere
+    {
+        return SurfaceDensity * FMath::Pow(1.0 - 0.0065 * Altitude / 288.15, 4.256);
+    }
+    else if (Altitude < 20000.0) // Lower stratosphere
+    {
+        return 0.3639 * FMath::Exp(-(Altitude - 11000.0) / 6341.62);
+    }
+    else
+    {
+        return 0.088 * FMath::Exp(-(Altitude - 20000.0) / ScaleHeight);
+    }
+}
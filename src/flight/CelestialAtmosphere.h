@@ -0,0 +1,94 @@
+// CelestialAtmosphere.h
+// Celestial Atmosphere Header for Celestial Syndicate
+// Quantum Documentation: Describes per-body atmosphere models and the density table they bake into
+// Feature Context: Lets any celestial body carry an atmosphere for drag and entry events, not just Earth
+// Dependencies: Unreal Engine data assets, OrbitalGravitySubsystem
+// Usage Example: Assign an atmosphere asset to FCelestialBody::Atmosphere; the gravity subsystem bakes it on load
+// Security: Baked tables are immutable and shared, so worker threads read them without locking
+// Performance: Drag costs one table lookup per evaluation instead of Pow/Exp per ship per step
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CelestialAtmosphere.generated.h"
+
+// Uniformly sampled density profile, linearly interpolated
+struct CELESTIALSYNDICATE_API FAtmosphereDensityTable
+{
+    TArray<float> Densities;
+    double SampleSpacing;
+    double InvSampleSpacing;
+    double CeilingAltitude;
+    double EntryInterfaceAltitude;
+
+    FAtmosphereDensityTable()
+    {
+        SampleSpacing = 0.0;
+        InvSampleSpacing = 0.0;
+        CeilingAltitude = 0.0;
+        EntryInterfaceAltitude = 0.0;
+    }
+
+    // kg/m³; altitudes below the surface clamp to surface density, above the ceiling return zero
+    double GetDensity(double Altitude) const
+    {
+        if (Altitude >= CeilingAltitude || Densities.Num() == 0)
+        {
+            return 0.0;
+        }
+
+        const double Position = FMath::Max(Altitude, 0.0) * InvSampleSpacing;
+        const int32 Index = FMath::Min(FMath::FloorToInt32(Position), Densities.Num() - 2);
+        const double Alpha = Position - Index;
+        return FMath::Lerp<double>(Densities[Index], Densities[Index + 1], Alpha);
+    }
+};
+
+typedef TSharedPtr<const FAtmosphereDensityTable, ESPMode::ThreadSafe> FAtmosphereDensityTablePtr;
+
+// Base atmosphere: a single exponential layer. Subclass and override EvaluateDensity for other profiles
+UCLASS(BlueprintType, Blueprintable)
+class CELESTIALSYNDICATE_API UCelestialAtmosphere : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UCelestialAtmosphere();
+
+    // Density at zero altitude (kg/m³)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Atmosphere")
+    double SurfaceDensity;
+
+    // e-folding height of the exponential profile (m)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Atmosphere")
+    double ScaleHeight;
+
+    // Altitude above which drag is ignored and coasting ships may go on rails (m)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Atmosphere")
+    double CeilingAltitude;
+
+    // Altitude reported as atmospheric entry (m)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Atmosphere")
+    double EntryInterfaceAltitude;
+
+    // Table resolution (m); the profile is only evaluated when the table is baked
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Atmosphere", meta = (ClampMin = "1"))
+    double SampleSpacing;
+
+    virtual double EvaluateDensity(double Altitude) const;
+
+    FAtmosphereDensityTablePtr BakeDensityTable() const;
+};
+
+// Layered standard atmosphere for Earth
+UCLASS()
+class CELESTIALSYNDICATE_API UEarthAtmosphere : public UCelestialAtmosphere
+{
+    GENERATED_BODY()
+
+public:
+    UEarthAtmosphere();
+
+    virtual double EvaluateDensity(double Altitude) const override;
+};
@@ -0,0 +1,113 @@
+// CelestialEphemeris.cpp
+// Cached Celestial Body Ephemeris for Celestial Syndicate
+// Quantum Documentation: Implements table sampling and Hermite read-back for celestial body states
+// Feature Context: Moving bodies for the patched-conic sphere-of-influence model
+// Dependencies: Unreal Engine core math, KeplerOrbit
+// Usage Example: Built by UOrbitalGravitySubsystem when the body set is assigned
+// Security: Read-only queries, safe from simulation worker threads
+// Performance: Position and velocity samples give a C1 cubic per interval, accurate to centimetres at 512 samples per orbit
+
+#include "CelestialEphemeris.h"
+
+void FCelestialEphemeris::Build(const FKeplerOrbit& InOrbit, int32 InParentIndex, int32 NumSamples)
+{
+    Orbit = InOrbit;
+    ParentIndex = InParentIndex;
+    SamplePositions.Reset();
+    SampleVelocities.Reset();
+    SampleInterval = 0.0;
+    Period = 0.0;
+
+    if (!Orbit.IsElliptic() || NumSamples < 2)
+    {
+        return;
+    }
+
+    Period = 2.0 * PI / Orbit.MeanMotion;
+    SampleInterval = Period / NumSamples;
+    SamplePositions.SetNumUninitialized(NumSamples);
+    SampleVelocities.SetNumUninitialized(NumSamples);
+
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Orbit.GetStateAtTime(Orbit.EpochTime + i * SampleInterval, SamplePositions[i], SampleVelocities[i]);
+    }
+}
+
+void FCelestialEphemeris::BuildFixed(const FVector& Position)
+{
+    // An invalid orbit evaluates to its epoch state
+    Orbit = FKeplerOrbit();
+    Orbit.EpochPosition = Position;
+    ParentIndex = INDEX_NONE;
+    SamplePositions.Reset();
+    SampleVelocities.Reset();
+    SampleInterval = 0.0;
+    Period = 0.0;
+}
+
+void FCelestialEphemeris::GetSystemStateAtTime(const TArray<FCelestialEphemeris>& Ephemerides, int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity)
+{
+    OutPosition = FVector::ZeroVector;
+    OutVelocity = FVector::ZeroVector;
+
+    // Parents always come earlier in the set, so the walk terminates
+    while (Ephemerides.IsValidIndex(BodyIndex))
+    {
+        const FCelestialEphemeris& Ephemeris = Ephemerides[BodyIndex];
+        FVector Position, Velocity;
+        Ephemeris.GetStateAtTime(Time, Position, Velocity);
+        OutPosition += Position;
+        OutVelocity += Velocity;
+        BodyIndex = Ephemeris.ParentIndex;
+    }
+}
+
+void FCelestialEphemeris::GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    if (!IsTabulated())
+    {
+        if (Orbit.bIsValid)
+        {
+            Orbit.GetStateAtTime(Time, OutPosition, OutVelocity);
+        }
+        else
+        {
+            OutPosition = Orbit.EpochPosition;
+            OutVelocity = Orbit.EpochVelocity;
+        }
+        return;
+    }
+
+    // Fold into one period, then locate the bracketing samples
+    double Phase = FMath::Fmod(Time - Orbit.EpochTime, Period);
+    if (Phase < 0.0)
+    {
+        Phase += Period;
+    }
+
+    const int32 NumSamples = SamplePositions.Num();
+    const int32 Index = FMath::Min(FMath::FloorToInt(Phase / SampleInterval), NumSamples - 1);
+    const int32 Next = (Index + 1) % NumSamples;
+    const double S = Phase / SampleInterval - Index;
+    const double H = SampleInterval;
+
+    // Cubic Hermite basis and its derivative
+    const double S2 = S * S;
+    const double S3 = S2 * S;
+    const double H00 = 2.0 * S3 - 3.0 * S2 + 1.0;
+    const double H10 = S3 - 2.0 * S2 + S;
+    const double H01 = -2.0 * S3 + 3.0 * S2;
+    const double H11 = S3 - S2;
+    const double D00 = 6.0 * S2 - 6.0 * S;
+    const double D10 = 3.0 * S2 - 4.0 * S + 1.0;
+    const double D11 = 3.0 * S2 - 2.0 * S;
+
+    const FVector& P0 = SamplePositions[Index];
+    const FVector& P1 = SamplePositions[Next];
+    const FVector& V0 = SampleVelocities[Index];
+    const FVector& V1 = SampleVelocities[Next];
+
+    OutPosition = P0 * H00 + V0 * (H10 * H) + P1 * H01 + V1 * (H11 * H);
+    OutVelocity = (P0 - P1) * (D00 / H) + V0 * D10 + V1 * D11;
+}
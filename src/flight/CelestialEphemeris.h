@@ -0,0 +1,53 @@
+// CelestialEphemeris.h
+// Cached Celestial Body Ephemeris Header for Celestial Syndicate
+// Quantum Documentation: Describes the sampled state table used to place a celestial body at any simulation time
+// Feature Context: Lets every ship query moving bodies without re-solving the body's orbit per query
+// Dependencies: Unreal Engine core math, KeplerOrbit
+// Usage Example: Ephemeris.Build(Orbit, 512); Ephemeris.GetStateAtTime(Time, Position, Velocity);
+// Security: Immutable after Build, so worker threads can query it concurrently
+// Performance: Periodic orbits are sampled once and read back with cubic Hermite interpolation, no Kepler solve per query
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KeplerOrbit.h"
+
+// State table for one body, relative to its parent body
+struct CELESTIALSYNDICATE_API FCelestialEphemeris
+{
+    // Conic the table was sampled from; also the fallback for open orbits
+    FKeplerOrbit Orbit;
+
+    // One period of samples, evenly spaced from the orbit epoch
+    TArray<FVector> SamplePositions;
+    TArray<FVector> SampleVelocities;
+    double SampleInterval;
+    double Period;
+
+    // Body the table is relative to; INDEX_NONE for bodies fixed in the system frame
+    int32 ParentIndex;
+
+    FCelestialEphemeris()
+    {
+        SampleInterval = 0.0;
+        Period = 0.0;
+        ParentIndex = INDEX_NONE;
+    }
+
+    // Elliptic orbits get a table; open or invalid orbits are evaluated analytically
+    void Build(const FKeplerOrbit& InOrbit, int32 InParentIndex, int32 NumSamples);
+
+    // Holds the body at a system-frame position
+    void BuildFixed(const FVector& Position);
+
+    // Position and velocity relative to the parent at an absolute simulation time
+    void GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    bool IsTabulated() const { return SamplePositions.Num() > 0; }
+
+    // System-frame state of a body: its own table plus every ancestor's, up to a fixed body
+    static void GetSystemStateAtTime(const TArray<FCelestialEphemeris>& Ephemerides, int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity);
+};
+
+// Immutable table for a whole body set; background tasks hold a reference while the world may replace it
+typedef TSharedPtr<const TArray<FCelestialEphemeris>, ESPMode::ThreadSafe> FCelestialEphemerisTablePtr;
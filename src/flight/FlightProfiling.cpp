@@ -0,0 +1,14 @@
+// FlightProfiling.cpp
+// Flight Profiling for Celestial Syndicate
+// Quantum Documentation: Defines the flight CSV category and log category
+// Feature Context: Per-stage flight timings and counters for stat commands, Unreal Insights, benchmark captures and -csvprofile
+// Dependencies: Unreal Engine stats, CSV profiler, logging
+// Usage Example: Include FlightProfiling.h and add CELESTIAL_FLIGHT_SCOPE(<Stage>) scopes
+// Security: Timing data and counters only; nothing gameplay-relevant is recorded
+// Performance: Enabled by default; scopes only record while a capture is running
+
+#include "FlightProfiling.h"
+
+CSV_DEFINE_CATEGORY(CelestialFlight, true);
+
+DEFINE_LOG_CATEGORY(LogCelestialFlight);
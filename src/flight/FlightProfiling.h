@@ -0,0 +1,38 @@
+// FlightProfiling.h
+// Flight Profiling Header for Celestial Syndicate
+// Quantum Documentation: Declares the flight stat group, CSV category, Insights counters and log category
+// Feature Context: Per-stage flight timings and counters for stat commands, Unreal Insights, benchmark captures and -csvprofile
+// Dependencies: Unreal Engine stats, CSV profiler, trace counters, logging
+// Usage Example: CELESTIAL_FLIGHT_SCOPE(OrbitalSimulation); UE_LOG(LogCelestialFlight, Verbose, TEXT("..."))
+// Security: Timing data and counters only; nothing gameplay-relevant is recorded
+// Performance: Scopes cost a few branches when no capture is running and compile out with stats, trace and CSV disabled
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("Celestial Flight"), STATGROUP_CelestialFlight, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(CelestialFlight);
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCelestialFlight, Log, All);
+
+// One cycle stat ("stat CelestialFlight"), Insights CPU event and CSV timing, all called Name
+#define CELESTIAL_FLIGHT_SCOPE(Name) \
+    DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_CelestialFlight_##Name, STATGROUP_CelestialFlight); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(Name); \
+    CSV_SCOPED_TIMING_STAT(CelestialFlight, Name)
+
+// Per-frame counter shown in the stat group, in Insights and in CSV captures; declare at file scope, set once a frame
+#define DECLARE_CELESTIAL_FLIGHT_COUNTER(Name) \
+    DECLARE_DWORD_COUNTER_STAT(TEXT(#Name), STAT_CelestialFlight_##Name, STATGROUP_CelestialFlight); \
+    TRACE_DECLARE_INT_COUNTER(CelestialFlight_##Name, TEXT("CelestialFlight/" #Name))
+
+#define SET_CELESTIAL_FLIGHT_COUNTER(Name, Value) \
+    SET_DWORD_STAT(STAT_CelestialFlight_##Name, Value); \
+    TRACE_COUNTER_SET(CelestialFlight_##Name, Value); \
+    CSV_CUSTOM_STAT(CelestialFlight, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set)
@@ -0,0 +1,403 @@
+// KeplerOrbit.cpp
+// Analytic Two-Body Orbit for Celestial Syndicate
+// Quantum Documentation: Implements state-vector capture and closed-form propagation of elliptic, parabolic and hyperbolic orbits
+// Feature Context: Used by UOrbitalMechanics while a ship coasts on rails and by prediction code
+// Dependencies: Unreal Engine core math, VectorRegister SIMD intrinsics
+// Usage Example: Captured once when a ship stops thrusting, queried every frame or by prediction code
+// Security: Rejects radial and degenerate trajectories so callers fall back to numeric integration
+// Performance: Danby's starting guess with Halley steps converges in two or three iterations at any eccentricity
+
+#include "KeplerOrbit.h"
+#include "FlightProfiling.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    // Iteration limits for the solvers; both Kepler solvers share one tolerance so the SIMD path matches the scalar one
+    constexpr int32 MaxScalarIterations = 8;
+    constexpr int32 MaxUniversalIterations = 20;
+    constexpr double KeplerTolerance = 1e-6; // rad
+
+    // Added to once per solve, never per iteration
+    thread_local uint32 ThreadIterationCount = 0;
+
+    // Danby's starting guess for Kepler's equation, E0 = M + 0.85·e·sign(sin M)
+    constexpr double DanbyFactor = 0.85;
+}
+
+FKeplerOrbit FKeplerOrbit::FromStateVectors(const FVector& Position, const FVector& Velocity, double Mu, double Time)
+{
+    FKeplerOrbit Orbit;
+    Orbit.Mu = Mu;
+    Orbit.EpochTime = Time;
+    Orbit.EpochPosition = Position;
+    Orbit.EpochVelocity = Velocity;
+
+    const double Radius = Position.Size();
+    if (Radius <= 0.0 || Mu <= 0.0)
+    {
+        return Orbit;
+    }
+
+    // Angular momentum, eccentricity vector and reciprocal semi-major axis
+    const FVector H = FVector::CrossProduct(Position, Velocity);
+    if (H.IsNearlyZero())
+    {
+        return Orbit; // Radial trajectory
+    }
+
+    const FVector E = FVector::CrossProduct(Velocity, H) / Mu - Position / Radius;
+    Orbit.Eccentricity = E.Size();
+    Orbit.Alpha = 2.0 / Radius - Velocity.SizeSquared() / Mu;
+    Orbit.SemiMajorAxis = FMath::Abs(Orbit.Alpha) > SMALL_NUMBER ? 1.0 / Orbit.Alpha : BIG_NUMBER;
+    Orbit.PeriapsisRadius = H.SizeSquared() / (Mu * (1.0 + Orbit.Eccentricity));
+
+    if (Orbit.Eccentricity > KINDA_SMALL_NUMBER)
+    {
+        Orbit.PeriapsisAxis = E / Orbit.Eccentricity;
+    }
+    else
+    {
+        // Near-circular orbits have no usable periapsis: measure from the ascending node (the x-axis when equatorial)
+        // and make the orbit circular through the epoch position, so going on rails does not move the ship
+        const FVector HAxis = H.GetUnsafeNormal();
+        const FVector Node = FVector::CrossProduct(FVector::UpVector, HAxis);
+        Orbit.PeriapsisAxis = Node.SizeSquared() > KINDA_SMALL_NUMBER
+            ? Node.GetUnsafeNormal()
+            : (FVector::ForwardVector - HAxis * FVector::DotProduct(FVector::ForwardVector, HAxis)).GetSafeNormal();
+
+        Orbit.Eccentricity = 0.0;
+        Orbit.Alpha = 1.0 / Radius;
+        Orbit.SemiMajorAxis = Radius;
+        Orbit.PeriapsisRadius = Radius;
+    }
+    Orbit.NormalAxis = FVector::CrossProduct(H, Orbit.PeriapsisAxis).GetSafeNormal();
+    Orbit.bIsValid = true;
+
+    if (!Orbit.IsElliptic())
+    {
+        return Orbit; // Open conics propagate through universal variables only
+    }
+
+    // True, eccentric and mean anomaly at the epoch
+    const double Eccentricity = Orbit.Eccentricity;
+    Orbit.MeanMotion = FMath::Sqrt(Mu * Orbit.Alpha * Orbit.Alpha * Orbit.Alpha);
+
+    const double TrueAnomaly = FMath::Atan2(FVector::DotProduct(Position, Orbit.NormalAxis), FVector::DotProduct(Position, Orbit.PeriapsisAxis));
+    const double EccentricAnomaly = FMath::Atan2(
+        FMath::Sqrt(1.0 - Eccentricity * Eccentricity) * FMath::Sin(TrueAnomaly),
+        Eccentricity + FMath::Cos(TrueAnomaly)
+    );
+    Orbit.MeanAnomalyAtEpoch = EccentricAnomaly - Eccentricity * FMath::Sin(EccentricAnomaly);
+
+    return Orbit;
+}
+
+void FKeplerOrbit::GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    if (IsElliptic())
+    {
+        const double EccentricAnomaly = SolveEccentricAnomaly(GetMeanAnomalyAtTime(Time), Eccentricity);
+        GetStateFromEccentricAnomaly(EccentricAnomaly, OutPosition, OutVelocity);
+    }
+    else
+    {
+        GetStateUniversal(Time, OutPosition, OutVelocity);
+    }
+}
+
+TOptional<double> FKeplerOrbit::GetNextPeriapsisTime(double Time) const
+{
+    if (!bIsValid)
+    {
+        return TOptional<double>();
+    }
+
+    if (IsElliptic())
+    {
+        // Mean anomaly is unwound to [-π, π], so periapsis is either just ahead or one lap away
+        const double MeanAnomaly = GetMeanAnomalyAtTime(Time);
+        const double Remaining = MeanAnomaly <= 0.0 ? -MeanAnomaly : 2.0 * PI - MeanAnomaly;
+        return Time + Remaining / MeanMotion;
+    }
+
+    // Open conics pass periapsis once; find that time from the epoch true anomaly
+    const double EpochTrueAnomaly = FMath::Atan2(FVector::DotProduct(EpochPosition, NormalAxis), FVector::DotProduct(EpochPosition, PeriapsisAxis));
+    const double PeriapsisTime = EpochTime - GetOpenTimeSincePeriapsis(EpochTrueAnomaly);
+    return PeriapsisTime >= Time ? TOptional<double>(PeriapsisTime) : TOptional<double>();
+}
+
+TOptional<double> FKeplerOrbit::GetNextApoapsisTime(double Time) const
+{
+    if (!IsElliptic())
+    {
+        return TOptional<double>();
+    }
+
+    return Time + (PI - GetMeanAnomalyAtTime(Time)) / MeanMotion;
+}
+
+TOptional<double> FKeplerOrbit::GetNextTrueAnomalyTime(double TrueAnomaly, double Time) const
+{
+    if (!bIsValid)
+    {
+        return TOptional<double>();
+    }
+
+    if (IsElliptic())
+    {
+        const double EccentricAnomaly = 2.0 * FMath::Atan(FMath::Sqrt((1.0 - Eccentricity) / (1.0 + Eccentricity)) * FMath::Tan(0.5 * TrueAnomaly));
+        const double TargetMeanAnomaly = EccentricAnomaly - Eccentricity * FMath::Sin(EccentricAnomaly);
+        double Remaining = FMath::Fmod(TargetMeanAnomaly - GetMeanAnomalyAtTime(Time), 2.0 * PI);
+        if (Remaining < 0.0)
+        {
+            Remaining += 2.0 * PI;
+        }
+        return Time + Remaining / MeanMotion;
+    }
+
+    // Each anomaly inside the asymptotes is reached exactly once
+    const double EpochTrueAnomaly = FMath::Atan2(FVector::DotProduct(EpochPosition, NormalAxis), FVector::DotProduct(EpochPosition, PeriapsisAxis));
+    const double TargetTime = EpochTime - GetOpenTimeSincePeriapsis(EpochTrueAnomaly) + GetOpenTimeSincePeriapsis(TrueAnomaly);
+    return TargetTime >= Time ? TOptional<double>(TargetTime) : TOptional<double>();
+}
+
+TOptional<double> FKeplerOrbit::GetNextRadiusCrossingTime(double Radius, bool bInbound, double Time) const
+{
+    if (!bIsValid || Eccentricity <= KINDA_SMALL_NUMBER || Radius <= PeriapsisRadius || Radius >= GetApoapsisRadius())
+    {
+        return TOptional<double>();
+    }
+
+    // r = p / (1 + e·cos ν); inbound crossings sit on the approach to periapsis
+    const double SemiLatusRectum = PeriapsisRadius * (1.0 + Eccentricity);
+    const double TrueAnomaly = FMath::Acos(FMath::Clamp((SemiLatusRectum / Radius - 1.0) / Eccentricity, -1.0, 1.0));
+    return GetNextTrueAnomalyTime(bInbound ? -TrueAnomaly : TrueAnomaly, Time);
+}
+
+double FKeplerOrbit::GetOpenTimeSincePeriapsis(double TrueAnomaly) const
+{
+    if (FMath::Abs(Alpha) > SMALL_NUMBER)
+    {
+        // F = 2·atanh(sqrt((e - 1) / (e + 1))·tan(ν / 2))
+        const double X = FMath::Sqrt((Eccentricity - 1.0) / (Eccentricity + 1.0)) * FMath::Tan(0.5 * TrueAnomaly);
+        const double HyperbolicAnomaly = FMath::Loge((1.0 + X) / (1.0 - X));
+        const double HyperbolicMeanMotion = FMath::Sqrt(Mu * -Alpha * -Alpha * -Alpha);
+        return (Eccentricity * FMath::Sinh(HyperbolicAnomaly) - HyperbolicAnomaly) / HyperbolicMeanMotion;
+    }
+
+    // Barker's equation
+    const double SemiLatusRectum = 2.0 * PeriapsisRadius;
+    const double D = FMath::Tan(0.5 * TrueAnomaly);
+    return 0.5 * FMath::Sqrt(SemiLatusRectum * SemiLatusRectum * SemiLatusRectum / Mu) * (D + D * D * D / 3.0);
+}
+
+double FKeplerOrbit::GetMeanAnomalyAtTime(double Time) const
+{
+    return FMath::UnwindRadians(MeanAnomalyAtEpoch + MeanMotion * (Time - EpochTime));
+}
+
+void FKeplerOrbit::GetStateFromEccentricAnomaly(double EccentricAnomaly, FVector& OutPosition, FVector& OutVelocity) const
+{
+    double SinE, CosE;
+    FMath::SinCos(&SinE, &CosE, EccentricAnomaly);
+    const double RootOneMinusESq = FMath::Sqrt(1.0 - Eccentricity * Eccentricity);
+
+    // Position in the perifocal frame
+    OutPosition = PeriapsisAxis * (SemiMajorAxis * (CosE - Eccentricity))
+                + NormalAxis * (SemiMajorAxis * RootOneMinusESq * SinE);
+
+    // Velocity from differentiating the perifocal position with respect to time
+    const double Radius = SemiMajorAxis * (1.0 - Eccentricity * CosE);
+    const double VelocityScale = FMath::Sqrt(Mu * SemiMajorAxis) / Radius;
+    OutVelocity = PeriapsisAxis * (-VelocityScale * SinE)
+                + NormalAxis * (VelocityScale * RootOneMinusESq * CosE);
+}
+
+void FKeplerOrbit::GetStateUniversal(double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    // Solved in double: the universal anomaly spans many orders of magnitude on escape trajectories
+    const FVector3d R0(EpochPosition);
+    const FVector3d V0(EpochVelocity);
+    const double MuD = Mu;
+    const double SqrtMu = FMath::Sqrt(MuD);
+    const double AlphaD = Alpha;
+    const double R0Mag = R0.Size();
+    const double RDotV = FVector3d::DotProduct(R0, V0);
+    double DeltaTime = Time - EpochTime;
+
+    // Starting guess per conic type
+    double Chi;
+    if (AlphaD * R0Mag > 1e-6)
+    {
+        // Ellipse: fold the interval into one period so the anomaly stays bounded
+        const double Period = 2.0 * PI / FMath::Sqrt(MuD * AlphaD * AlphaD * AlphaD);
+        DeltaTime = FMath::Fmod(DeltaTime, Period);
+        Chi = SqrtMu * AlphaD * DeltaTime;
+    }
+    else if (AlphaD * R0Mag < -1e-6)
+    {
+        // Hyperbola: logarithmic guess from the asymptotic solution
+        const double A = 1.0 / AlphaD;
+        const double Sign = DeltaTime >= 0.0 ? 1.0 : -1.0;
+        const double Denominator = RDotV + Sign * FMath::Sqrt(-MuD * A) * (1.0 - R0Mag * AlphaD);
+        const double Argument = Denominator != 0.0 ? (-2.0 * MuD * AlphaD * DeltaTime) / Denominator : 0.0;
+        Chi = Argument > 0.0 ? Sign * FMath::Sqrt(-A) * FMath::Loge(Argument) : SqrtMu * DeltaTime / R0Mag;
+    }
+    else
+    {
+        // Parabola: Barker's equation gives the anomaly in closed form
+        const double Sign = DeltaTime >= 0.0 ? 1.0 : -1.0;
+        const double SemiLatusRectum = FVector3d::CrossProduct(R0, V0).SizeSquared() / MuD;
+        const double S = 0.5 * FMath::Atan2(1.0, 3.0 * FMath::Sqrt(MuD / (SemiLatusRectum * SemiLatusRectum * SemiLatusRectum)) * FMath::Abs(DeltaTime));
+        const double W = FMath::Atan(FMath::Pow(FMath::Tan(S), 1.0 / 3.0));
+        Chi = Sign * FMath::Sqrt(SemiLatusRectum) * 2.0 / FMath::Tan(2.0 * W);
+    }
+
+    // Newton iteration on the universal Kepler equation; its derivative is the radius at Chi
+    double C = 0.5;
+    double S = 1.0 / 6.0;
+    int32 Iteration = 0;
+    for (; Iteration < MaxUniversalIterations; Iteration++)
+    {
+        const double ChiSq = Chi * Chi;
+        Stumpff(AlphaD * ChiSq, C, S);
+
+        const double F = RDotV / SqrtMu * ChiSq * C + (1.0 - AlphaD * R0Mag) * ChiSq * Chi * S + R0Mag * Chi - SqrtMu * DeltaTime;
+        const double FPrime = RDotV / SqrtMu * Chi * (1.0 - AlphaD * ChiSq * S) + (1.0 - AlphaD * R0Mag) * ChiSq * C + R0Mag;
+
+        const double Correction = F / FPrime;
+        Chi -= Correction;
+        if (FMath::Abs(Correction) < 1e-9 * FMath::Max(1.0, FMath::Abs(Chi)))
+        {
+            break;
+        }
+    }
+    ThreadIterationCount += FMath::Min(Iteration + 1, MaxUniversalIterations);
+
+    // Lagrange coefficients
+    const double ChiSq = Chi * Chi;
+    Stumpff(AlphaD * ChiSq, C, S);
+
+    const double LagrangeF = 1.0 - ChiSq / R0Mag * C;
+    const double LagrangeG = DeltaTime - ChiSq * Chi / SqrtMu * S;
+    const FVector3d R = R0 * LagrangeF + V0 * LagrangeG;
+    const double RMag = R.Size();
+
+    const double LagrangeFDot = SqrtMu / (RMag * R0Mag) * (AlphaD * ChiSq * Chi * S - Chi);
+    const double LagrangeGDot = 1.0 - ChiSq / RMag * C;
+    const FVector3d V = R0 * LagrangeFDot + V0 * LagrangeGDot;
+
+    OutPosition = FVector(R);
+    OutVelocity = FVector(V);
+}
+
+void FKeplerOrbit::Stumpff(double Z, double& OutC, double& OutS)
+{
+    if (Z > 1e-4)
+    {
+        const double SqrtZ = FMath::Sqrt(Z);
+        OutC = (1.0 - FMath::Cos(SqrtZ)) / Z;
+        OutS = (SqrtZ - FMath::Sin(SqrtZ)) / (Z * SqrtZ);
+    }
+    else if (Z < -1e-4)
+    {
+        const double SqrtNegZ = FMath::Sqrt(-Z);
+        OutC = (FMath::Cosh(SqrtNegZ) - 1.0) / -Z;
+        OutS = (FMath::Sinh(SqrtNegZ) - SqrtNegZ) / (-Z * SqrtNegZ);
+    }
+    else
+    {
+        // Series expansion avoids cancellation near the parabolic case
+        OutC = 1.0 / 2.0 - Z / 24.0 + Z * Z / 720.0;
+        OutS = 1.0 / 6.0 - Z / 120.0 + Z * Z / 5040.0;
+    }
+}
+
+double FKeplerOrbit::SolveEccentricAnomaly(double MeanAnomaly, double Eccentricity)
+{
+    double E = MeanAnomaly + DanbyFactor * Eccentricity * FMath::Sign(FMath::Sin(MeanAnomaly));
+
+    int32 Iteration = 0;
+    for (; Iteration < MaxScalarIterations; Iteration++)
+    {
+        double SinE, CosE;
+        FMath::SinCos(&SinE, &CosE, E);
+
+        const double F = E - Eccentricity * SinE - MeanAnomaly;
+        if (FMath::Abs(F) < KeplerTolerance)
+        {
+            break;
+        }
+
+        // Halley step: cubic convergence using the second derivative e·sin(E)
+        const double FPrime = 1.0 - Eccentricity * CosE;
+        const double FDoublePrime = Eccentricity * SinE;
+        E -= F / (FPrime - 0.5 * F * FDoublePrime / FPrime);
+    }
+    ThreadIterationCount += FMath::Min(Iteration + 1, MaxScalarIterations);
+
+    return E;
+}
+
+void FKeplerOrbit::SolveEccentricAnomalyBatch(const double* MeanAnomaly, const double* Eccentricity, double* OutEccentricAnomaly, int32 Num)
+{
+    CELESTIAL_FLIGHT_SCOPE(KeplerBatchSolve);
+
+    const VectorRegister4Double One = VectorOneDouble();
+    const VectorRegister4Double Half = VectorSetFloat1(0.5);
+    const VectorRegister4Double Danby = VectorSetFloat1(DanbyFactor);
+    const VectorRegister4Double Tolerance = VectorSetFloat1(KeplerTolerance);
+
+    for (int32 Base = 0; Base < Num; Base += 4)
+    {
+        // Tail lanes are padded with circular orbits, which converge immediately
+        alignas(32) double MLanes[4] = {};
+        alignas(32) double ELanes[4] = {};
+        alignas(32) double Result[4];
+        const int32 Count = FMath::Min(4, Num - Base);
+        for (int32 Lane = 0; Lane < Count; Lane++)
+        {
+            MLanes[Lane] = MeanAnomaly[Base + Lane];
+            ELanes[Lane] = Eccentricity[Base + Lane];
+        }
+
+        const VectorRegister4Double M = VectorLoadAligned(MLanes);
+        const VectorRegister4Double Ecc = VectorLoadAligned(ELanes);
+
+        VectorRegister4Double SinE, CosE;
+        VectorSinCos(&SinE, &CosE, &M);
+        VectorRegister4Double E = VectorMultiplyAdd(VectorMultiply(Danby, Ecc), VectorSign(SinE), M);
+
+        // Lanes step in lockstep until the slowest meets the scalar tolerance; converged lanes take harmless extra Halley steps
+        int32 Iteration = 0;
+        for (; Iteration < MaxScalarIterations; Iteration++)
+        {
+            VectorSinCos(&SinE, &CosE, &E);
+            const VectorRegister4Double F = VectorSubtract(VectorNegateMultiplyAdd(Ecc, SinE, E), M);
+            if (!VectorAnyGreaterThan(VectorAbs(F), Tolerance))
+            {
+                break;
+            }
+
+            const VectorRegister4Double FPrime = VectorNegateMultiplyAdd(Ecc, CosE, One);
+            const VectorRegister4Double FDoublePrime = VectorMultiply(Ecc, SinE);
+            const VectorRegister4Double Denominator = VectorSubtract(FPrime, VectorDivide(VectorMultiply(Half, VectorMultiply(F, FDoublePrime)), FPrime));
+            E = VectorSubtract(E, VectorDivide(F, Denominator));
+        }
+        ThreadIterationCount += Count * FMath::Min(Iteration + 1, MaxScalarIterations);
+
+        VectorStoreAligned(E, Result);
+        for (int32 Lane = 0; Lane < Count; Lane++)
+        {
+            OutEccentricAnomaly[Base + Lane] = Result[Lane];
+        }
+    }
+}
+
+uint32 FKeplerOrbit::ConsumeIterationCount()
+{
+    const uint32 Count = ThreadIterationCount;
+    ThreadIterationCount = 0;
+    return Count;
+}
@@ -0,0 +1,99 @@
+// KeplerOrbit.h
+// Analytic Two-Body Orbit Header for Celestial Syndicate
+// Quantum Documentation: Describes the closed-form conic used to propagate coasting spacecraft
+// Feature Context: Backs the on-rails propagation mode of UOrbitalMechanics for every conic type
+// Dependencies: Unreal Engine core math, VectorRegister SIMD intrinsics
+// Usage Example: FKeplerOrbit::FromStateVectors(R, V, Mu, Time).GetStateAtTime(Time + Dt, R, V)
+// Security: Degenerate (radial) input produces an invalid orbit that callers must not put on rails
+// Performance: Any query time costs one Kepler solve, independent of time acceleration; elliptic solves batch in SIMD lanes
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Closed-form two-body orbit captured at an epoch
+struct CELESTIALSYNDICATE_API FKeplerOrbit
+{
+    // Gravitational parameter of the central body (m³/s²)
+    double Mu;
+
+    // Simulation time the orbit was captured at
+    double EpochTime;
+
+    // State at the epoch, used by the universal-variable propagator
+    FVector EpochPosition;
+    FVector EpochVelocity;
+
+    // Reciprocal semi-major axis: positive for ellipses, zero for parabolas, negative for hyperbolas
+    double Alpha;
+
+    double SemiMajorAxis;
+    double Eccentricity;
+    double PeriapsisRadius;
+    double MeanMotion;
+    double MeanAnomalyAtEpoch;
+
+    // Perifocal frame: towards periapsis, and 90° ahead of it in the direction of motion
+    FVector PeriapsisAxis;
+    FVector NormalAxis;
+
+    bool bIsValid;
+
+    FKeplerOrbit()
+    {
+        Mu = 0.0;
+        EpochTime = 0.0;
+        EpochPosition = FVector::ZeroVector;
+        EpochVelocity = FVector::ZeroVector;
+        Alpha = 0.0;
+        SemiMajorAxis = 0.0;
+        Eccentricity = 0.0;
+        PeriapsisRadius = 0.0;
+        MeanMotion = 0.0;
+        MeanAnomalyAtEpoch = 0.0;
+        PeriapsisAxis = FVector::ForwardVector;
+        NormalAxis = FVector::RightVector;
+        bIsValid = false;
+    }
+
+    // Captures the osculating conic of a state relative to the central body
+    static FKeplerOrbit FromStateVectors(const FVector& Position, const FVector& Velocity, double Mu, double Time);
+
+    // Position and velocity relative to the central body at an arbitrary simulation time
+    void GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    bool IsElliptic() const { return bIsValid && Eccentricity < 1.0 && SemiMajorAxis > 0.0; }
+    double GetPeriapsisRadius() const { return PeriapsisRadius; }
+    double GetApoapsisRadius() const { return IsElliptic() ? SemiMajorAxis * (1.0 + Eccentricity) : BIG_NUMBER; }
+    double GetPeriod() const { return IsElliptic() ? 2.0 * PI / MeanMotion : 0.0; }
+
+    // Next apsis passage at or after Time; unset when the conic never reaches it again
+    TOptional<double> GetNextPeriapsisTime(double Time) const;
+    TOptional<double> GetNextApoapsisTime(double Time) const;
+
+    // Next time the orbit reaches a true anomaly, or crosses a radius inbound/outbound
+    TOptional<double> GetNextTrueAnomalyTime(double TrueAnomaly, double Time) const;
+    TOptional<double> GetNextRadiusCrossingTime(double Radius, bool bInbound, double Time) const;
+
+    // Elliptic fast path, split so callers can batch the Kepler solve between the two halves
+    double GetMeanAnomalyAtTime(double Time) const;
+    void GetStateFromEccentricAnomaly(double EccentricAnomaly, FVector& OutPosition, FVector& OutVelocity) const;
+
+    // Universal-variable propagation, valid for every conic
+    void GetStateUniversal(double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    // Halley solution of M = E - e·sin(E) from Danby's starting guess
+    static double SolveEccentricAnomaly(double MeanAnomaly, double Eccentricity);
+
+    // Same solve for Num ships at once, four lanes per SIMD register
+    static void SolveEccentricAnomalyBatch(const double* MeanAnomaly, const double* Eccentricity, double* OutEccentricAnomaly, int32 Num);
+
+    // Solver iterations run on the calling thread since its last call; feeds the KeplerIterations counter
+    static uint32 ConsumeIterationCount();
+
+    // Stumpff functions C(z) and S(z) of the universal-variable formulation
+    static void Stumpff(double Z, double& OutC, double& OutS);
+
+    // Time from periapsis to a true anomaly on a hyperbola or parabola
+    double GetOpenTimeSincePeriapsis(double TrueAnomaly) const;
+};
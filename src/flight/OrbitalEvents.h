@@ -0,0 +1,27 @@
+// OrbitalEvents.h
+// Orbital Event Prediction Types for Celestial Syndicate
+// Quantum Documentation: Describes the analytic orbital events exchanged between ships and the world event queue
+// Feature Context: Lets orbital events be predicted once from the elements instead of polled every tick
+// Dependencies: Unreal Engine core types
+// Usage Example: UOrbitalMechanics::PredictOrbitalEvents fills FOrbitalEventPrediction entries for the scheduler
+// Security: Plain data, copied between game-thread owners only
+// Performance: A handful of predictions per conic change, nothing per frame
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Events a ship can reach along its conic
+enum class EOrbitalEventType : uint8
+{
+    Periapsis,
+    Apoapsis,
+    AtmosphericEntry
+};
+
+// A predicted event in the ship's own simulation time
+struct FOrbitalEventPrediction
+{
+    EOrbitalEventType Type;
+    double SimulationTime;
+};
@@ -0,0 +1,133 @@
+// OrbitalGravitySubsystem.cpp
+// Patched-Conic Gravity Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements body ephemerides and sphere-of-influence lookup for orbital components
+// Feature Context: Propagates the celestial body set and assigns ships to the body that dominates their motion
+// Dependencies: Unreal Engine world subsystems, CelestialEphemeris, KeplerOrbit, OrbitalMechanics
+// Usage Example: Seeded by the first UOrbitalMechanics to begin play, queried by every ship afterwards
+// Security: Read-only during evaluation, so concurrent chunks never contend
+// Performance: Tables are built once per body set; each query is a single Hermite evaluation
+
+#include "OrbitalGravitySubsystem.h"
+#include "OrbitalMechanics.h"
+#include "FlightProfiling.h"
+
+UOrbitalGravitySubsystem::UOrbitalGravitySubsystem()
+{
+}
+
+void UOrbitalGravitySubsystem::SetCelestialBodies(const TArray<FCelestialBody>& Bodies, double GravitationalConstant)
+{
+    const int32 NumBodies = Bodies.Num();
+    TSharedRef<TArray<FCelestialEphemeris>, ESPMode::ThreadSafe> NewEphemerides = MakeShared<TArray<FCelestialEphemeris>, ESPMode::ThreadSafe>();
+    NewEphemerides->SetNum(NumBodies);
+    BodyMu.SetNumUninitialized(NumBodies);
+    BodyRadius.SetNumUninitialized(NumBodies);
+    SphereOfInfluenceRadius.SetNumUninitialized(NumBodies);
+    BodyPrimaryIndex.Init(INDEX_NONE, NumBodies);
+    BodyAtmosphere.Reset(NumBodies);
+
+    for (int32 i = 0; i < NumBodies; i++)
+    {
+        BodyMu[i] = GravitationalConstant * Bodies[i].Mass;
+        BodyRadius[i] = Bodies[i].Radius;
+        BodyAtmosphere.Add(Bodies[i].Atmosphere ? Bodies[i].Atmosphere->BakeDensityTable() : FAtmosphereDensityTablePtr());
+    }
+
+    if (NumBodies == 0)
+    {
+        Ephemerides = NewEphemerides;
+        return;
+    }
+
+    // The primary dominates everywhere outside the other bodies' spheres unless a heavier body orbits it
+    SphereOfInfluenceRadius[0] = BIG_NUMBER;
+    (*NewEphemerides)[0].BuildFixed(Bodies[0].Position);
+
+    for (int32 i = 1; i < NumBodies; i++)
+    {
+        const int32 Parent = Bodies[i].ParentIndex;
+        if (Parent < 0 || Parent >= i)
+        {
+            UE_LOG(LogCelestialFlight, Warning, TEXT("Celestial body %s needs a parent earlier in the set; holding it fixed"), *Bodies[i].Name);
+            (*NewEphemerides)[i].BuildFixed(Bodies[i].Position);
+            SphereOfInfluenceRadius[i] = 0.0;
+            continue;
+        }
+
+        const FVector RelativePosition = Bodies[i].Position - Bodies[Parent].Position;
+        const FKeplerOrbit Orbit = FKeplerOrbit::FromStateVectors(
+            RelativePosition, Bodies[i].Velocity - Bodies[Parent].Velocity, BodyMu[Parent] + BodyMu[i], 0.0);
+        (*NewEphemerides)[i].Build(Orbit, Parent, EphemerisSamples);
+        if (!Orbit.IsElliptic())
+        {
+            UE_LOG(LogCelestialFlight, Warning, TEXT("Celestial body %s is not bound to %s"), *Bodies[i].Name, *Bodies[Parent].Name);
+        }
+
+        // Laplace sphere of influence, r = a (m / M)^(2/5), which only holds for the lighter body; open orbits use the seed distance
+        const double Distance = Orbit.IsElliptic() ? Orbit.SemiMajorAxis : RelativePosition.Size();
+        if (Bodies[i].Mass < Bodies[Parent].Mass)
+        {
+            SphereOfInfluenceRadius[i] = Distance * FMath::Pow(Bodies[i].Mass / Bodies[Parent].Mass, 0.4);
+            BodyPrimaryIndex[i] = Parent;
+        }
+        else if (Parent == 0 && SphereOfInfluenceRadius[0] == BIG_NUMBER)
+        {
+            // A heavier body about the fixed primary (the Sun seen from Earth) owns everything outside the primary's own sphere
+            SphereOfInfluenceRadius[0] = Distance * FMath::Pow(Bodies[0].Mass / Bodies[i].Mass, 0.4);
+            SphereOfInfluenceRadius[i] = BIG_NUMBER;
+            BodyPrimaryIndex[0] = i;
+        }
+        else
+        {
+            UE_LOG(LogCelestialFlight, Warning, TEXT("Celestial body %s is not lighter than %s; it will never be a ship's parent"), *Bodies[i].Name, *Bodies[Parent].Name);
+            SphereOfInfluenceRadius[i] = 0.0;
+            BodyPrimaryIndex[i] = Parent;
+        }
+    }
+
+    // Publish only once fully built; tasks holding the previous table keep it alive
+    Ephemerides = NewEphemerides;
+}
+
+void UOrbitalGravitySubsystem::GetBodyStateAtTime(int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    if (BodyIndex < 0 || BodyIndex >= GetNumBodies())
+    {
+        OutPosition = FVector::ZeroVector;
+        OutVelocity = FVector::ZeroVector;
+        return;
+    }
+
+    FCelestialEphemeris::GetSystemStateAtTime(*Ephemerides, BodyIndex, Time, OutPosition, OutVelocity);
+}
+
+int32 UOrbitalGravitySubsystem::FindDominantBody(const FVector& SystemPosition, double Time) const
+{
+    // A moon's sphere sits inside its planet's, so the smallest containing sphere is the innermost
+    int32 DominantBody = 0;
+    double DominantRadius = TNumericLimits<double>::Max();
+    for (int32 i = 0; i < GetNumBodies(); i++)
+    {
+        const double Radius = SphereOfInfluenceRadius[i];
+        if (Radius <= 0.0 || Radius >= DominantRadius)
+        {
+            continue;
+        }
+
+        // Unbounded spheres contain everything
+        if (Radius < BIG_NUMBER)
+        {
+            FVector BodyPosition, BodyVelocity;
+            GetBodyStateAtTime(i, Time, BodyPosition, BodyVelocity);
+            if (FVector::DistSquared(SystemPosition, BodyPosition) >= FMath::Square(Radius))
+            {
+                continue;
+            }
+        }
+
+        DominantBody = i;
+        DominantRadius = Radius;
+    }
+
+    return DominantBody;
+}
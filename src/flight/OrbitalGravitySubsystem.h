@@ -0,0 +1,65 @@
+// OrbitalGravitySubsystem.h
+// Patched-Conic Gravity Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the shared celestial body set, its ephemerides and spheres of influence
+// Feature Context: Gives each ship a single parent body so orbital math runs two-body against a moving primary
+// Dependencies: Unreal Engine world subsystems, CelestialEphemeris, KeplerOrbit, OrbitalMechanics
+// Usage Example: Ships call FindDominantBody and GetBodyStateAtTime after each simulation step
+// Security: The body set is immutable while a simulation pass is running
+// Performance: Gravity is one body per ship; body states come from cached tables instead of an N-body sum
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CelestialEphemeris.h"
+#include "CelestialAtmosphere.h"
+#include "OrbitalGravitySubsystem.generated.h"
+
+// Forward declarations
+struct FCelestialBody;
+
+// World-level celestial body set shared by all spacecraft
+UCLASS()
+class CELESTIALSYNDICATE_API UOrbitalGravitySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UOrbitalGravitySubsystem();
+
+    // Body management; the first body is the fixed system primary and every other body orbits its ParentIndex
+    void SetCelestialBodies(const TArray<FCelestialBody>& Bodies, double GravitationalConstant);
+    int32 GetNumBodies() const { return BodyMu.Num(); }
+
+    double GetBodyMu(int32 BodyIndex) const { return BodyMu[BodyIndex]; }
+    double GetBodyRadius(int32 BodyIndex) const { return BodyRadius[BodyIndex]; }
+    double GetSphereOfInfluenceRadius(int32 BodyIndex) const { return SphereOfInfluenceRadius[BodyIndex]; }
+
+    // Body whose sphere of influence this body moves in; INDEX_NONE for the dominant body and fixed bodies.
+    // Unlike the ephemeris parent, a heavier body about the primary (the Sun seen from Earth) is the primary's primary
+    int32 GetBodyPrimaryIndex(int32 BodyIndex) const { return BodyPrimaryIndex[BodyIndex]; }
+
+    // Baked density table; null for bodies without an atmosphere
+    const FAtmosphereDensityTablePtr& GetBodyAtmosphere(int32 BodyIndex) const { return BodyAtmosphere[BodyIndex]; }
+
+    // Body state in the system frame; safe to call from worker threads
+    void GetBodyStateAtTime(int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    // Innermost sphere of influence containing a system-frame position; the primary when no other contains it
+    int32 FindDominantBody(const FVector& SystemPosition, double Time) const;
+
+    // Shared handle to the current ephemerides, for work that outlives the frame
+    const FCelestialEphemerisTablePtr& GetEphemerides() const { return Ephemerides; }
+
+    // Ephemeris samples per body orbit
+    static constexpr int32 EphemerisSamples = 512;
+
+private:
+    // Per-body data, indexed by body; the primary and rejected bodies hold a fixed position
+    FCelestialEphemerisTablePtr Ephemerides;
+    TArray<double> BodyMu;
+    TArray<double> BodyRadius;
+    TArray<double> SphereOfInfluenceRadius;
+    TArray<int32> BodyPrimaryIndex;
+    TArray<FAtmosphereDensityTablePtr> BodyAtmosphere;
+};
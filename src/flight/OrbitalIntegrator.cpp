@@ -0,0 +1,61 @@
+// OrbitalIntegrator.cpp
+// Fixed-Step Orbital Integrator for Celestial Syndicate
+// Quantum Documentation: Implements velocity Verlet and classical Runge-Kutta integration
+// Feature Context: Advances spacecraft state by fixed substeps under gravity, thrust and drag
+// Dependencies: Unreal Engine core math
+// Usage Example: FOrbitalIntegrator::Step(EOrbitalIntegrator::VelocityVerlet, Pos, Vel, Acc, Dt, Accel)
+// Security: No shared state; every call works only on the references it is given
+// Performance: Verlet reuses the outgoing acceleration as the next step's incoming acceleration
+
+#include "OrbitalIntegrator.h"
+
+void FOrbitalIntegrator::Step(EOrbitalIntegrator Integrator, FVector& Position, FVector& Velocity, FVector& Acceleration,
+                              double Step, FAccelerationFunction EvaluateAcceleration)
+{
+    switch (Integrator)
+    {
+    case EOrbitalIntegrator::RungeKutta4:
+        StepRungeKutta4(Position, Velocity, Acceleration, Step, EvaluateAcceleration);
+        break;
+
+    case EOrbitalIntegrator::VelocityVerlet:
+    default:
+        StepVelocityVerlet(Position, Velocity, Acceleration, Step, EvaluateAcceleration);
+        break;
+    }
+}
+
+void FOrbitalIntegrator::StepVelocityVerlet(FVector& Position, FVector& Velocity, FVector& Acceleration,
+                                            double Step, FAccelerationFunction EvaluateAcceleration)
+{
+    // Kick-drift-kick: symplectic for position-only forces, so orbital energy does not drift
+    const FVector HalfKickVelocity = Velocity + Acceleration * (0.5 * Step);
+    Position += HalfKickVelocity * Step;
+
+    // Velocity-dependent terms (drag) are evaluated at the half-kick velocity
+    Acceleration = EvaluateAcceleration(Position, HalfKickVelocity);
+    Velocity = HalfKickVelocity + Acceleration * (0.5 * Step);
+}
+
+void FOrbitalIntegrator::StepRungeKutta4(FVector& Position, FVector& Velocity, FVector& Acceleration,
+                                         double Step, FAccelerationFunction EvaluateAcceleration)
+{
+    const double HalfStep = 0.5 * Step;
+
+    const FVector K1Velocity = Velocity;
+    const FVector K1Acceleration = Acceleration;
+
+    const FVector K2Velocity = Velocity + K1Acceleration * HalfStep;
+    const FVector K2Acceleration = EvaluateAcceleration(Position + K1Velocity * HalfStep, K2Velocity);
+
+    const FVector K3Velocity = Velocity + K2Acceleration * HalfStep;
+    const FVector K3Acceleration = EvaluateAcceleration(Position + K2Velocity * HalfStep, K3Velocity);
+
+    const FVector K4Velocity = Velocity + K3Acceleration * Step;
+    const FVector K4Acceleration = EvaluateAcceleration(Position + K3Velocity * Step, K4Velocity);
+
+    Position += (K1Velocity + 2.0 * K2Velocity + 2.0 * K3Velocity + K4Velocity) * (Step / 6.0);
+    Velocity += (K1Acceleration + 2.0 * K2Acceleration + 2.0 * K3Acceleration + K4Acceleration) * (Step / 6.0);
+
+    Acceleration = EvaluateAcceleration(Position, Velocity);
+}
@@ -0,0 +1,39 @@
+// OrbitalIntegrator.h
+// Fixed-Step Orbital Integrator Header for Celestial Syndicate
+// Quantum Documentation: Describes the numerical integration schemes used to advance spacecraft state
+// Feature Context: Provides symplectic and high-order fixed-step integrators for the orbital simulation
+// Dependencies: Unreal Engine core math
+// Usage Example: UOrbitalMechanics::SimulateOrbit calls FOrbitalIntegrator::Step once per substep
+// Security: Stateless and re-entrant, safe to call from simulation worker threads
+// Performance: Velocity Verlet costs one acceleration evaluation per step, RK4 costs four
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OrbitalIntegrator.generated.h"
+
+// Numerical integration schemes
+UENUM(BlueprintType)
+enum class EOrbitalIntegrator : uint8
+{
+    VelocityVerlet UMETA(DisplayName = "Velocity Verlet"),
+    RungeKutta4    UMETA(DisplayName = "Runge-Kutta 4")
+};
+
+// Stateless fixed-step integrators
+struct CELESTIALSYNDICATE_API FOrbitalIntegrator
+{
+    // Acceleration at a given position and velocity
+    using FAccelerationFunction = TFunctionRef<FVector(const FVector& Position, const FVector& Velocity)>;
+
+    // Advances Position and Velocity by Step seconds.
+    // Acceleration must hold the acceleration at the incoming state and is updated to the outgoing state.
+    static void Step(EOrbitalIntegrator Integrator, FVector& Position, FVector& Velocity, FVector& Acceleration,
+                     double Step, FAccelerationFunction EvaluateAcceleration);
+
+    static void StepVelocityVerlet(FVector& Position, FVector& Velocity, FVector& Acceleration,
+                                   double Step, FAccelerationFunction EvaluateAcceleration);
+
+    static void StepRungeKutta4(FVector& Position, FVector& Velocity, FVector& Acceleration,
+                                double Step, FAccelerationFunction EvaluateAcceleration);
+};
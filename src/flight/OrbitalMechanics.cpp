@@ -8,6 +8,12 @@
 // Performance: Optimized for real-time simulation with efficient algorithms
 
 #include "OrbitalMechanics.h"
+#include "FlightProfiling.h"
+#include "Spacecraft.h"
+#include "OrbitalGravitySubsystem.h"
+#include "OrbitalSimulationSubsystem.h"
+#include "OrbitalTransferPlanner.h"
+#include "Async/Async.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "Components/PrimitiveComponent.h"
@@ -16,6 +22,16 @@
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 
+namespace
+{
+    // Drift from the followed conic that warrants a new trajectory and event schedule
+    constexpr double FollowedOrbitPositionTolerance = 10.0; // m
+    constexpr double FollowedOrbitVelocityTolerance = 0.1; // m/s
+
+    // Chaos flight ignores gravity, so it leaves any conic at once; this caps the rebuild rate, for drag too
+    constexpr double FollowedOrbitMinRebuildInterval = 0.25; // s
+}
+
 // Orbital Mechanics System Implementation
 UOrbitalMechanics::UOrbitalMechanics()
 {
@@ -23,17 +39,17 @@ UOrbitalMechanics::UOrbitalMechanics()
     SetIsReplicated(true);
     
     // Initialize physics constants
-    GravitationalConstant = 6.67430e-11f; // m³/kg/s²
-    EarthMass = 5.972e24f; // kg
-    EarthRadius = 6371000.0f; // m
+    GravitationalConstant = 6.67430e-11; // m³/kg/s²
+    EarthMass = 5.972e24; // kg
+    EarthRadius = 6371000.0; // m
     
     // Orbital parameters
-    SemiMajorAxis = 0.0f;
-    Eccentricity = 0.0f;
-    Inclination = 0.0f;
-    ArgumentOfPeriapsis = 0.0f;
-    LongitudeOfAscendingNode = 0.0f;
-    TrueAnomaly = 0.0f;
+    SemiMajorAxis = 0.0;
+    Eccentricity = 0.0;
+    Inclination = 0.0;
+    ArgumentOfPeriapsis = 0.0;
+    LongitudeOfAscendingNode = 0.0;
+    TrueAnomaly = 0.0;
     
     // Current state
     CurrentPosition = FVector::ZeroVector;
@@ -41,9 +57,44 @@ UOrbitalMechanics::UOrbitalMechanics()
     CurrentAcceleration = FVector::ZeroVector;
     
     // Time management
-    SimulationTime = 0.0f;
-    TimeStep = 0.016f; // 60 FPS
+    SimulationTime = 0.0;
+    TimeStep = 0.016; // 60 FPS
     TimeAcceleration = 1.0f;
+    MaxSubstepsPerFrame = 16;
+    Integrator = EOrbitalIntegrator::VelocityVerlet;
+    TimeAccumulator = 0.0;
+    
+    // Propagation
+    bAllowOnRails = true;
+    PropagationMode = EOrbitalPropagationMode::Numeric;
+    Significance = EOrbitalSignificance::Near;
+    
+    // World simulation registration
+    SimulationSlot = INDEX_NONE;
+    UnsimulatedTime = 0.0f;
+    bSimulatedThisFrame = false;
+    PendingThrustAcceleration = FVector::ZeroVector;
+    PendingDragFactor = 0.0;
+    bFollowRigidBody = false;
+    RigidBodySystemPosition = FVector::ZeroVector;
+    RigidBodySystemVelocity = FVector::ZeroVector;
+    AppliedFrameOrigin = FVector::ZeroVector;
+    OwningSimulation = nullptr;
+    ParentBodyIndex = 0;
+    ParentMu = GravitationalConstant * EarthMass;
+    ParentRadius = EarthRadius;
+    ParentPosition = FVector::ZeroVector;
+    ParentVelocity = FVector::ZeroVector;
+    bParentBodyChanged = false;
+    bEventsDirty = true;
+    bEscapeReported = false;
+    EventGeneration = 0;
+    NumQueuedEvents = 0;
+    
+    // Networking
+    ReplicatedOrbitInterval = 0.1f;
+    bReplicatedOrbitDirty = true;
+    LastReplicatedOrbitTime = 0.0;
     
     // Celestial bodies
     CelestialBodies = TArray<FCelestialBody>();
@@ -54,17 +105,32 @@ void UOrbitalMechanics::BeginPlay()
 {
     Super::BeginPlay();
     
+    // Join the shared body set; the first component seeds it, and its per-body tables are shared by every ship
+    UOrbitalGravitySubsystem* Gravity = GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>();
+    if (Gravity && Gravity->GetNumBodies() == 0)
+    {
+        Gravity->SetCelestialBodies(CelestialBodies, GravitationalConstant);
+    }
+    if (Gravity && Gravity->GetNumBodies() > 0)
+    {
+        SetParentBody(0, Gravity);
+    }
+    else
+    {
+        // Without a body set, fall back to an Earth-centred two-body orbit
+        ParentMu = GravitationalConstant * EarthMass;
+        ParentRadius = EarthRadius;
+        ParentAtmosphere = GetDefault<UEarthAtmosphere>()->BakeDensityTable();
+    }
+    
     // Initialize orbital elements
     CalculateOrbitalElements();
     
-    // Start physics simulation
-    GetWorld()->GetTimerManager().SetTimer(
-        PhysicsTimer,
-        this,
-        &UOrbitalMechanics::UpdatePhysics,
-        TimeStep,
-        true
-    );
+    // Hand per-frame propagation over to the world simulation; registering first gives us its frame origin
+    if (UOrbitalSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UOrbitalSimulationSubsystem>())
+    {
+        Simulation->RegisterShip(this);
+    }
     
     // Initialize spacecraft state
     if (ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner()))
@@ -73,73 +139,479 @@ void UOrbitalMechanics::BeginPlay()
     }
 }
 
+void UOrbitalMechanics::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UOrbitalSimulationSubsystem* Simulation = World->GetSubsystem<UOrbitalSimulationSubsystem>())
+        {
+            Simulation->UnregisterShip(this);
+        }
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
 void UOrbitalMechanics::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    CELESTIAL_FLIGHT_SCOPE(OrbitalMechanicsTick);
+    
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
-    // Update simulation time
+    // Standalone path, only reached when no simulation subsystem has taken over this component
+    GatherSimulationInputs();
+    SimulateOrbit(DeltaTime, GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>());
+    ApplySimulationResults();
+}
+
+void UOrbitalMechanics::GatherSimulationInputs()
+{
+    // Actor reads happen here, on the game thread, so SimulateOrbit never touches the owner
+    PendingThrustAcceleration = FVector::ZeroVector;
+    PendingDragFactor = 0.0;
+    bFollowRigidBody = false;
+    
+    if (ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner()))
+    {
+        // Chaos and the predicted flight model already apply thrust; sample where they put the ship instead
+        if (Spacecraft->GetFlightModelMode() != EFlightModelMode::Orbital)
+        {
+            const FVector WorldLocation = Spacecraft->GetActorLocation();
+            RigidBodySystemPosition = OwningSimulation ? OwningSimulation->WorldToOrbital(WorldLocation) : WorldLocation;
+            RigidBodySystemVelocity = Spacecraft->GetFlightVelocity();
+            bFollowRigidBody = true;
+            return;
+        }
+        
+        const double SpacecraftMass = Spacecraft->GetMass();
+        if (SpacecraftMass <= 0.0)
+        {
+            return;
+        }
+        
+        double ThrustMagnitude = Spacecraft->GetThrustMagnitude();
+        if (ThrustMagnitude > 0.0)
+        {
+            PendingThrustAcceleration = Spacecraft->GetThrustVector() * ThrustMagnitude / SpacecraftMass;
+        }
+        PendingDragFactor = Spacecraft->GetDragCoefficient() * Spacecraft->GetDragReferenceArea() / SpacecraftMass;
+    }
+}
+
+void UOrbitalMechanics::SimulateOrbit(float DeltaTime, const UOrbitalGravitySubsystem* Gravity)
+{
+    // Clients never integrate: the server owns the orbit and sends a new conic whenever it changes
+    if (FollowsReplicatedOrbit())
+    {
+        PropagateReplicatedOrbit(DeltaTime, Gravity);
+        return;
+    }
+    
+    if (bFollowRigidBody)
+    {
+        FollowRigidBody(DeltaTime, Gravity);
+        return;
+    }
+    
+    // Coasting ships follow their conic analytically until thrust or the atmosphere intervenes
+    if (IsOnRails())
+    {
+        if (!ShouldLeaveOnRails())
+        {
+            PropagateOnRails(DeltaTime);
+            UpdateParentBody(Gravity);
+            UpdateTrajectory(Gravity);
+            return;
+        }
+        LeaveOnRails();
+    }
+    
+    // Numeric integration is the single source of truth for the ship state
+    UpdatePhysics(DeltaTime);
+    
+    // Keep the orbital elements in step with burns
+    if (!PendingThrustAcceleration.IsZero())
+    {
+        UpdateOrbitalElementsFromThrust();
+    }
+    else if (CanEnterOnRails())
+    {
+        EnterOnRails();
+    }
+    else if (PendingDragFactor > 0.0 && RefollowOrbitOnDrift())
+    {
+        // Drag bends the conic a little every step, so the prediction follows it like a rigid body's
+        CalculateOrbitalElements();
+    }
+    
+    UpdateParentBody(Gravity);
+    UpdateTrajectory(Gravity);
+}
+
+void UOrbitalMechanics::FollowRigidBody(float DeltaTime, const UOrbitalGravitySubsystem* Gravity)
+{
+    if (IsOnRails())
+    {
+        LeaveOnRails();
+    }
+    
+    // Chaos runs in real time, so proximity flight holds the orbital clock at 1x
+    SimulationTime += DeltaTime;
+    if (Gravity && Gravity->GetNumBodies() > 0)
+    {
+        Gravity->GetBodyStateAtTime(ParentBodyIndex, SimulationTime, ParentPosition, ParentVelocity);
+    }
+    CurrentPosition = RigidBodySystemPosition - ParentPosition;
+    CurrentVelocity = RigidBodySystemVelocity - ParentVelocity;
+    
+    // The elements are cheap and always current; the path and events wait until the ship has left the conic they came from
+    CalculateOrbitalElements();
+    RefollowOrbitOnDrift();
+    
+    UpdateParentBody(Gravity);
+    UpdateTrajectory(Gravity);
+}
+
+bool UOrbitalMechanics::RefollowOrbitOnDrift()
+{
+    bool bLeftFollowedOrbit = !FollowedOrbit.bIsValid;
+    if (!bLeftFollowedOrbit)
+    {
+        FVector ExpectedPosition, ExpectedVelocity;
+        FollowedOrbit.GetStateAtTime(SimulationTime, ExpectedPosition, ExpectedVelocity);
+        bLeftFollowedOrbit = !CurrentPosition.Equals(ExpectedPosition, FollowedOrbitPositionTolerance)
+            || !CurrentVelocity.Equals(ExpectedVelocity, FollowedOrbitVelocityTolerance);
+    }
+    if (!bLeftFollowedOrbit || FMath::Abs(SimulationTime - FollowedOrbit.EpochTime) < FollowedOrbitMinRebuildInterval)
+    {
+        return false;
+    }
+    
+    FollowedOrbit = FKeplerOrbit::FromStateVectors(CurrentPosition, CurrentVelocity, ParentMu, SimulationTime);
+    Trajectory.Invalidate();
+    InvalidateOrbitalEvents();
+    return true;
+}
+
+void UOrbitalMechanics::SetParentBody(int32 BodyIndex, const UOrbitalGravitySubsystem* Gravity)
+{
+    ParentBodyIndex = BodyIndex;
+    ParentMu = Gravity->GetBodyMu(BodyIndex);
+    ParentRadius = Gravity->GetBodyRadius(BodyIndex);
+    ParentAtmosphere = Gravity->GetBodyAtmosphere(BodyIndex);
+    Gravity->GetBodyStateAtTime(BodyIndex, SimulationTime, ParentPosition, ParentVelocity);
+}
+
+void UOrbitalMechanics::UpdateParentBody(const UOrbitalGravitySubsystem* Gravity)
+{
+    if (!Gravity || Gravity->GetNumBodies() == 0)
+    {
+        return;
+    }
+    
+    Gravity->GetBodyStateAtTime(ParentBodyIndex, SimulationTime, ParentPosition, ParentVelocity);
+    
+    // Clients take SOI changes from the server along with the new conic
+    if (FollowsReplicatedOrbit())
+    {
+        return;
+    }
+    
+    const FVector SystemPosition = GetSystemPosition();
+    const FVector SystemVelocity = GetSystemVelocity();
+    const int32 DominantBody = Gravity->FindDominantBody(SystemPosition, SimulationTime);
+    if (DominantBody == ParentBodyIndex)
+    {
+        return;
+    }
+    
+    // Patch the conic: re-express the state about the new parent and restart two-body propagation there
+    SetParentBody(DominantBody, Gravity);
+    CurrentPosition = SystemPosition - ParentPosition;
+    CurrentVelocity = SystemVelocity - ParentVelocity;
+    
+    if (IsOnRails())
+    {
+        LeaveOnRails();
+    }
+    CalculateOrbitalElements();
+    Trajectory.Invalidate();
+    InvalidateOrbitalEvents();
+    bParentBodyChanged = true;
+    bReplicatedOrbitDirty = true;
+}
+
+FKeplerOrbit UOrbitalMechanics::GetOsculatingOrbit() const
+{
+    return IsOnRails()
+        ? RailsOrbit
+        : FKeplerOrbit::FromStateVectors(CurrentPosition, CurrentVelocity, ParentMu, SimulationTime);
+}
+
+void UOrbitalMechanics::UpdateTrajectory(const UOrbitalGravitySubsystem* Gravity)
+{
+    if (Trajectory.IsDirty())
+    {
+        Trajectory.Rebuild(GetOsculatingOrbit(), ParentBodyIndex, SimulationTime);
+    }
+    
+    Trajectory.Update(SimulationTime, Gravity);
+}
+
+bool UOrbitalMechanics::CanEnterOnRails() const
+{
+    return bAllowOnRails
+        && PendingThrustAcceleration.IsZero()
+        && CurrentPosition.Size() > GetAtmosphereCeilingRadius();
+}
+
+bool UOrbitalMechanics::ShouldLeaveOnRails() const
+{
+    if (!PendingThrustAcceleration.IsZero())
+    {
+        return true;
+    }
+    
+    // Orbits whose periapsis clears the atmosphere can never reach drag altitude, so skip the radius test
+    const double CeilingRadius = GetAtmosphereCeilingRadius();
+    return RailsOrbit.GetPeriapsisRadius() < CeilingRadius && CurrentPosition.Size() < CeilingRadius;
+}
+
+void UOrbitalMechanics::EnterOnRails()
+{
+    RailsOrbit = FKeplerOrbit::FromStateVectors(CurrentPosition, CurrentVelocity, ParentMu, SimulationTime);
+    if (!RailsOrbit.bIsValid)
+    {
+        return; // Radial trajectories stay on numeric integration
+    }
+    
+    PropagationMode = EOrbitalPropagationMode::OnRails;
+    TimeAccumulator = 0.0;
+    CalculateOrbitalElements();
+    
+    // Drag may have bent the conic since the last prediction
+    Trajectory.Invalidate();
+    InvalidateOrbitalEvents();
+    bReplicatedOrbitDirty = true;
+}
+
+void UOrbitalMechanics::LeaveOnRails()
+{
+    PropagationMode = EOrbitalPropagationMode::Numeric;
+    TimeAccumulator = 0.0;
+}
+
+void UOrbitalMechanics::PropagateOnRails(float DeltaTime)
+{
+    // O(1) per frame at any time acceleration: evaluate the conic at the new time directly
     SimulationTime += DeltaTime * TimeAcceleration;
+    RailsOrbit.GetStateAtTime(SimulationTime, CurrentPosition, CurrentVelocity);
+    UpdateRailsAcceleration();
+}
+
+bool UOrbitalMechanics::PrepareBatchedRailsStep(float DeltaTime, double& OutMeanAnomaly, double& OutEccentricity)
+{
+    // Only elliptic coasters share the batched Kepler solve; everything else takes SimulateOrbit
+    if (!IsOnRails() || !RailsOrbit.IsElliptic() || ShouldLeaveOnRails())
+    {
+        return false;
+    }
     
-    // Update orbital position
-    UpdateOrbitalPosition(DeltaTime);
+    SimulationTime += DeltaTime * TimeAcceleration;
+    OutMeanAnomaly = RailsOrbit.GetMeanAnomalyAtTime(SimulationTime);
+    OutEccentricity = RailsOrbit.Eccentricity;
+    return true;
+}
+
+void UOrbitalMechanics::FinishBatchedRailsStep(double EccentricAnomaly, const UOrbitalGravitySubsystem* Gravity)
+{
+    RailsOrbit.GetStateFromEccentricAnomaly(EccentricAnomaly, CurrentPosition, CurrentVelocity);
+    UpdateRailsAcceleration();
+    UpdateParentBody(Gravity);
+    UpdateTrajectory(Gravity);
+}
+
+void UOrbitalMechanics::UpdateRailsAcceleration()
+{
+    const double Radius = CurrentPosition.Size();
+    CurrentAcceleration = -CurrentPosition * (RailsOrbit.Mu / (Radius * Radius * Radius));
+}
+
+void UOrbitalMechanics::GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const
+{
+    const FKeplerOrbit Orbit = GetOsculatingOrbit();
+    
+    if (!Orbit.bIsValid)
+    {
+        // Radial trajectory: fall back to straight-line extrapolation
+        OutPosition = CurrentPosition + CurrentVelocity * (Time - SimulationTime);
+        OutVelocity = CurrentVelocity;
+        return;
+    }
+    
+    Orbit.GetStateAtTime(Time, OutPosition, OutVelocity);
+}
+
+void UOrbitalMechanics::ApplySimulationResults()
+{
+    if (bParentBodyChanged)
+    {
+        bParentBodyChanged = false;
+        OnSphereOfInfluenceChanged.Broadcast(ParentBodyIndex);
+    }
+    
+    // Workers only build snapshots; swapping the shared handle happens here, where readers copy it
+    Trajectory.PublishPending();
     
-    // Apply gravitational forces
-    ApplyGravitationalForces();
+    UpdateReplicatedOrbit();
     
     // Update spacecraft state
     UpdateSpacecraftState();
+}
+
+void UOrbitalMechanics::UpdateReplicatedOrbit()
+{
+    if (FollowsReplicatedOrbit())
+    {
+        return;
+    }
+    
+    // A warp change re-epochs the conic so clients switch rate at the server's clock
+    if (ReplicatedOrbit.TimeAcceleration != TimeAcceleration)
+    {
+        bReplicatedOrbitDirty = true;
+    }
+    
+    // Coasting conics only change discretely; under thrust or drag they drift every step, so cap the send rate
+    const bool bContinuous = !IsOnRails();
+    if (!bReplicatedOrbitDirty && !bContinuous)
+    {
+        return;
+    }
     
-    // Check for orbital events
-    CheckOrbitalEvents();
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    if (!bReplicatedOrbitDirty && WorldTime - LastReplicatedOrbitTime < ReplicatedOrbitInterval)
+    {
+        return;
+    }
+    
+    // Re-epoch at the current time so clients can adopt the epoch as their clock
+    const FKeplerOrbit Orbit = FKeplerOrbit::FromStateVectors(CurrentPosition, CurrentVelocity, ParentMu, SimulationTime);
+    ReplicatedOrbit = FReplicatedOrbit::FromKeplerOrbit(Orbit, ParentBodyIndex, TimeAcceleration);
+    LastReplicatedOrbitTime = WorldTime;
+    bReplicatedOrbitDirty = false;
+}
+
+void UOrbitalMechanics::OnRep_ReplicatedOrbit()
+{
+    const UOrbitalGravitySubsystem* Gravity = GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>();
+    
+    SimulationTime = ReplicatedOrbit.EpochTime;
+    if (TimeAcceleration != ReplicatedOrbit.TimeAcceleration)
+    {
+        SetTimeAcceleration(ReplicatedOrbit.TimeAcceleration);
+    }
+    if (Gravity && Gravity->GetNumBodies() > 0)
+    {
+        const int32 BodyIndex = FMath::Clamp(ReplicatedOrbit.ParentBodyIndex, 0, Gravity->GetNumBodies() - 1);
+        bParentBodyChanged |= BodyIndex != ParentBodyIndex;
+        SetParentBody(BodyIndex, Gravity);
+    }
+    
+    RailsOrbit = ReplicatedOrbit.ToKeplerOrbit(ParentMu);
+    if (!RailsOrbit.bIsValid)
+    {
+        return; // Hold the last good state until the server sends a usable conic
+    }
+    
+    PropagationMode = EOrbitalPropagationMode::OnRails;
+    TimeAccumulator = 0.0;
+    CurrentPosition = RailsOrbit.EpochPosition;
+    CurrentVelocity = RailsOrbit.EpochVelocity;
+    UpdateRailsAcceleration();
+    CalculateOrbitalElements();
+    Trajectory.Invalidate();
+    InvalidateOrbitalEvents();
+}
+
+void UOrbitalMechanics::PropagateReplicatedOrbit(float DeltaTime, const UOrbitalGravitySubsystem* Gravity)
+{
+    if (!IsOnRails())
+    {
+        return; // Nothing received yet
+    }
+    
+    PropagateOnRails(DeltaTime);
+    UpdateParentBody(Gravity);
+    UpdateTrajectory(Gravity);
 }
 
 void UOrbitalMechanics::InitializeCelestialBodies()
 {
-    // Add major celestial bodies in the game universe
+    // Add major celestial bodies in the game universe. Earth is the fixed primary at the origin
+    // and every other body orbits its parent; the planets orbit the Sun, which is seen from Earth
     CelestialBodies.Add(FCelestialBody{
         TEXT("Earth"),
-        FVector(0.0f, 0.0f, 0.0f),
+        FVector(0.0, 0.0, 0.0),
         FVector::ZeroVector,
         EarthMass,
         EarthRadius,
         FLinearColor::Blue
     });
+    CelestialBodies.Last().Atmosphere = GetMutableDefault<UEarthAtmosphere>();
     
     CelestialBodies.Add(FCelestialBody{
         TEXT("Moon"),
-        FVector(384400000.0f, 0.0f, 0.0f), // 384,400 km from Earth
-        FVector(0.0f, 1022.0f, 0.0f), // Orbital velocity
-        7.342e22f, // kg
-        1737000.0f, // m
+        FVector(384400000.0, 0.0, 0.0), // 384,400 km from Earth
+        FVector(0.0, 1022.0, 0.0), // Orbital velocity
+        7.342e22, // kg
+        1737000.0, // m
         FLinearColor::Gray
     });
+    CelestialBodies.Last().ParentIndex = 0;
+    
+    const FVector SunPosition(-149600000000.0, 0.0, 0.0); // 1 AU from Earth
+    const FVector SunVelocity(0.0, -29780.0, 0.0); // Earth's orbital velocity, reversed
+    CelestialBodies.Add(FCelestialBody{
+        TEXT("Sun"),
+        SunPosition,
+        SunVelocity,
+        1.989e30, // kg
+        696340000.0, // m
+        FLinearColor::White
+    });
+    CelestialBodies.Last().ParentIndex = 0;
+    const int32 SunIndex = CelestialBodies.Num() - 1;
     
     CelestialBodies.Add(FCelestialBody{
         TEXT("Mars"),
-        FVector(225000000000.0f, 0.0f, 0.0f), // 225 million km from Earth
-        FVector(0.0f, 24000.0f, 0.0f), // Orbital velocity
-        6.39e23f, // kg
-        3389000.0f, // m
+        SunPosition + FVector(227900000000.0, 0.0, 0.0), // 227.9 million km from the Sun
+        SunVelocity + FVector(0.0, 24070.0, 0.0), // Orbital velocity
+        6.39e23, // kg
+        3389000.0, // m
         FLinearColor::Red
     });
+    CelestialBodies.Last().ParentIndex = SunIndex;
     
     CelestialBodies.Add(FCelestialBody{
         TEXT("Jupiter"),
-        FVector(778000000000.0f, 0.0f, 0.0f), // 778 million km from Earth
-        FVector(0.0f, 13000.0f, 0.0f), // Orbital velocity
-        1.898e27f, // kg
-        69911000.0f, // m
+        SunPosition + FVector(778500000000.0, 0.0, 0.0), // 778.5 million km from the Sun
+        SunVelocity + FVector(0.0, 13070.0, 0.0), // Orbital velocity
+        1.898e27, // kg
+        69911000.0, // m
         FLinearColor::Orange
     });
+    CelestialBodies.Last().ParentIndex = SunIndex;
     
     CelestialBodies.Add(FCelestialBody{
         TEXT("Saturn"),
-        FVector(1427000000000.0f, 0.0f, 0.0f), // 1.427 billion km from Earth
-        FVector(0.0f, 9600.0f, 0.0f), // Orbital velocity
-        5.683e26f, // kg
-        58232000.0f, // m
+        SunPosition + FVector(1433500000000.0, 0.0, 0.0), // 1.4335 billion km from the Sun
+        SunVelocity + FVector(0.0, 9680.0, 0.0), // Orbital velocity
+        5.683e26, // kg
+        58232000.0, // m
         FLinearColor::Yellow
     });
+    CelestialBodies.Last().ParentIndex = SunIndex;
 }
 
 void UOrbitalMechanics::InitializeSpacecraft(ASpacecraft* Spacecraft)
@@ -150,16 +622,20 @@ void UOrbitalMechanics::InitializeSpacecraft(ASpacecraft* Spacecraft)
     }
     
     // Set initial position and velocity
-    CurrentPosition = Spacecraft->GetActorLocation();
+    CurrentPosition = OwningSimulation ? OwningSimulation->WorldToOrbital(Spacecraft->GetActorLocation()) : Spacecraft->GetActorLocation();
     CurrentVelocity = Spacecraft->GetVelocity();
     
+    // The actor starts in the system frame; move the state into the sphere of influence it begins in
+    UpdateParentBody(GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>());
+    bParentBodyChanged = false;
+    
     // Calculate initial orbital elements
     CalculateOrbitalElements();
     
     // Initialize spacecraft physics
     Spacecraft->SetOrbitalMechanics(this);
     
-    UE_LOG(LogTemp, Log, TEXT("Spacecraft initialized at position: %s"), *CurrentPosition.ToString());
+    UE_LOG(LogCelestialFlight, Verbose, TEXT("Spacecraft initialized at position: %s"), *CurrentPosition.ToString());
 }
 
 void UOrbitalMechanics::CalculateOrbitalElements()
@@ -172,18 +648,18 @@ void UOrbitalMechanics::CalculateOrbitalElements()
     
     // Calculate specific angular momentum
     FVector H = FVector::CrossProduct(R, V);
-    float H_magnitude = H.Size();
+    double H_magnitude = H.Size();
     
     // Calculate eccentricity vector
-    FVector E = FVector::CrossProduct(V, H) / (GravitationalConstant * EarthMass) - R.GetSafeNormal();
+    FVector E = FVector::CrossProduct(V, H) / ParentMu - R.GetSafeNormal();
     Eccentricity = E.Size();
     
     // Calculate semi-major axis
-    float Energy = (V.SizeSquared() / 2.0f) - (GravitationalConstant * EarthMass / R.Size());
-    SemiMajorAxis = -GravitationalConstant * EarthMass / (2.0f * Energy);
+    double Energy = (V.SizeSquared() / 2.0) - (ParentMu / R.Size());
+    SemiMajorAxis = -ParentMu / (2.0 * Energy);
     
     // Calculate inclination
-    FVector K = FVector(0.0f, 0.0f, 1.0f);
+    FVector K = FVector(0.0, 0.0, 1.0);
     Inclination = FMath::Acos(FVector::DotProduct(H.GetSafeNormal(), K));
     
     // Calculate other orbital elements
@@ -193,27 +669,27 @@ void UOrbitalMechanics::CalculateOrbitalElements()
 void UOrbitalMechanics::CalculateRemainingOrbitalElements(const FVector& R, const FVector& V, const FVector& H, const FVector& E)
 {
     // Calculate longitude of ascending node
-    FVector N = FVector::CrossProduct(FVector(0.0f, 0.0f, 1.0f), H);
-    if (N.Size() > 0.0f)
+    FVector N = FVector::CrossProduct(FVector(0.0, 0.0, 1.0), H);
+    if (N.Size() > 0.0)
     {
         LongitudeOfAscendingNode = FMath::Atan2(N.Y, N.X);
     }
     
     // Calculate argument of periapsis
-    if (N.Size() > 0.0f && Eccentricity > 0.0f)
+    if (N.Size() > 0.0 && Eccentricity > 0.0)
     {
         ArgumentOfPeriapsis = FMath::Acos(FVector::DotProduct(N.GetSafeNormal(), E.GetSafeNormal()));
-        if (E.Z < 0.0f)
+        if (E.Z < 0.0)
         {
-            ArgumentOfPeriapsis = 2.0f * PI - ArgumentOfPeriapsis;
+            ArgumentOfPeriapsis = 2.0 * PI - ArgumentOfPeriapsis;
         }
     }
     
     // Calculate true anomaly
-    if (Eccentricity > 0.0f)
+    if (Eccentricity > 0.0)
     {
-        float CosNu = FVector::DotProduct(E.GetSafeNormal(), R.GetSafeNormal());
-        float SinNu = FVector::DotProduct(FVector::CrossProduct(E.GetSafeNormal(), R.GetSafeNormal()), H.GetSafeNormal());
+        double CosNu = FVector::DotProduct(E.GetSafeNormal(), R.GetSafeNormal());
+        double SinNu = FVector::DotProduct(FVector::CrossProduct(E.GetSafeNormal(), R.GetSafeNormal()), H.GetSafeNormal());
         TrueAnomaly = FMath::Atan2(SinNu, CosNu);
     }
 }
@@ -221,11 +697,11 @@ void UOrbitalMechanics::CalculateRemainingOrbitalElements(const FVector& R, cons
 void UOrbitalMechanics::UpdateOrbitalPosition(float DeltaTime)
 {
     // Update orbital position using Kepler's laws
-    if (Eccentricity < 1.0f) // Elliptical orbit
+    if (Eccentricity < 1.0) // Elliptical orbit
     {
         UpdateEllipticalOrbit(DeltaTime);
     }
-    else if (Eccentricity > 1.0f) // Hyperbolic orbit
+    else if (Eccentricity > 1.0) // Hyperbolic orbit
     {
         UpdateHyperbolicOrbit(DeltaTime);
     }
@@ -237,340 +713,308 @@ void UOrbitalMechanics::UpdateOrbitalPosition(float DeltaTime)
 
 void UOrbitalMechanics::UpdateEllipticalOrbit(float DeltaTime)
 {
-    // Calculate mean motion
-    float MeanMotion = FMath::Sqrt(GravitationalConstant * EarthMass / (SemiMajorAxis * SemiMajorAxis * SemiMajorAxis));
-    
-    // Update mean anomaly
-    float MeanAnomaly = MeanMotion * SimulationTime;
-    
-    // Solve Kepler's equation for eccentric anomaly
-    float EccentricAnomaly = SolveKeplersEquation(MeanAnomaly, Eccentricity);
-    
-    // Calculate true anomaly
-    TrueAnomaly = 2.0f * FMath::Atan(FMath::Sqrt((1.0f + Eccentricity) / (1.0f - Eccentricity)) * FMath::Tan(EccentricAnomaly / 2.0f));
-    
-    // Calculate orbital radius
-    float Radius = SemiMajorAxis * (1.0f - Eccentricity * Eccentricity) / (1.0f + Eccentricity * FMath::Cos(TrueAnomaly));
-    
-    // Calculate position in orbital plane
-    FVector OrbitalPosition = FVector(
-        Radius * FMath::Cos(TrueAnomaly),
-        Radius * FMath::Sin(TrueAnomaly),
-        0.0f
-    );
-    
-    // Transform to 3D space
-    CurrentPosition = TransformOrbitalToWorld(OrbitalPosition);
-    
-    // Calculate velocity
-    float AngularVelocity = MeanMotion * (1.0f + Eccentricity * FMath::Cos(TrueAnomaly));
-    CurrentVelocity = FVector(
-        -AngularVelocity * Radius * FMath::Sin(TrueAnomaly),
-        AngularVelocity * Radius * FMath::Cos(TrueAnomaly),
-        0.0f
-    );
-    CurrentVelocity = TransformOrbitalToWorld(CurrentVelocity);
+    // Kepler's equation about the current state as epoch, never the absolute simulation time
+    AdvanceAlongConic(DeltaTime);
 }
 
-float UOrbitalMechanics::SolveKeplersEquation(float MeanAnomaly, float Eccentricity)
+void UOrbitalMechanics::UpdateHyperbolicOrbit(float DeltaTime)
 {
-    // Newton-Raphson method to solve Kepler's equation
-    float E = MeanAnomaly; // Initial guess
-    const int MaxIterations = 10;
-    const float Tolerance = 1e-6f;
-    
-    for (int i = 0; i < MaxIterations; i++)
-    {
-        float F = E - Eccentricity * FMath::Sin(E) - MeanAnomaly;
-        float FPrime = 1.0f - Eccentricity * FMath::Cos(E);
-        
-        if (FMath::Abs(F) < Tolerance)
-        {
-            break;
-        }
-        
-        E = E - F / FPrime;
-    }
-    
-    return E;
+    // Open conics take the universal-variable solve, from the same epoch-relative state as the closed ones
+    AdvanceAlongConic(DeltaTime);
 }
 
-FVector UOrbitalMechanics::TransformOrbitalToWorld(const FVector& OrbitalVector)
+void UOrbitalMechanics::UpdateParabolicOrbit(float DeltaTime)
 {
-    // Transform from orbital plane to world coordinates
-    // This is a simplified transformation - in a full implementation, you'd use proper rotation matrices
-    
-    FVector Transformed = OrbitalVector;
-    
-    // Apply rotation around Z-axis (longitude of ascending node)
-    float CosOmega = FMath::Cos(LongitudeOfAscendingNode);
-    float SinOmega = FMath::Sin(LongitudeOfAscendingNode);
-    Transformed = FVector(
-        Transformed.X * CosOmega - Transformed.Y * SinOmega,
-        Transformed.X * SinOmega + Transformed.Y * CosOmega,
-        Transformed.Z
-    );
-    
-    // Apply rotation around X-axis (inclination)
-    float CosI = FMath::Cos(Inclination);
-    float SinI = FMath::Sin(Inclination);
-    Transformed = FVector(
-        Transformed.X,
-        Transformed.Y * CosI - Transformed.Z * SinI,
-        Transformed.Y * SinI + Transformed.Z * CosI
-    );
-    
-    // Apply rotation around Z-axis (argument of periapsis)
-    float CosW = FMath::Cos(ArgumentOfPeriapsis);
-    float SinW = FMath::Sin(ArgumentOfPeriapsis);
-    Transformed = FVector(
-        Transformed.X * CosW - Transformed.Y * SinW,
-        Transformed.X * SinW + Transformed.Y * CosW,
-        Transformed.Z
-    );
-    
-    return Transformed;
+    // The Stumpff series handles the e = 1 limit without special-casing
+    AdvanceAlongConic(DeltaTime);
 }
 
-void UOrbitalMechanics::UpdateHyperbolicOrbit(float DeltaTime)
+void UOrbitalMechanics::AdvanceAlongConic(float DeltaTime)
 {
-    // Similar to elliptical orbit but with hyperbolic functions
-    // Implementation for hyperbolic trajectories
-    UE_LOG(LogTemp, Warning, TEXT("Hyperbolic orbit update not implemented"));
+    const FKeplerOrbit Orbit = FKeplerOrbit::FromStateVectors(CurrentPosition, CurrentVelocity, ParentMu, 0.0);
+    if (!Orbit.bIsValid)
+    {
+        return;
+    }
+    
+    Orbit.GetStateAtTime(DeltaTime * TimeAcceleration, CurrentPosition, CurrentVelocity);
+    TrueAnomaly = FMath::Atan2(FVector::DotProduct(CurrentPosition, Orbit.NormalAxis), FVector::DotProduct(CurrentPosition, Orbit.PeriapsisAxis));
 }
 
-void UOrbitalMechanics::UpdateParabolicOrbit(float DeltaTime)
+void UOrbitalMechanics::ApplyGravitationalForces()
 {
-    // Implementation for parabolic trajectories
-    UE_LOG(LogTemp, Warning, TEXT("Parabolic orbit update not implemented"));
+    // Parent-body gravity plus thrust and atmospheric drag
+    CurrentAcceleration = EvaluateAcceleration(CurrentPosition, CurrentVelocity);
 }
 
-void UOrbitalMechanics::ApplyGravitationalForces()
+FVector UOrbitalMechanics::EvaluateAcceleration(const FVector& Position, const FVector& Velocity) const
 {
-    CurrentAcceleration = FVector::ZeroVector;
-    
-    // Apply gravitational force from all celestial bodies
-    for (const FCelestialBody& Body : CelestialBodies)
+    // Two-body gravity against the parent; other bodies only matter once their sphere of influence is entered
+    FVector Acceleration = FVector::ZeroVector;
+    const double RadiusSquared = Position.SizeSquared();
+    if (RadiusSquared > SMALL_NUMBER)
     {
-        FVector ToBody = Body.Position - CurrentPosition;
-        float Distance = ToBody.Size();
-        
-        if (Distance > 0.0f)
-        {
-            // Calculate gravitational force
-            float ForceMagnitude = GravitationalConstant * Body.Mass / (Distance * Distance);
-            FVector Force = ToBody.GetSafeNormal() * ForceMagnitude;
-            
-            // Apply force to spacecraft (assuming mass = 1000 kg)
-            float SpacecraftMass = 1000.0f;
-            CurrentAcceleration += Force / SpacecraftMass;
-        }
+        Acceleration = -Position * (ParentMu / (RadiusSquared * FMath::Sqrt(RadiusSquared)));
     }
     
-    // Apply thrust forces
-    ApplyThrustForces();
+    // Thrust was sampled from the spacecraft in GatherSimulationInputs
+    Acceleration += PendingThrustAcceleration;
     
     // Apply atmospheric drag (if in atmosphere)
-    ApplyAtmosphericDrag();
+    Acceleration += CalculateDragAcceleration(Position, Velocity);
+    
+    return Acceleration;
 }
 
-void UOrbitalMechanics::ApplyThrustForces()
+FVector UOrbitalMechanics::CalculateDragAcceleration(const FVector& Position, const FVector& Velocity) const
 {
-    if (ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner()))
+    if (PendingDragFactor <= 0.0)
     {
-        FVector ThrustVector = Spacecraft->GetThrustVector();
-        float ThrustMagnitude = Spacecraft->GetThrustMagnitude();
-        
-        if (ThrustMagnitude > 0.0f)
-        {
-            float SpacecraftMass = 1000.0f; // kg
-            FVector ThrustAcceleration = ThrustVector * ThrustMagnitude / SpacecraftMass;
-            CurrentAcceleration += ThrustAcceleration;
-            
-            // Update orbital elements due to thrust
-            UpdateOrbitalElementsFromThrust(ThrustAcceleration);
-        }
+        return FVector::ZeroVector;
     }
-}
-
-void UOrbitalMechanics::ApplyAtmosphericDrag()
-{
-    // Calculate atmospheric density based on altitude
-    float Altitude = CurrentPosition.Size() - EarthRadius;
-    float AtmosphericDensity = CalculateAtmosphericDensity(Altitude);
     
-    if (AtmosphericDensity > 0.0f)
+    // Calculate atmospheric density based on altitude
+    double AtmosphericDensity = CalculateAtmosphericDensity(Position.Size() - ParentRadius);
+    if (AtmosphericDensity <= 0.0)
     {
-        // Calculate drag force
-        float DragCoefficient = 2.0f; // Typical for spacecraft
-        float CrossSectionalArea = 10.0f; // m²
-        float VelocityMagnitude = CurrentVelocity.Size();
-        
-        float DragForce = 0.5f * AtmosphericDensity * DragCoefficient * CrossSectionalArea * VelocityMagnitude * VelocityMagnitude;
-        FVector DragAcceleration = -CurrentVelocity.GetSafeNormal() * DragForce / 1000.0f; // 1000 kg spacecraft
-        
-        CurrentAcceleration += DragAcceleration;
+        return FVector::ZeroVector;
     }
+    
+    // a = ½ ρ v² Cd A / m, opposing the velocity
+    return -Velocity * (0.5 * AtmosphericDensity * Velocity.Size() * PendingDragFactor);
 }
 
-float UOrbitalMechanics::CalculateAtmosphericDensity(float Altitude)
+double UOrbitalMechanics::CalculateAtmosphericDensity(double Altitude) const
 {
-    // Simplified atmospheric model
-    if (Altitude < 0.0f)
-    {
-        return 1.225f; // Sea level density
-    }
-    else if (Altitude < 11000.0f) // Troposphere
-    {
-        return 1.225f * FMath::Pow(1.0f - 0.0065f * Altitude / 288.15f, 4.256f);
-    }
-    else if (Altitude < 20000.0f) // Lower stratosphere
-    {
-        return 0.3639f * FMath::Exp(-(Altitude - 11000.0f) / 6341.62f);
-    }
-    else
-    {
-        return 0.088f * FMath::Exp(-(Altitude - 20000.0f) / 7400.0f);
-    }
+    // Baked per body by the gravity subsystem
+    return ParentAtmosphere.IsValid() ? ParentAtmosphere->GetDensity(Altitude) : 0.0;
 }
 
-void UOrbitalMechanics::UpdateOrbitalElementsFromThrust(const FVector& ThrustAcceleration)
+void UOrbitalMechanics::UpdateOrbitalElementsFromThrust()
 {
-    // Update orbital elements based on thrust direction and magnitude
-    // This is a simplified implementation
-    
-    FVector R = CurrentPosition;
-    FVector V = CurrentVelocity;
-    
-    // Calculate change in velocity
-    FVector DeltaV = ThrustAcceleration * TimeStep;
-    FVector NewVelocity = V + DeltaV;
-    
-    // Recalculate orbital elements
-    CurrentVelocity = NewVelocity;
+    // Thrust is already part of the integrated acceleration, so only the elements and prediction need refreshing
     CalculateOrbitalElements();
+    Trajectory.Invalidate();
+    InvalidateOrbitalEvents();
 }
 
 void UOrbitalMechanics::UpdateSpacecraftState()
 {
-    if (ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner()))
+    ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner());
+    if (!Spacecraft)
     {
-        // Update spacecraft position and velocity
-        Spacecraft->SetActorLocation(CurrentPosition);
-        Spacecraft->SetVelocity(CurrentVelocity);
-        
-        // Update spacecraft orientation based on velocity
-        if (CurrentVelocity.Size() > 0.0f)
+        return;
+    }
+    
+    // Actors live in the floating-origin frame
+    const FVector FrameOrigin = OwningSimulation ? OwningSimulation->GetFrameOrigin() : FVector::ZeroVector;
+    const FVector WorldPosition = GetSystemPosition() - FrameOrigin;
+    const bool bRebased = FrameOrigin != AppliedFrameOrigin;
+    AppliedFrameOrigin = FrameOrigin;
+    
+    if (Spacecraft->GetFlightModelMode() != EFlightModelMode::Orbital)
+    {
+        // Chaos or prediction owns the transform; only a rebase moves the body, and that one is a genuine teleport
+        if (bRebased)
         {
-            FVector Forward = CurrentVelocity.GetSafeNormal();
-            FVector Up = FVector::UpVector;
-            FVector Right = FVector::CrossProduct(Forward, Up).GetSafeNormal();
-            Up = FVector::CrossProduct(Right, Forward);
-            
-            FMatrix RotationMatrix = FMatrix(Right, Forward, Up, FVector::ZeroVector);
-            Spacecraft->SetActorRotation(RotationMatrix.Rotator());
+            Spacecraft->SetActorLocation(WorldPosition, false, nullptr, ETeleportType::TeleportPhysics);
         }
+        return;
     }
+    
+    // Single transform write per frame: position from the orbit, attitude from the pilot's accumulated input
+    const FQuat Rotation = Spacecraft->GetActorQuat() * Spacecraft->ConsumeRotationInput();
+    Spacecraft->SetActorLocationAndRotation(WorldPosition, Rotation, false, nullptr, bRebased ? ETeleportType::TeleportPhysics : ETeleportType::None);
+    Spacecraft->SetVelocity(GetSystemVelocity());
 }
 
-void UOrbitalMechanics::CheckOrbitalEvents()
+void UOrbitalMechanics::PredictOrbitalEvents(TArray<FOrbitalEventPrediction>& OutEvents)
 {
-    // Check for orbital events like periapsis, apoapsis, etc.
-    float CurrentRadius = CurrentPosition.Size();
+    const FKeplerOrbit Orbit = GetOsculatingOrbit();
     
-    // Check for periapsis (closest approach)
-    if (Eccentricity > 0.0f)
+    // Escape is a property of the whole conic: report it once, when the conic opens
+    const bool bEscaping = Orbit.bIsValid && !Orbit.IsElliptic();
+    if (bEscaping && !bEscapeReported)
     {
-        float PeriapsisDistance = SemiMajorAxis * (1.0f - Eccentricity);
-        if (FMath::Abs(CurrentRadius - PeriapsisDistance) < 1000.0f) // Within 1 km
-        {
-            OnPeriapsisReached.Broadcast();
-        }
+        OnEscapeVelocityReached.Broadcast();
+    }
+    bEscapeReported = bEscaping;
+    
+    if (const TOptional<double> PeriapsisTime = Orbit.GetNextPeriapsisTime(SimulationTime))
+    {
+        OutEvents.Add({ EOrbitalEventType::Periapsis, PeriapsisTime.GetValue() });
+    }
+    
+    if (const TOptional<double> ApoapsisTime = Orbit.GetNextApoapsisTime(SimulationTime))
+    {
+        OutEvents.Add({ EOrbitalEventType::Apoapsis, ApoapsisTime.GetValue() });
     }
     
-    // Check for apoapsis (farthest point)
-    if (Eccentricity > 0.0f)
+    if (ParentAtmosphere.IsValid())
     {
-        float ApoapsisDistance = SemiMajorAxis * (1.0f + Eccentricity);
-        if (FMath::Abs(CurrentRadius - ApoapsisDistance) < 1000.0f) // Within 1 km
+        const double EntryRadius = ParentRadius + ParentAtmosphere->EntryInterfaceAltitude;
+        if (const TOptional<double> EntryTime = Orbit.GetNextRadiusCrossingTime(EntryRadius, true, SimulationTime))
         {
-            OnApoapsisReached.Broadcast();
+            OutEvents.Add({ EOrbitalEventType::AtmosphericEntry, EntryTime.GetValue() });
         }
     }
-    
-    // Check for atmospheric entry
-    if (CurrentRadius < EarthRadius + 100000.0f) // Within 100 km
+}
+
+void UOrbitalMechanics::HandleOrbitalEvent(EOrbitalEventType Type)
+{
+    switch (Type)
     {
+    case EOrbitalEventType::Periapsis:
+        OnPeriapsisReached.Broadcast();
+        break;
+    case EOrbitalEventType::Apoapsis:
+        OnApoapsisReached.Broadcast();
+        break;
+    case EOrbitalEventType::AtmosphericEntry:
         OnAtmosphericEntry.Broadcast();
+        break;
+    }
+    
+    // Queue the next pass along the same conic
+    InvalidateOrbitalEvents();
+}
+
+void UOrbitalMechanics::UpdatePhysics(float DeltaTime)
+{
+    CELESTIAL_FLIGHT_SCOPE(OrbitalUpdatePhysics);
+    
+    double Step = TimeStep;
+    const int32 NumSteps = ConsumeFixedSteps(DeltaTime, Step);
+    if (NumSteps == 0)
+    {
+        return;
     }
     
-    // Check for escape velocity
-    float EscapeVelocity = FMath::Sqrt(2.0f * GravitationalConstant * EarthMass / CurrentRadius);
-    if (CurrentVelocity.Size() > EscapeVelocity)
+    auto Acceleration = [this](const FVector& Position, const FVector& Velocity)
     {
-        OnEscapeVelocityReached.Broadcast();
+        return EvaluateAcceleration(Position, Velocity);
+    };
+    
+    // Inputs may have changed since the last frame, so refresh the incoming acceleration once
+    CurrentAcceleration = Acceleration(CurrentPosition, CurrentVelocity);
+    
+    for (int32 i = 0; i < NumSteps; i++)
+    {
+        FOrbitalIntegrator::Step(Integrator, CurrentPosition, CurrentVelocity, CurrentAcceleration, Step, Acceleration);
     }
 }
 
-void UOrbitalMechanics::UpdatePhysics()
+int32 UOrbitalMechanics::ConsumeFixedSteps(float DeltaTime, double& OutStep)
 {
-    // Update physics simulation
-    float DeltaTime = TimeStep * TimeAcceleration;
-    
-    // Update velocity based on acceleration
-    CurrentVelocity += CurrentAcceleration * DeltaTime;
+    // Accumulate warped time and drain it in whole fixed steps
+    TimeAccumulator += DeltaTime * TimeAcceleration;
+    OutStep = TimeStep;
     
-    // Update position based on velocity
-    CurrentPosition += CurrentVelocity * DeltaTime;
+    int32 NumSteps = FMath::FloorToInt(TimeAccumulator / TimeStep);
+    if (NumSteps > MaxSubstepsPerFrame)
+    {
+        // Bounded cost: cover the whole frame with fewer, larger steps rather than falling behind
+        NumSteps = MaxSubstepsPerFrame;
+        OutStep = TimeAccumulator / NumSteps;
+        TimeAccumulator = 0.0;
+    }
+    else
+    {
+        TimeAccumulator -= NumSteps * TimeStep;
+    }
     
-    // Reset acceleration
-    CurrentAcceleration = FVector::ZeroVector;
+    SimulationTime += NumSteps * OutStep;
+    return NumSteps;
 }
 
 void UOrbitalMechanics::SetTimeAcceleration(float Acceleration)
 {
     TimeAcceleration = FMath::Clamp(Acceleration, 0.1f, 1000.0f);
     
-    // Update timer frequency based on time acceleration
-    GetWorld()->GetTimerManager().ClearTimer(PhysicsTimer);
-    GetWorld()->GetTimerManager().SetTimer(
-        PhysicsTimer,
-        this,
-        &UOrbitalMechanics::UpdatePhysics,
-        TimeStep / TimeAcceleration,
-        true
-    );
+    // Queued events are keyed by world time, which depends on the warp rate
+    InvalidateOrbitalEvents();
 }
 
 void UOrbitalMechanics::CalculateOrbitalTransfer(const FVector& TargetPosition, const FVector& TargetVelocity)
 {
     // Calculate Hohmann transfer orbit
-    float R1 = CurrentPosition.Size();
-    float R2 = TargetPosition.Size();
+    double R1 = CurrentPosition.Size();
+    double R2 = TargetPosition.Size();
     
     // Calculate transfer orbit parameters
-    float TransferSemiMajorAxis = (R1 + R2) / 2.0f;
-    float TransferEccentricity = (R2 - R1) / (R2 + R1);
+    double TransferSemiMajorAxis = (R1 + R2) / 2.0;
+    double TransferEccentricity = (R2 - R1) / (R2 + R1);
     
     // Calculate required delta-v for transfer
-    float V1 = FMath::Sqrt(GravitationalConstant * EarthMass / R1);
-    float V2 = FMath::Sqrt(GravitationalConstant * EarthMass * (2.0f / R1 - 1.0f / TransferSemiMajorAxis));
-    float DeltaV1 = V2 - V1;
+    double V1 = FMath::Sqrt(ParentMu / R1);
+    double V2 = FMath::Sqrt(ParentMu * (2.0 / R1 - 1.0 / TransferSemiMajorAxis));
+    double DeltaV1 = V2 - V1;
     
     // Calculate transfer time
-    float TransferTime = PI * FMath::Sqrt(TransferSemiMajorAxis * TransferSemiMajorAxis * TransferSemiMajorAxis / (GravitationalConstant * EarthMass));
+    double TransferTime = PI * FMath::Sqrt(TransferSemiMajorAxis * TransferSemiMajorAxis * TransferSemiMajorAxis / ParentMu);
     
     // Store transfer parameters
-    TransferOrbit = FTransferOrbit{
-        TransferSemiMajorAxis,
-        TransferEccentricity,
-        TransferTime,
-        DeltaV1
-    };
+    TransferOrbit = FTransferOrbit();
+    TransferOrbit.SemiMajorAxis = TransferSemiMajorAxis;
+    TransferOrbit.Eccentricity = TransferEccentricity;
+    TransferOrbit.TransferTime = TransferTime;
+    TransferOrbit.DeltaV = DeltaV1;
     
     OnTransferCalculated.Broadcast(TransferOrbit);
 }
 
+void UOrbitalMechanics::RequestTransfer(int32 TargetBodyIndex, double DepartureTime, double ArrivalTime)
+{
+    FTransferQuery Query;
+    Query.TargetBodyIndex = TargetBodyIndex;
+    Query.DepartureTime = DepartureTime;
+    Query.ArrivalTime = ArrivalTime;
+    
+    TWeakObjectPtr<UOrbitalMechanics> WeakThis(this);
+    PlanTransfersAsync({ Query }).Next([WeakThis](TArray<FTransferOrbit> Results)
+    {
+        // Hop back to the game thread before touching the component
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Results = MoveTemp(Results)]()
+        {
+            UOrbitalMechanics* This = WeakThis.Get();
+            if (This && Results.Num() > 0)
+            {
+                This->TransferOrbit = Results[0];
+                This->OnTransferCalculated.Broadcast(This->TransferOrbit);
+            }
+        });
+    });
+}
+
+TFuture<TArray<FTransferOrbit>> UOrbitalMechanics::PlanTransfersAsync(const TArray<FTransferQuery>& Queries) const
+{
+    // Capture everything on the game thread; the task never sees this component
+    FTransferPlanningContext Context;
+    Context.ShipOrbit = GetOsculatingOrbit();
+    Context.ShipParentBodyIndex = ParentBodyIndex;
+    
+    if (const UOrbitalGravitySubsystem* Gravity = GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>())
+    {
+        const int32 NumBodies = Gravity->GetNumBodies();
+        if (NumBodies > 0)
+        {
+            Context.BodyMu.SetNumUninitialized(NumBodies);
+            Context.BodyPrimaryIndex.SetNumUninitialized(NumBodies);
+            for (int32 i = 0; i < NumBodies; i++)
+            {
+                Context.BodyMu[i] = Gravity->GetBodyMu(i);
+                Context.BodyPrimaryIndex[i] = Gravity->GetBodyPrimaryIndex(i);
+            }
+            Context.Ephemerides = Gravity->GetEphemerides();
+        }
+    }
+    
+    return Async(EAsyncExecution::ThreadPool, [Context = MoveTemp(Context), Queries]()
+    {
+        return FOrbitalTransferPlanner::PlanBatch(Context, Queries);
+    });
+}
+
 FVector UOrbitalMechanics::GetOrbitalVelocity() const
 {
     return CurrentVelocity;
@@ -581,27 +1025,23 @@ FVector UOrbitalMechanics::GetOrbitalPosition() const
     return CurrentPosition;
 }
 
-float UOrbitalMechanics::GetOrbitalAltitude() const
+double UOrbitalMechanics::GetOrbitalAltitude() const
 {
-    return CurrentPosition.Size() - EarthRadius;
+    return CurrentPosition.Size() - ParentRadius;
 }
 
-float UOrbitalMechanics::GetOrbitalPeriod() const
+double UOrbitalMechanics::GetOrbitalPeriod() const
 {
-    if (SemiMajorAxis > 0.0f)
+    if (SemiMajorAxis > 0.0)
     {
-        return 2.0f * PI * FMath::Sqrt(SemiMajorAxis * SemiMajorAxis * SemiMajorAxis / (GravitationalConstant * EarthMass));
+        return 2.0 * PI * FMath::Sqrt(SemiMajorAxis * SemiMajorAxis * SemiMajorAxis / ParentMu);
     }
-    return 0.0f;
+    return 0.0;
 }
 
 void UOrbitalMechanics::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     
-    DOREPLIFETIME(UOrbitalMechanics, CurrentPosition);
-    DOREPLIFETIME(UOrbitalMechanics, CurrentVelocity);
-    DOREPLIFETIME(UOrbitalMechanics, SemiMajorAxis);
-    DOREPLIFETIME(UOrbitalMechanics, Eccentricity);
-    DOREPLIFETIME(UOrbitalMechanics, Inclination);
+    DOREPLIFETIME(UOrbitalMechanics, ReplicatedOrbit);
 } 
\ No newline at end of file
@@ -13,10 +13,19 @@
 #include "Components/ActorComponent.h"
 #include "Engine/DataTable.h"
 #include "Engine/Engine.h"
+#include "Async/Future.h"
+#include "OrbitalIntegrator.h"
+#include "KeplerOrbit.h"
+#include "OrbitalTrajectory.h"
+#include "OrbitalEvents.h"
+#include "ReplicatedOrbit.h"
+#include "CelestialAtmosphere.h"
 #include "OrbitalMechanics.generated.h"
 
 // Forward declarations
 class ASpacecraft;
+class UOrbitalSimulationSubsystem;
+class UOrbitalGravitySubsystem;
 
 // Celestial body structure
 USTRUCT(BlueprintType)
@@ -34,22 +43,32 @@ struct FCelestialBody
     FVector Velocity;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Mass;
+    double Mass;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Radius;
+    double Radius;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FLinearColor Color;
 
+    // Optional; bodies without one have no drag and no atmospheric entry
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UCelestialAtmosphere* Atmosphere;
+
+    // Body this one orbits; must come earlier in the set. Unused by the first body
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 ParentIndex;
+
     FCelestialBody()
     {
         Name = TEXT("Unknown");
         Position = FVector::ZeroVector;
         Velocity = FVector::ZeroVector;
-        Mass = 0.0f;
-        Radius = 0.0f;
+        Mass = 0.0;
+        Radius = 0.0;
         Color = FLinearColor::White;
+        Atmosphere = nullptr;
+        ParentIndex = 0;
     }
 };
 
@@ -60,32 +79,86 @@ struct FTransferOrbit
     GENERATED_BODY()
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float SemiMajorAxis;
+    double SemiMajorAxis;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    double Eccentricity;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    double TransferTime;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    double DeltaV;
 
+    // Lambert plans only: when to burn and the burn vector in the system frame
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Eccentricity;
+    double DepartureTime;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float TransferTime;
+    FVector DepartureBurn;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float DeltaV;
+    bool bIsValid;
 
     FTransferOrbit()
     {
-        SemiMajorAxis = 0.0f;
-        Eccentricity = 0.0f;
-        TransferTime = 0.0f;
-        DeltaV = 0.0f;
+        SemiMajorAxis = 0.0;
+        Eccentricity = 0.0;
+        TransferTime = 0.0;
+        DeltaV = 0.0;
+        DepartureTime = 0.0;
+        DepartureBurn = FVector::ZeroVector;
+        bIsValid = false;
+    }
+};
+
+// One departure/arrival window to evaluate against a celestial body
+USTRUCT(BlueprintType)
+struct FTransferQuery
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 TargetBodyIndex;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    double DepartureTime;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    double ArrivalTime;
+
+    FTransferQuery()
+    {
+        TargetBodyIndex = 0;
+        DepartureTime = 0.0;
+        ArrivalTime = 0.0;
     }
 };
 
+// How a ship's state is advanced each frame
+UENUM(BlueprintType)
+enum class EOrbitalPropagationMode : uint8
+{
+    Numeric  UMETA(DisplayName = "Numeric Integration"),
+    OnRails  UMETA(DisplayName = "On Rails (Keplerian)")
+};
+
+// Tick LOD bucket, from distance and visibility to the nearest player
+UENUM(BlueprintType)
+enum class EOrbitalSignificance : uint8
+{
+    Near     UMETA(DisplayName = "Near (Every Frame)"),
+    Distant  UMETA(DisplayName = "Distant (Reduced Rate)"),
+    Dormant  UMETA(DisplayName = "Dormant (Minimal Rate)")
+};
+
 // Orbital events delegate declarations
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPeriapsisReached);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnApoapsisReached);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnAtmosphericEntry);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEscapeVelocityReached);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTransferCalculated, FTransferOrbit);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSphereOfInfluenceChanged, int32, NewParentBodyIndex);
 
 // Main orbital mechanics component
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -98,58 +171,90 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
     // Physics Constants
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Physics")
-    float GravitationalConstant;
+    double GravitationalConstant;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Physics")
-    float EarthMass;
+    double EarthMass;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Physics")
-    float EarthRadius;
+    double EarthRadius;
 
     // Orbital Elements
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float SemiMajorAxis;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double SemiMajorAxis;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float Eccentricity;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double Eccentricity;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float Inclination;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double Inclination;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float ArgumentOfPeriapsis;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double ArgumentOfPeriapsis;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float LongitudeOfAscendingNode;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double LongitudeOfAscendingNode;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements", Replicated)
-    float TrueAnomaly;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Elements")
+    double TrueAnomaly;
 
-    // Current State
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|State", Replicated)
+    // Current State, relative to the parent body
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|State")
     FVector CurrentPosition;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|State", Replicated)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|State")
     FVector CurrentVelocity;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|State")
     FVector CurrentAcceleration;
 
+    // Index of the body whose sphere of influence contains the ship
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Orbital|State")
+    int32 ParentBodyIndex;
+
     // Time Management
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Time")
-    float SimulationTime;
+    double SimulationTime;
 
+    // Fixed integration step in simulated seconds
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Time")
-    float TimeStep;
+    double TimeStep;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Time")
     float TimeAcceleration;
 
+    // Upper bound on substeps per frame; at high warp the step grows instead of the step count
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Time", meta = (ClampMin = "1"))
+    int32 MaxSubstepsPerFrame;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Time")
+    EOrbitalIntegrator Integrator;
+
+    // Networking: clients propagate the last conic the server sent instead of receiving per-frame state
+    UPROPERTY(ReplicatedUsing = OnRep_ReplicatedOrbit)
+    FReplicatedOrbit ReplicatedOrbit;
+
+    // Minimum world seconds between updates while the conic changes continuously under thrust or drag
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Networking", meta = (ClampMin = "0"))
+    float ReplicatedOrbitInterval;
+
+    // Propagation
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Propagation")
+    bool bAllowOnRails;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Orbital|Propagation")
+    EOrbitalPropagationMode PropagationMode;
+
+    // Assigned by UOrbitalSimulationSubsystem; less significant ships are simulated less often and catch up in one step
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Orbital|Propagation")
+    EOrbitalSignificance Significance;
+
     // Celestial Bodies
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Orbital|Bodies")
     TArray<FCelestialBody> CelestialBodies;
@@ -174,6 +279,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Orbital|Events")
     FOnTransferCalculated OnTransferCalculated;
 
+    UPROPERTY(BlueprintAssignable, Category = "Orbital|Events")
+    FOnSphereOfInfluenceChanged OnSphereOfInfluenceChanged;
+
     // Public Functions
     UFUNCTION(BlueprintCallable, Category = "Orbital|Physics")
     void CalculateOrbitalElements();
@@ -187,6 +295,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Orbital|Physics")
     void CalculateOrbitalTransfer(const FVector& TargetPosition, const FVector& TargetVelocity);
 
+    // Lambert transfer to a body for one window; solved in the background, then broadcast through OnTransferCalculated
+    UFUNCTION(BlueprintCallable, Category = "Orbital|Transfer")
+    void RequestTransfer(int32 TargetBodyIndex, double DepartureTime, double ArrivalTime);
+
+    // Batched Lambert planning (porkchop grids); results arrive in query order on a worker thread
+    TFuture<TArray<FTransferOrbit>> PlanTransfersAsync(const TArray<FTransferQuery>& Queries) const;
+
     UFUNCTION(BlueprintCallable, Category = "Orbital|Time")
     void SetTimeAcceleration(float Acceleration);
 
@@ -197,10 +312,27 @@ public:
     FVector GetOrbitalPosition() const;
 
     UFUNCTION(BlueprintPure, Category = "Orbital|State")
-    float GetOrbitalAltitude() const;
+    double GetOrbitalAltitude() const;
 
     UFUNCTION(BlueprintPure, Category = "Orbital|State")
-    float GetOrbitalPeriod() const;
+    double GetOrbitalPeriod() const;
+
+    // Two-body state at an arbitrary simulation time; O(1) regardless of how far ahead
+    UFUNCTION(BlueprintCallable, Category = "Orbital|Propagation")
+    void GetStateAtTime(double Time, FVector& OutPosition, FVector& OutVelocity) const;
+
+    UFUNCTION(BlueprintPure, Category = "Orbital|Propagation")
+    bool IsOnRails() const { return PropagationMode == EOrbitalPropagationMode::OnRails; }
+
+    // State in the system frame, centred on the primary body
+    UFUNCTION(BlueprintPure, Category = "Orbital|State")
+    FVector GetSystemPosition() const { return ParentPosition + CurrentPosition; }
+
+    UFUNCTION(BlueprintPure, Category = "Orbital|State")
+    FVector GetSystemVelocity() const { return ParentVelocity + CurrentVelocity; }
+
+    // Latest predicted path. Game thread only; the returned handle may then be read from any thread
+    FOrbitalTrajectorySnapshotPtr GetTrajectory() const { return Trajectory.GetSnapshot(); }
 
 protected:
     // Internal helper functions
@@ -210,18 +342,114 @@ protected:
     void UpdateEllipticalOrbit(float DeltaTime);
     void UpdateHyperbolicOrbit(float DeltaTime);
     void UpdateParabolicOrbit(float DeltaTime);
-    float SolveKeplersEquation(float MeanAnomaly, float Eccentricity);
-    FVector TransformOrbitalToWorld(const FVector& OrbitalVector);
-    void ApplyThrustForces();
-    void ApplyAtmosphericDrag();
-    float CalculateAtmosphericDensity(float Altitude);
-    void UpdateOrbitalElementsFromThrust(const FVector& ThrustAcceleration);
+    void AdvanceAlongConic(float DeltaTime);
+    FVector EvaluateAcceleration(const FVector& Position, const FVector& Velocity) const;
+    FVector CalculateDragAcceleration(const FVector& Position, const FVector& Velocity) const;
+    double CalculateAtmosphericDensity(double Altitude) const;
+    void UpdateOrbitalElementsFromThrust();
     void UpdateSpacecraftState();
-    void CheckOrbitalEvents();
-    void UpdatePhysics();
+    void UpdatePhysics(float DeltaTime);
+    int32 ConsumeFixedSteps(float DeltaTime, double& OutStep);
+
+    // On-rails propagation
+    bool CanEnterOnRails() const;
+    bool ShouldLeaveOnRails() const;
+    void EnterOnRails();
+    void LeaveOnRails();
+    void PropagateOnRails(float DeltaTime);
+    void UpdateRailsAcceleration();
+
+    // Orbit captured when the ship went on rails
+    FKeplerOrbit RailsOrbit;
+
+    // Unsimulated time carried between frames by the fixed-step accumulator
+    double TimeAccumulator;
+
+    // World simulation entry points, driven by UOrbitalSimulationSubsystem
+    friend class UOrbitalSimulationSubsystem;
+    void GatherSimulationInputs();
+    void SimulateOrbit(float DeltaTime, const UOrbitalGravitySubsystem* Gravity);
+    void ApplySimulationResults();
+
+    // Batched on-rails path: the subsystem solves Kepler's equation for a whole chunk between these calls
+    bool PrepareBatchedRailsStep(float DeltaTime, double& OutMeanAnomaly, double& OutEccentricity);
+    void FinishBatchedRailsStep(double EccentricAnomaly, const UOrbitalGravitySubsystem* Gravity);
+
+    int32 SimulationSlot;
+    FVector PendingThrustAcceleration;
+
+    // Real time since this ship was last simulated, and whether it was this frame
+    float UnsimulatedTime;
+    bool bSimulatedThisFrame;
+
+    // Ballistic drag factor Cd·A/m (m²/kg), sampled from the spacecraft with the thrust
+    double PendingDragFactor;
+
+    // Chaos and predicted flight modes: another model moves the ship and this component only tracks it
+    void FollowRigidBody(float DeltaTime, const UOrbitalGravitySubsystem* Gravity);
+    bool bFollowRigidBody;
+    FVector RigidBodySystemPosition;
+    FVector RigidBodySystemVelocity;
+
+    // Conic the trajectory and events were last built from while following or under drag; its epoch is the rebuild time
+    FKeplerOrbit FollowedOrbit;
+
+    // Rebuilds FollowedOrbit and invalidates the trajectory and events once the state has drifted off it; true when it did
+    bool RefollowOrbitOnDrift();
+
+    // Frame origin at the last transform write, so a rebase can move a ship another model drives
+    FVector AppliedFrameOrigin;
+
+    // Simulation that owns this component's frame origin; null on the standalone tick path
+    UOrbitalSimulationSubsystem* OwningSimulation;
+
+    // Patched conics: CurrentPosition and CurrentVelocity are relative to the parent body
+    void SetParentBody(int32 BodyIndex, const UOrbitalGravitySubsystem* Gravity);
+    void UpdateParentBody(const UOrbitalGravitySubsystem* Gravity);
+
+    double ParentMu;
+    double ParentRadius;
+    FAtmosphereDensityTablePtr ParentAtmosphere;
+
+    // Radius below which drag applies; the parent radius when it has no atmosphere
+    double GetAtmosphereCeilingRadius() const { return ParentRadius + (ParentAtmosphere.IsValid() ? ParentAtmosphere->CeilingAltitude : 0.0); }
+
+    // Parent body state in the system frame at SimulationTime
+    FVector ParentPosition;
+    FVector ParentVelocity;
+
+    // Set on a worker thread, broadcast from ApplySimulationResults
+    bool bParentBodyChanged;
+
+    // Future path for UI and AI, rebuilt only when the conic changes
+    void UpdateTrajectory(const UOrbitalGravitySubsystem* Gravity);
+    FOrbitalTrajectoryCache Trajectory;
+
+    // Two-body conic of the current state, exact on rails and osculating otherwise
+    FKeplerOrbit GetOsculatingOrbit() const;
+
+    // Analytic events, queued by UOrbitalSimulationSubsystem whenever the conic changes
+    void InvalidateOrbitalEvents() { bEventsDirty = true; }
+    void PredictOrbitalEvents(TArray<FOrbitalEventPrediction>& OutEvents);
+    void HandleOrbitalEvent(EOrbitalEventType Type);
+
+    bool bEventsDirty;
+    bool bEscapeReported;
+
+    // Bumped on every reschedule so queued events from an older conic are discarded
+    uint32 EventGeneration;
+    int32 NumQueuedEvents;
+
+    // Replicated conic: the server publishes it, clients follow it on rails
+    UFUNCTION()
+    void OnRep_ReplicatedOrbit();
+    void UpdateReplicatedOrbit();
+    void PropagateReplicatedOrbit(float DeltaTime, const UOrbitalGravitySubsystem* Gravity);
+    bool FollowsReplicatedOrbit() const { return GetOwnerRole() < ROLE_Authority; }
 
-    // Timers
-    FTimerHandle PhysicsTimer;
+    // Set whenever the conic changes discretely (SOI change, going on rails); flushed on the game thread
+    bool bReplicatedOrbitDirty;
+    double LastReplicatedOrbitTime;
 
     // Networking
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -0,0 +1,470 @@
+// OrbitalSimulationSubsystem.cpp
+// World Orbital Simulation Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements the gather/simulate/apply pipeline for all orbital components
+// Feature Context: Integrates every registered spacecraft in parallel and writes results back in one batch
+// Dependencies: Unreal Engine world subsystems, ParallelFor, OrbitalMechanics, OrbitalGravitySubsystem
+// Usage Example: Ticked by the world once per frame after actor ticks
+// Security: Actor reads and writes stay on the game thread; workers only run component-local math
+// Performance: Ships are processed in fixed-size chunks to amortise task overhead across workers
+
+#include "OrbitalSimulationSubsystem.h"
+#include "FlightProfiling.h"
+#include "OrbitalGravitySubsystem.h"
+#include "OrbitalMechanics.h"
+#include "Spacecraft.h"
+#include "KeplerOrbit.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CELESTIAL_FLIGHT_COUNTER(Ships);
+DECLARE_CELESTIAL_FLIGHT_COUNTER(ShipsSimulated);
+DECLARE_CELESTIAL_FLIGHT_COUNTER(ShipsOnRails);
+DECLARE_CELESTIAL_FLIGHT_COUNTER(ShipsNumeric);
+DECLARE_CELESTIAL_FLIGHT_COUNTER(KeplerIterations);
+
+UOrbitalSimulationSubsystem::UOrbitalSimulationSubsystem()
+{
+    FrameOrigin = FVector::ZeroVector;
+    RebaseDistance = 20000.0; // m
+    bFrameRebased = false;
+    NumStaleEvents = 0;
+
+    // Tick LOD
+    NearDistance = 200000.0; // 200 km
+    DistantDistance = 50000000.0; // 50,000 km
+    DistantInterval = 0.25f; // s
+    DormantInterval = 2.0f; // s
+    SignificanceUpdateInterval = 0.5f; // s
+    SignificanceTimer = 0.0f;
+}
+
+void UOrbitalSimulationSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_FLIGHT_SCOPE(OrbitalSimulation);
+
+    if (Ships.Num() == 0)
+    {
+        return;
+    }
+
+    CompactStaleShips();
+
+    // Game thread: bucket ships by distance and visibility to players
+    UpdateSignificance(DeltaTime);
+
+    // Game thread: read actor-side inputs (thrust) from every ship that is due this frame
+    GatherInputs(DeltaTime);
+
+    // Worker threads: fixed-step integration of gravity, thrust and drag for the due ships
+    SimulateChunks();
+
+    // Game thread: keep the focus ship near the world origin before positions are written out
+    UpdateFrameOrigin();
+
+    // Game thread: one batched pass of actor transform writes and event broadcasts
+    ApplyResults();
+
+    // Game thread: re-predict events for ships whose conic changed, then fire whatever is due
+    ScheduleOrbitalEvents();
+    DispatchOrbitalEvents();
+
+    PublishCounters();
+}
+
+TStatId UOrbitalSimulationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UOrbitalSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UOrbitalSimulationSubsystem::RegisterShip(UOrbitalMechanics* Component)
+{
+    if (!Component || Component->SimulationSlot != INDEX_NONE)
+    {
+        return;
+    }
+
+    Component->SimulationSlot = Ships.Add(Component);
+    Component->OwningSimulation = this;
+
+    // The subsystem drives this component from now on
+    Component->SetComponentTickEnabled(false);
+}
+
+void UOrbitalSimulationSubsystem::UnregisterShip(UOrbitalMechanics* Component)
+{
+    if (!Component || !Ships.IsValidIndex(Component->SimulationSlot))
+    {
+        return;
+    }
+
+    // Swap-remove keeps the ship list dense; the moved ship takes over the freed slot
+    RetireOrbitalEvents(Component);
+
+    const int32 Slot = Component->SimulationSlot;
+    Ships.RemoveAtSwap(Slot);
+
+    if (Ships.IsValidIndex(Slot))
+    {
+        if (UOrbitalMechanics* Moved = Ships[Slot].Get())
+        {
+            Moved->SimulationSlot = Slot;
+        }
+    }
+
+    Component->SimulationSlot = INDEX_NONE;
+    Component->OwningSimulation = nullptr;
+}
+
+void UOrbitalSimulationSubsystem::UpdateSignificance(float DeltaTime)
+{
+    SignificanceTimer -= DeltaTime;
+    if (SignificanceTimer > 0.0f)
+    {
+        return;
+    }
+    SignificanceTimer = SignificanceUpdateInterval;
+
+    // Every player's view, in the orbital frame; servers with no players leave every ship dormant
+    TArray<FVector, TInlineAllocator<8>> ViewLocations;
+    TArray<FVector, TInlineAllocator<8>> ViewDirections;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PlayerController = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ViewLocations.Add(WorldToOrbital(ViewLocation));
+            ViewDirections.Add(ViewRotation.Vector());
+        }
+    }
+
+    const double ViewConeCos = 0.5; // 60° half-angle
+    const UOrbitalMechanics* Focus = FocusShip.Get();
+
+    for (const TWeakObjectPtr<UOrbitalMechanics>& Ship : Ships)
+    {
+        UOrbitalMechanics* Component = Ship.Get();
+        const FVector ShipPosition = Component->GetSystemPosition();
+
+        double NearestDistanceSquared = BIG_NUMBER;
+        bool bInView = false;
+        for (int32 i = 0; i < ViewLocations.Num(); i++)
+        {
+            const FVector ToShip = ShipPosition - ViewLocations[i];
+            const double DistanceSquared = ToShip.SizeSquared();
+            NearestDistanceSquared = FMath::Min(NearestDistanceSquared, DistanceSquared);
+            bInView |= FVector::DotProduct(ToShip, ViewDirections[i]) >= ViewConeCos * FMath::Sqrt(DistanceSquared);
+        }
+
+        EOrbitalSignificance NewSignificance = EOrbitalSignificance::Dormant;
+        if (Component == Focus || NearestDistanceSquared < FMath::Square(NearDistance))
+        {
+            NewSignificance = EOrbitalSignificance::Near;
+        }
+        else if (NearestDistanceSquared < FMath::Square(DistantDistance))
+        {
+            // Out of every view, a mid-range ship can wait as long as a far one
+            NewSignificance = bInView ? EOrbitalSignificance::Distant : EOrbitalSignificance::Dormant;
+        }
+
+        SetShipSignificance(Component, NewSignificance);
+    }
+}
+
+float UOrbitalSimulationSubsystem::GetSimulationInterval(EOrbitalSignificance InSignificance) const
+{
+    switch (InSignificance)
+    {
+    case EOrbitalSignificance::Distant:
+        return DistantInterval;
+    case EOrbitalSignificance::Dormant:
+        return DormantInterval;
+    default:
+        return 0.0f;
+    }
+}
+
+void UOrbitalSimulationSubsystem::SetShipSignificance(UOrbitalMechanics* Component, EOrbitalSignificance NewSignificance)
+{
+    if (Component->Significance == NewSignificance)
+    {
+        return;
+    }
+
+    // Promotion takes effect immediately: the next gather sees a zero interval and catches the ship up in one step
+    Component->Significance = NewSignificance;
+
+    if (AActor* Owner = Component->GetOwner())
+    {
+        Owner->SetActorTickInterval(GetSimulationInterval(NewSignificance));
+
+        // Nobody is close enough to see proximity physics, so distant ships cruise on the orbital model
+        ASpacecraft* Spacecraft = Cast<ASpacecraft>(Owner);
+        if (Spacecraft && NewSignificance != EOrbitalSignificance::Near && Spacecraft->GetFlightModelMode() == EFlightModelMode::Chaos)
+        {
+            Spacecraft->SetFlightModelMode(EFlightModelMode::Orbital);
+        }
+    }
+}
+
+void UOrbitalSimulationSubsystem::GatherInputs(float DeltaTime)
+{
+    FrameShips.Reset(Ships.Num());
+    FrameDeltaTimes.Reset(Ships.Num());
+    for (const TWeakObjectPtr<UOrbitalMechanics>& Ship : Ships)
+    {
+        UOrbitalMechanics* Component = Ship.Get();
+        Component->UnsimulatedTime += DeltaTime;
+        Component->bSimulatedThisFrame = Component->UnsimulatedTime >= GetSimulationInterval(Component->Significance);
+        if (!Component->bSimulatedThisFrame)
+        {
+            continue;
+        }
+
+        Component->GatherSimulationInputs();
+        FrameShips.Add(Component);
+        FrameDeltaTimes.Add(Component->UnsimulatedTime);
+        Component->UnsimulatedTime = 0.0f;
+    }
+}
+
+void UOrbitalSimulationSubsystem::SimulateChunks()
+{
+    CELESTIAL_FLIGHT_SCOPE(OrbitalIntegration);
+
+    const UOrbitalGravitySubsystem* Gravity = GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>();
+    const int32 NumShips = FrameShips.Num();
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumShips, ShipsPerChunk);
+    ChunkKeplerIterations.SetNumUninitialized(NumChunks);
+
+    ParallelFor(NumChunks, [this, Gravity, NumShips](int32 ChunkIndex)
+    {
+        const int32 First = ChunkIndex * ShipsPerChunk;
+        const int32 Last = FMath::Min(First + ShipsPerChunk, NumShips);
+
+        // Elliptic coasters are collected for one SIMD Kepler solve; the rest integrate individually
+        double MeanAnomaly[ShipsPerChunk];
+        double Eccentricity[ShipsPerChunk];
+        double EccentricAnomaly[ShipsPerChunk];
+        int32 RailsShips[ShipsPerChunk];
+        int32 NumRails = 0;
+
+        for (int32 i = First; i < Last; i++)
+        {
+            if (FrameShips[i]->PrepareBatchedRailsStep(FrameDeltaTimes[i], MeanAnomaly[NumRails], Eccentricity[NumRails]))
+            {
+                RailsShips[NumRails++] = i;
+            }
+            else
+            {
+                FrameShips[i]->SimulateOrbit(FrameDeltaTimes[i], Gravity);
+            }
+        }
+
+        FKeplerOrbit::SolveEccentricAnomalyBatch(MeanAnomaly, Eccentricity, EccentricAnomaly, NumRails);
+        for (int32 k = 0; k < NumRails; k++)
+        {
+            FrameShips[RailsShips[k]]->FinishBatchedRailsStep(EccentricAnomaly[k], Gravity);
+        }
+
+        ChunkKeplerIterations[ChunkIndex] = FKeplerOrbit::ConsumeIterationCount();
+    });
+}
+
+void UOrbitalSimulationSubsystem::SetFrameOrigin(const FVector& NewOrigin)
+{
+    const FVector OriginShift = NewOrigin - FrameOrigin;
+    if (OriginShift.IsZero())
+    {
+        return;
+    }
+
+    // Registered ships pick up the new origin in ApplyResults; everything else is told via the delegate
+    FrameOrigin = NewOrigin;
+    bFrameRebased = true;
+    OnFrameRebased.Broadcast(OriginShift);
+}
+
+void UOrbitalSimulationSubsystem::UpdateFrameOrigin()
+{
+    // Servers keep world state absolute: there is no single view to follow, and a shift would move every
+    // replicated actor and physics body, not just registered ships. Only clients and standalone games rebase
+    const ENetMode NetMode = GetWorld()->GetNetMode();
+    if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+    {
+        return;
+    }
+
+    const UOrbitalMechanics* Focus = FocusShip.Get();
+    if (!Focus)
+    {
+        if (const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+        {
+            if (const APawn* Pawn = PlayerController->GetPawn())
+            {
+                Focus = Pawn->FindComponentByClass<UOrbitalMechanics>();
+            }
+        }
+    }
+
+    if (!Focus)
+    {
+        return;
+    }
+
+    // Rebase in whole jumps so world-space coordinates near the camera stay small
+    if (FVector::DistSquared(Focus->GetSystemPosition(), FrameOrigin) > FMath::Square(RebaseDistance))
+    {
+        SetFrameOrigin(Focus->GetSystemPosition());
+    }
+}
+
+void UOrbitalSimulationSubsystem::ApplyResults()
+{
+    CELESTIAL_FLIGHT_SCOPE(OrbitalApplyResults);
+
+    for (UOrbitalMechanics* Component : FrameShips)
+    {
+        Component->ApplySimulationResults();
+    }
+
+    // Ships that were not simulated keep their transforms, unless the frame moved under them
+    if (bFrameRebased)
+    {
+        bFrameRebased = false;
+        for (const TWeakObjectPtr<UOrbitalMechanics>& Ship : Ships)
+        {
+            if (!Ship->bSimulatedThisFrame)
+            {
+                Ship->UpdateSpacecraftState();
+            }
+        }
+    }
+}
+
+void UOrbitalSimulationSubsystem::PublishCounters()
+{
+    int32 NumOnRails = 0;
+    for (const TWeakObjectPtr<UOrbitalMechanics>& Ship : Ships)
+    {
+        NumOnRails += Ship.IsValid() && Ship->IsOnRails() ? 1 : 0;
+    }
+
+    // Game-thread solves, such as event prediction, are still on this thread's count
+    uint32 KeplerIterations = FKeplerOrbit::ConsumeIterationCount();
+    for (const uint32 ChunkIterations : ChunkKeplerIterations)
+    {
+        KeplerIterations += ChunkIterations;
+    }
+    ChunkKeplerIterations.Reset();
+
+    SET_CELESTIAL_FLIGHT_COUNTER(Ships, Ships.Num());
+    SET_CELESTIAL_FLIGHT_COUNTER(ShipsSimulated, FrameShips.Num());
+    SET_CELESTIAL_FLIGHT_COUNTER(ShipsOnRails, NumOnRails);
+    SET_CELESTIAL_FLIGHT_COUNTER(ShipsNumeric, Ships.Num() - NumOnRails);
+    SET_CELESTIAL_FLIGHT_COUNTER(KeplerIterations, KeplerIterations);
+}
+
+void UOrbitalSimulationSubsystem::ScheduleOrbitalEvents()
+{
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    TArray<FOrbitalEventPrediction> Predictions;
+
+    for (UOrbitalMechanics* Component : FrameShips)
+    {
+        if (!Component->bEventsDirty)
+        {
+            continue;
+        }
+
+        RetireOrbitalEvents(Component);
+        Component->bEventsDirty = false;
+
+        Predictions.Reset();
+        Component->PredictOrbitalEvents(Predictions);
+
+        // Map ship time to world time through the ship's warp rate
+        for (const FOrbitalEventPrediction& Prediction : Predictions)
+        {
+            FScheduledOrbitalEvent Event;
+            Event.WorldTime = WorldTime + (Prediction.SimulationTime - Component->SimulationTime) / Component->TimeAcceleration;
+            Event.SimulationTime = Prediction.SimulationTime;
+            Event.Ship = Component;
+            Event.Generation = Component->EventGeneration;
+            Event.Type = Prediction.Type;
+            EventQueue.HeapPush(Event);
+        }
+        Component->NumQueuedEvents = Predictions.Num();
+    }
+
+    if (NumStaleEvents > 64 && NumStaleEvents > EventQueue.Num() / 2)
+    {
+        CompactEventQueue();
+    }
+}
+
+void UOrbitalSimulationSubsystem::DispatchOrbitalEvents()
+{
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+
+    // Nothing is touched between events; the loop exits on the first entry still in the future
+    while (EventQueue.Num() > 0 && EventQueue.HeapTop().WorldTime <= WorldTime)
+    {
+        FScheduledOrbitalEvent Event;
+        EventQueue.HeapPop(Event, false);
+
+        UOrbitalMechanics* Component = Event.Ship.Get();
+        if (!Component || Component->EventGeneration != Event.Generation)
+        {
+            NumStaleEvents = FMath::Max(NumStaleEvents - 1, 0);
+            continue;
+        }
+
+        // Capped substeps can leave the ship's clock behind the estimate; wait for it to catch up
+        if (Component->SimulationTime < Event.SimulationTime)
+        {
+            const double Remaining = (Event.SimulationTime - Component->SimulationTime) / Component->TimeAcceleration;
+            Event.WorldTime = WorldTime + FMath::Max(Remaining, KINDA_SMALL_NUMBER);
+            EventQueue.HeapPush(Event);
+            continue;
+        }
+
+        Component->NumQueuedEvents--;
+        Component->HandleOrbitalEvent(Event.Type);
+    }
+}
+
+void UOrbitalSimulationSubsystem::RetireOrbitalEvents(UOrbitalMechanics* Component)
+{
+    Component->EventGeneration++;
+    NumStaleEvents += Component->NumQueuedEvents;
+    Component->NumQueuedEvents = 0;
+}
+
+void UOrbitalSimulationSubsystem::CompactEventQueue()
+{
+    EventQueue.RemoveAllSwap([](const FScheduledOrbitalEvent& Event)
+    {
+        const UOrbitalMechanics* Component = Event.Ship.Get();
+        return !Component || Component->EventGeneration != Event.Generation;
+    });
+    EventQueue.Heapify();
+    NumStaleEvents = 0;
+}
+
+void UOrbitalSimulationSubsystem::CompactStaleShips()
+{
+    for (int32 i = Ships.Num() - 1; i >= 0; i--)
+    {
+        if (!Ships[i].IsValid())
+        {
+            Ships.RemoveAtSwap(i);
+            if (Ships.IsValidIndex(i) && Ships[i].IsValid())
+            {
+                Ships[i]->SimulationSlot = i;
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+// OrbitalSimulationSubsystem.h
+// World Orbital Simulation Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level scheduler that advances every registered orbital component
+// Feature Context: Moves orbital propagation off per-component game-thread ticks onto parallel worker chunks
+// Dependencies: Unreal Engine world subsystems, ParallelFor, OrbitalMechanics, OrbitalGravitySubsystem
+// Usage Example: UOrbitalMechanics registers in BeginPlay; the subsystem ticks all ships once per frame
+// Security: Worker chunks only touch the state of the ships they own; actors are written on the game thread
+// Performance: Gather, simulate and apply are split so the expensive middle stage scales across cores
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OrbitalEvents.h"
+#include "OrbitalSimulationSubsystem.generated.h"
+
+// Forward declarations
+class UOrbitalMechanics;
+enum class EOrbitalSignificance : uint8;
+
+// Queued orbital event, keyed by the world time at which the ship's clock reaches it
+struct FScheduledOrbitalEvent
+{
+    double WorldTime;
+    double SimulationTime;
+    TWeakObjectPtr<UOrbitalMechanics> Ship;
+    uint32 Generation;
+    EOrbitalEventType Type;
+
+    bool operator<(const FScheduledOrbitalEvent& Other) const { return WorldTime < Other.WorldTime; }
+};
+
+// Broadcast after the render frame origin moves, with the offset applied to world-space positions
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnOrbitalFrameRebased, const FVector& /*OriginShift*/);
+
+// World-level orbital simulation for all spacecraft
+UCLASS()
+class CELESTIALSYNDICATE_API UOrbitalSimulationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UOrbitalSimulationSubsystem();
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Ship registration, assigns the component's SimulationSlot and takes over its tick
+    void RegisterShip(UOrbitalMechanics* Component);
+    void UnregisterShip(UOrbitalMechanics* Component);
+
+    int32 GetNumShips() const { return Ships.Num(); }
+    int32 GetNumQueuedEvents() const { return EventQueue.Num() - NumStaleEvents; }
+
+    // Number of ships handed to each worker task
+    static constexpr int32 ShipsPerChunk = 32;
+
+    // Floating origin: orbital state is absolute double precision, actors live relative to FrameOrigin
+    FVector OrbitalToWorld(const FVector& OrbitalPosition) const { return OrbitalPosition - FrameOrigin; }
+    FVector WorldToOrbital(const FVector& WorldPosition) const { return WorldPosition + FrameOrigin; }
+    const FVector& GetFrameOrigin() const { return FrameOrigin; }
+    void SetFrameOrigin(const FVector& NewOrigin);
+
+    // Ship the frame follows; defaults to the first local player's pawn when unset. Servers never rebase
+    void SetFocusShip(UOrbitalMechanics* Component) { FocusShip = Component; }
+
+    FOnOrbitalFrameRebased OnFrameRebased;
+
+private:
+    // Registered components, densely packed by slot
+    TArray<TWeakObjectPtr<UOrbitalMechanics>> Ships;
+
+    // Resolved pointers for the current frame, shared read-only with worker tasks
+    TArray<UOrbitalMechanics*> FrameShips;
+
+    // Absolute orbital position that maps to the world origin
+    FVector FrameOrigin;
+    TWeakObjectPtr<UOrbitalMechanics> FocusShip;
+
+    // Distance the focus ship may drift from the origin before the frame is rebased (m)
+    double RebaseDistance;
+
+    // Set by SetFrameOrigin so ships skipped this frame still have their transforms moved
+    bool bFrameRebased;
+
+    // Significance buckets (m) and the real-time simulation interval of each reduced bucket (s)
+    double NearDistance;
+    double DistantDistance;
+    float DistantInterval;
+    float DormantInterval;
+
+    // Significance is re-evaluated at this cadence rather than every frame
+    float SignificanceUpdateInterval;
+    float SignificanceTimer;
+
+    // Per-ship simulated time this frame, parallel to FrameShips
+    TArray<float> FrameDeltaTimes;
+
+    // Kepler solver iterations of each worker chunk this frame, summed into the KeplerIterations counter
+    TArray<uint32> ChunkKeplerIterations;
+
+    // Min-heap of predicted events for every ship; superseded entries are skipped when popped
+    TArray<FScheduledOrbitalEvent> EventQueue;
+    int32 NumStaleEvents;
+
+    // Per-frame stages
+    void UpdateSignificance(float DeltaTime);
+    void GatherInputs(float DeltaTime);
+    void SimulateChunks();
+    void UpdateFrameOrigin();
+    void ApplyResults();
+    void ScheduleOrbitalEvents();
+    void DispatchOrbitalEvents();
+    void PublishCounters();
+
+    float GetSimulationInterval(EOrbitalSignificance InSignificance) const;
+    void SetShipSignificance(UOrbitalMechanics* Component, EOrbitalSignificance NewSignificance);
+
+    // Supersedes a ship's queued events; they stay in the heap until popped or compacted
+    void RetireOrbitalEvents(UOrbitalMechanics* Component);
+    void CompactEventQueue();
+
+    // Drops components that were destroyed without unregistering
+    void CompactStaleShips();
+};
@@ -0,0 +1,153 @@
+// OrbitalTrajectory.cpp
+// Predicted Trajectory Cache for Celestial Syndicate
+// Quantum Documentation: Implements invalidation, incremental sampling and snapshot publishing for ship trajectories
+// Feature Context: Feeds orbit lines, apsis markers and SOI-change predictions to UI and AI
+// Dependencies: Unreal Engine core containers, KeplerOrbit, OrbitalGravitySubsystem
+// Usage Example: UOrbitalMechanics updates its cache after each simulation step
+// Security: Builds on the worker that owns the ship; the game thread publishes, so readers only see complete snapshots
+// Performance: Closed orbits are sampled once per conic; open orbits only sample what expired since the last update
+
+#include "OrbitalTrajectory.h"
+#include "OrbitalGravitySubsystem.h"
+
+FOrbitalTrajectoryCache::FOrbitalTrajectoryCache()
+{
+    ParentBodyIndex = 0;
+    Head = 0;
+    Count = 0;
+    SampleInterval = 0.0;
+    NextSampleTime = 0.0;
+    NextParentBodyIndex = INDEX_NONE;
+    bClosed = false;
+    bDirty = true;
+    bRebuilt = false;
+    Ring.SetNum(NumSamples);
+}
+
+void FOrbitalTrajectoryCache::Update(double Time, const UOrbitalGravitySubsystem* Gravity)
+{
+    bool bChanged = bRebuilt;
+    bRebuilt = false;
+    if (!bChanged)
+    {
+        if (bClosed)
+        {
+            return; // The loop repeats; nothing expires
+        }
+
+        // Keep one sample behind the ship so the drawn path starts under it
+        while (Count > 1 && Ring[(Head + 1) % NumSamples].Time <= Time)
+        {
+            Head = (Head + 1) % NumSamples;
+            Count--;
+            bChanged = true;
+        }
+    }
+
+    if (!Orbit.bIsValid)
+    {
+        if (bChanged)
+        {
+            BuildSnapshot(Time);
+        }
+        return;
+    }
+
+    // Extend the ring until it is full or the path leaves this sphere of influence
+    while (Count < NumSamples && !SphereOfInfluenceChangeTime.IsSet())
+    {
+        if (!AppendSample(NextSampleTime, Gravity))
+        {
+            break;
+        }
+        NextSampleTime += SampleInterval;
+        bChanged = true;
+    }
+
+    if (bChanged)
+    {
+        BuildSnapshot(Time);
+    }
+}
+
+void FOrbitalTrajectoryCache::Rebuild(const FKeplerOrbit& InOrbit, int32 InParentBodyIndex, double Time)
+{
+    Orbit = InOrbit;
+    ParentBodyIndex = InParentBodyIndex;
+    Head = 0;
+    Count = 0;
+    SphereOfInfluenceChangeTime.Reset();
+    NextParentBodyIndex = INDEX_NONE;
+    bClosed = Orbit.IsElliptic();
+    SampleInterval = (bClosed ? Orbit.GetPeriod() : OpenOrbitHorizon) / NumSamples;
+    NextSampleTime = Time;
+    bDirty = false;
+    bRebuilt = true;
+}
+
+bool FOrbitalTrajectoryCache::AppendSample(double SampleTime, const UOrbitalGravitySubsystem* Gravity)
+{
+    FOrbitalTrajectorySample Sample;
+    Sample.Time = SampleTime;
+    FVector Velocity;
+    Orbit.GetStateAtTime(SampleTime, Sample.Position, Velocity);
+
+    // A sample in another body's sphere of influence ends this conic's path
+    if (Gravity && Gravity->GetNumBodies() > 0)
+    {
+        FVector ParentPosition, ParentVelocity;
+        Gravity->GetBodyStateAtTime(ParentBodyIndex, SampleTime, ParentPosition, ParentVelocity);
+        const int32 DominantBody = Gravity->FindDominantBody(ParentPosition + Sample.Position, SampleTime);
+        if (DominantBody != ParentBodyIndex)
+        {
+            SphereOfInfluenceChangeTime = SampleTime;
+            NextParentBodyIndex = DominantBody;
+            bClosed = false;
+            return false;
+        }
+    }
+
+    Ring[(Head + Count) % NumSamples] = Sample;
+    Count++;
+    return true;
+}
+
+void FOrbitalTrajectoryCache::PublishPending()
+{
+    check(IsInGameThread());
+    if (PendingSnapshot.IsValid())
+    {
+        Snapshot = MoveTemp(PendingSnapshot);
+    }
+}
+
+void FOrbitalTrajectoryCache::BuildSnapshot(double Time)
+{
+    TSharedRef<FOrbitalTrajectorySnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FOrbitalTrajectorySnapshot, ESPMode::ThreadSafe>();
+    NewSnapshot->ParentBodyIndex = ParentBodyIndex;
+    NewSnapshot->bIsClosed = bClosed;
+    NewSnapshot->Period = bClosed ? Orbit.GetPeriod() : 0.0;
+    NewSnapshot->SphereOfInfluenceChangeTime = SphereOfInfluenceChangeTime;
+    NewSnapshot->NextParentBodyIndex = NextParentBodyIndex;
+
+    NewSnapshot->Samples.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; i++)
+    {
+        NewSnapshot->Samples[i] = Ring[(Head + i) % NumSamples];
+    }
+
+    // Apsides beyond the SOI change belong to the next conic
+    const TOptional<double> PeriapsisTime = Orbit.GetNextPeriapsisTime(Time);
+    const TOptional<double> ApoapsisTime = Orbit.GetNextApoapsisTime(Time);
+    const double PathEnd = SphereOfInfluenceChangeTime.Get(BIG_NUMBER);
+    if (PeriapsisTime.IsSet() && PeriapsisTime.GetValue() < PathEnd)
+    {
+        NewSnapshot->PeriapsisTime = PeriapsisTime;
+    }
+    if (ApoapsisTime.IsSet() && ApoapsisTime.GetValue() < PathEnd)
+    {
+        NewSnapshot->ApoapsisTime = ApoapsisTime;
+    }
+
+    PendingSnapshot = NewSnapshot;
+}
@@ -0,0 +1,105 @@
+// OrbitalTrajectory.h
+// Predicted Trajectory Cache Header for Celestial Syndicate
+// Quantum Documentation: Describes the per-ship ring of future states and the snapshots published to readers
+// Feature Context: Gives map, navigation UI and AI the future path of a ship without re-simulating it
+// Dependencies: Unreal Engine core containers, KeplerOrbit, OrbitalGravitySubsystem
+// Usage Example: Component->GetTrajectory()->Samples, fetched on the game thread and drawn by the map view on any thread
+// Security: Published snapshots are immutable; the game thread only ever swaps in a new one
+// Performance: Rebuilt only when a burn or SOI change invalidates the conic; open orbits extend a few samples at a time
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KeplerOrbit.h"
+
+// Forward declarations
+class UOrbitalGravitySubsystem;
+
+// One predicted point, relative to the snapshot's parent body
+struct FOrbitalTrajectorySample
+{
+    double Time;
+    FVector Position;
+};
+
+// Immutable view of a ship's predicted path
+struct FOrbitalTrajectorySnapshot
+{
+    int32 ParentBodyIndex;
+
+    // Closed orbits repeat: add multiples of Period to the sample and apsis times
+    bool bIsClosed;
+    double Period;
+
+    TArray<FOrbitalTrajectorySample> Samples;
+
+    // Next passages after the snapshot was built
+    TOptional<double> PeriapsisTime;
+    TOptional<double> ApoapsisTime;
+
+    // Where the path leaves the parent's sphere of influence or enters a child's; the path ends there
+    TOptional<double> SphereOfInfluenceChangeTime;
+    int32 NextParentBodyIndex;
+
+    FOrbitalTrajectorySnapshot()
+    {
+        ParentBodyIndex = 0;
+        bIsClosed = false;
+        Period = 0.0;
+        NextParentBodyIndex = INDEX_NONE;
+    }
+};
+
+// Shared handle with an atomic refcount; holding one keeps that snapshot alive while newer ones are published.
+// The handle itself is not atomic, so copy it from the cache on the game thread only
+typedef TSharedPtr<const FOrbitalTrajectorySnapshot, ESPMode::ThreadSafe> FOrbitalTrajectorySnapshotPtr;
+
+// Per-ship trajectory predictor, updated from the simulation pass
+class CELESTIALSYNDICATE_API FOrbitalTrajectoryCache
+{
+public:
+    FOrbitalTrajectoryCache();
+
+    // Burns and SOI changes mark the cache dirty; the owner then rebuilds it from the new conic
+    void Invalidate() { bDirty = true; }
+    bool IsDirty() const { return bDirty; }
+    void Rebuild(const FKeplerOrbit& InOrbit, int32 InParentBodyIndex, double Time);
+
+    // Brings the ring up to date at Time; builds a pending snapshot when it changed. Safe on the owning worker
+    void Update(double Time, const UOrbitalGravitySubsystem* Gravity);
+
+    // Game thread: makes the last pending snapshot the one GetSnapshot returns
+    void PublishPending();
+
+    // Game thread only
+    const FOrbitalTrajectorySnapshotPtr& GetSnapshot() const { return Snapshot; }
+
+    // Ring capacity and how far ahead open orbits are predicted (s)
+    static constexpr int32 NumSamples = 128;
+    static constexpr double OpenOrbitHorizon = 86400.0;
+
+private:
+    bool AppendSample(double SampleTime, const UOrbitalGravitySubsystem* Gravity);
+    void BuildSnapshot(double Time);
+
+    FKeplerOrbit Orbit;
+    int32 ParentBodyIndex;
+
+    // Fixed-capacity ring of future samples
+    TArray<FOrbitalTrajectorySample> Ring;
+    int32 Head;
+    int32 Count;
+    double SampleInterval;
+    double NextSampleTime;
+
+    TOptional<double> SphereOfInfluenceChangeTime;
+    int32 NextParentBodyIndex;
+
+    bool bClosed;
+    bool bDirty;
+    bool bRebuilt;
+
+    // Written by Update on the simulation worker, moved into Snapshot on the game thread between passes
+    FOrbitalTrajectorySnapshotPtr PendingSnapshot;
+    FOrbitalTrajectorySnapshotPtr Snapshot;
+};
@@ -0,0 +1,240 @@
+// OrbitalTransferPlanner.cpp
+// Lambert Transfer Planner for Celestial Syndicate
+// Quantum Documentation: Implements the universal-variable Lambert solver and batched window evaluation
+// Feature Context: Replaces the synchronous coplanar Hohmann estimate for mission planning
+// Dependencies: Unreal Engine core math, ParallelFor, KeplerOrbit, CelestialEphemeris, OrbitalMechanics
+// Usage Example: Called from a background task spawned by UOrbitalMechanics::PlanTransfersAsync
+// Security: Pure functions of the captured context, safe on any thread
+// Performance: Newton steps stay inside a bisection bracket, so every query converges in a bounded number of iterations
+
+#include "OrbitalTransferPlanner.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr int32 LambertMaxIterations = 64;
+    constexpr double LambertTolerance = 1e-9;
+}
+
+bool FOrbitalTransferPlanner::SolveLambert(const FVector& DeparturePosition, const FVector& ArrivalPosition, double TimeOfFlight, double Mu,
+                                           const FVector& ReferenceNormal, FVector& OutDepartureVelocity, FVector& OutArrivalVelocity)
+{
+    const double R1 = DeparturePosition.Size();
+    const double R2 = ArrivalPosition.Size();
+    if (R1 <= 0.0 || R2 <= 0.0 || TimeOfFlight <= 0.0 || Mu <= 0.0)
+    {
+        return false;
+    }
+
+    // Transfer angle, taken the prograde way round
+    double CosDeltaNu = FMath::Clamp(FVector::DotProduct(DeparturePosition, ArrivalPosition) / (R1 * R2), -1.0, 1.0);
+    double DeltaNu = FMath::Acos(CosDeltaNu);
+    if (FVector::DotProduct(FVector::CrossProduct(DeparturePosition, ArrivalPosition), ReferenceNormal) < 0.0)
+    {
+        DeltaNu = 2.0 * PI - DeltaNu;
+    }
+
+    const double OneMinusCos = 1.0 - CosDeltaNu;
+    if (OneMinusCos <= SMALL_NUMBER)
+    {
+        return false; // Zero-angle transfer is degenerate
+    }
+    const double A = FMath::Sin(DeltaNu) * FMath::Sqrt(R1 * R2 / OneMinusCos);
+    if (FMath::Abs(A) <= SMALL_NUMBER)
+    {
+        return false; // 180° transfer has no unique plane
+    }
+
+    const double RootMuTime = FMath::Sqrt(Mu) * TimeOfFlight;
+
+    // y(z) and the time-of-flight residual F(z), which increases monotonically with z
+    auto Evaluate = [R1, R2, A, RootMuTime](double Z, double& OutY, double& OutF)
+    {
+        double C, S;
+        FKeplerOrbit::Stumpff(Z, C, S);
+        OutY = R1 + R2 + A * (Z * S - 1.0) / FMath::Sqrt(C);
+        if (OutY < 0.0)
+        {
+            OutF = -RootMuTime;
+            return false;
+        }
+        OutF = FMath::Pow(OutY / C, 1.5) * S + A * FMath::Sqrt(OutY) - RootMuTime;
+        return true;
+    };
+
+    // Bracket the single-revolution root: z < 4π² keeps the transfer under one lap
+    double Low = -4.0 * PI * PI;
+    double High = 4.0 * PI * PI * (1.0 - KINDA_SMALL_NUMBER);
+    double Y, F;
+    for (int32 i = 0; i < 16 && Evaluate(Low, Y, F) && F > 0.0; i++)
+    {
+        Low *= 2.0; // Very short flights sit deep in the hyperbolic range
+    }
+    if (!Evaluate(High, Y, F) || F < 0.0)
+    {
+        return false; // Longer than a single-revolution transfer allows
+    }
+
+    double Z = 0.0;
+    for (int32 Iteration = 0; Iteration < LambertMaxIterations; Iteration++)
+    {
+        if (!Evaluate(Z, Y, F) || F < 0.0)
+        {
+            Low = Z;
+        }
+        else
+        {
+            High = Z;
+        }
+
+        if (FMath::Abs(F) <= LambertTolerance * RootMuTime)
+        {
+            break;
+        }
+
+        // Newton on a central difference, falling back to bisection when it leaves the bracket
+        const double Delta = FMath::Max(1e-6, FMath::Abs(Z) * 1e-6);
+        double YPlus, FPlus, YMinus, FMinus;
+        double NextZ = 0.5 * (Low + High);
+        if (Evaluate(Z + Delta, YPlus, FPlus) && Evaluate(Z - Delta, YMinus, FMinus))
+        {
+            const double Derivative = (FPlus - FMinus) / (2.0 * Delta);
+            const double NewtonZ = Derivative > 0.0 ? Z - F / Derivative : NextZ;
+            if (NewtonZ > Low && NewtonZ < High)
+            {
+                NextZ = NewtonZ;
+            }
+        }
+        Z = NextZ;
+    }
+
+    if (!Evaluate(Z, Y, F) || Y <= 0.0)
+    {
+        return false;
+    }
+
+    // Lagrange coefficients
+    const double LagrangeF = 1.0 - Y / R1;
+    const double LagrangeG = A * FMath::Sqrt(Y / Mu);
+    const double LagrangeGDot = 1.0 - Y / R2;
+    OutDepartureVelocity = (ArrivalPosition - DeparturePosition * LagrangeF) / LagrangeG;
+    OutArrivalVelocity = (ArrivalPosition * LagrangeGDot - DeparturePosition) / LagrangeG;
+    return true;
+}
+
+TArray<FTransferOrbit> FOrbitalTransferPlanner::PlanBatch(const FTransferPlanningContext& Context, const TArray<FTransferQuery>& Queries)
+{
+    TArray<FTransferOrbit> Results;
+    Results.SetNum(Queries.Num());
+
+    ParallelFor(Queries.Num(), [&Context, &Queries, &Results](int32 Index)
+    {
+        Results[Index] = PlanTransfer(Context, Queries[Index]);
+    }, EParallelForFlags::BackgroundPriority);
+
+    return Results;
+}
+
+TArray<FTransferQuery> FOrbitalTransferPlanner::MakePorkchopGrid(int32 TargetBodyIndex, double EarliestDeparture, double LatestDeparture, int32 NumDepartures,
+                                                                 double MinTimeOfFlight, double MaxTimeOfFlight, int32 NumTimesOfFlight)
+{
+    TArray<FTransferQuery> Queries;
+    Queries.Reserve(NumDepartures * NumTimesOfFlight);
+
+    const double DepartureStep = NumDepartures > 1 ? (LatestDeparture - EarliestDeparture) / (NumDepartures - 1) : 0.0;
+    const double FlightStep = NumTimesOfFlight > 1 ? (MaxTimeOfFlight - MinTimeOfFlight) / (NumTimesOfFlight - 1) : 0.0;
+
+    for (int32 i = 0; i < NumDepartures; i++)
+    {
+        for (int32 j = 0; j < NumTimesOfFlight; j++)
+        {
+            FTransferQuery Query;
+            Query.TargetBodyIndex = TargetBodyIndex;
+            Query.DepartureTime = EarliestDeparture + i * DepartureStep;
+            Query.ArrivalTime = Query.DepartureTime + MinTimeOfFlight + j * FlightStep;
+            Queries.Add(Query);
+        }
+    }
+
+    return Queries;
+}
+
+FTransferOrbit FOrbitalTransferPlanner::PlanTransfer(const FTransferPlanningContext& Context, const FTransferQuery& Query)
+{
+    FTransferOrbit Result;
+    Result.DepartureTime = Query.DepartureTime;
+    Result.TransferTime = Query.ArrivalTime - Query.DepartureTime;
+
+    if (!Context.Ephemerides.IsValid() || !Context.Ephemerides->IsValidIndex(Query.TargetBodyIndex) || !Context.ShipOrbit.bIsValid)
+    {
+        return Result;
+    }
+
+    // Interplanetary legs are solved about the Sun, a leg to a moon about its planet
+    const int32 CentralBody = FindCommonPrimary(Context, Context.ShipParentBodyIndex, Query.TargetBodyIndex);
+    if (CentralBody == INDEX_NONE)
+    {
+        return Result;
+    }
+    const double Mu = Context.BodyMu[CentralBody];
+
+    // Ship at departure and target at arrival, both relative to the central body
+    FVector ShipPosition, ShipVelocity, ParentPosition, ParentVelocity, CentralPosition, CentralVelocity;
+    Context.ShipOrbit.GetStateAtTime(Query.DepartureTime, ShipPosition, ShipVelocity);
+    GetBodyState(Context, Context.ShipParentBodyIndex, Query.DepartureTime, ParentPosition, ParentVelocity);
+    GetBodyState(Context, CentralBody, Query.DepartureTime, CentralPosition, CentralVelocity);
+    ShipPosition += ParentPosition - CentralPosition;
+    ShipVelocity += ParentVelocity - CentralVelocity;
+
+    FVector TargetPosition, TargetVelocity;
+    GetBodyState(Context, Query.TargetBodyIndex, Query.ArrivalTime, TargetPosition, TargetVelocity);
+    GetBodyState(Context, CentralBody, Query.ArrivalTime, CentralPosition, CentralVelocity);
+    TargetPosition -= CentralPosition;
+    TargetVelocity -= CentralVelocity;
+
+    const FVector ReferenceNormal = FVector::CrossProduct(ShipPosition, ShipVelocity);
+    FVector DepartureVelocity, ArrivalVelocity;
+    if (!SolveLambert(ShipPosition, TargetPosition, Result.TransferTime, Mu, ReferenceNormal, DepartureVelocity, ArrivalVelocity))
+    {
+        return Result;
+    }
+
+    const FKeplerOrbit Transfer = FKeplerOrbit::FromStateVectors(ShipPosition, DepartureVelocity, Mu, Query.DepartureTime);
+    Result.SemiMajorAxis = Transfer.SemiMajorAxis;
+    Result.Eccentricity = Transfer.Eccentricity;
+    Result.DepartureBurn = DepartureVelocity - ShipVelocity;
+    Result.DeltaV = Result.DepartureBurn.Size() + (TargetVelocity - ArrivalVelocity).Size();
+    Result.bIsValid = true;
+    return Result;
+}
+
+int32 FOrbitalTransferPlanner::FindCommonPrimary(const FTransferPlanningContext& Context, int32 BodyA, int32 BodyB)
+{
+    const int32 NumBodies = Context.BodyPrimaryIndex.Num();
+    if (!Context.BodyPrimaryIndex.IsValidIndex(BodyA) || !Context.BodyPrimaryIndex.IsValidIndex(BodyB))
+    {
+        return INDEX_NONE;
+    }
+
+    // Walk up from A marking its chain, then up from B to the first marked body; walks are bounded against bad data
+    TBitArray<> ChainOfA(false, NumBodies);
+    for (int32 Body = BodyA, Steps = 0; Body != INDEX_NONE && Steps < NumBodies; Body = Context.BodyPrimaryIndex[Body], Steps++)
+    {
+        ChainOfA[Body] = true;
+    }
+    for (int32 Body = BodyB, Steps = 0; Body != INDEX_NONE && Steps < NumBodies; Body = Context.BodyPrimaryIndex[Body], Steps++)
+    {
+        if (ChainOfA[Body])
+        {
+            return Body;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+void FOrbitalTransferPlanner::GetBodyState(const FTransferPlanningContext& Context, int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity)
+{
+    // System frame; callers subtract the central body
+    FCelestialEphemeris::GetSystemStateAtTime(*Context.Ephemerides, BodyIndex, Time, OutPosition, OutVelocity);
+}
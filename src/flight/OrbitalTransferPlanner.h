@@ -0,0 +1,55 @@
+// OrbitalTransferPlanner.h
+// Lambert Transfer Planner Header for Celestial Syndicate
+// Quantum Documentation: Describes the Lambert solver and the batched transfer planner used for route planning
+// Feature Context: Evaluates departure/arrival windows to celestial bodies, including porkchop grids, off the game thread
+// Dependencies: Unreal Engine core math, Async, ParallelFor, KeplerOrbit, CelestialEphemeris, OrbitalMechanics
+// Usage Example: OrbitalMechanics->PlanTransfersAsync(FOrbitalTransferPlanner::MakePorkchopGrid(...)).Next(...)
+// Security: Planning works on copied state and shared immutable ephemerides, never on live components
+// Performance: Each query is one bracketed Newton solve in universal variables; batches spread across worker threads
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KeplerOrbit.h"
+#include "CelestialEphemeris.h"
+#include "OrbitalMechanics.h"
+
+// Everything a batch needs, captured on the game thread
+struct FTransferPlanningContext
+{
+    // Per-body gravitational parameter and sphere-of-influence primary; each transfer is solved about the
+    // innermost body whose sphere holds both ends, in that body's frame
+    TArray<double> BodyMu;
+    TArray<int32> BodyPrimaryIndex;
+
+    // Ship conic about its parent, and the parent's index into the ephemerides
+    FKeplerOrbit ShipOrbit;
+    int32 ShipParentBodyIndex;
+
+    FCelestialEphemerisTablePtr Ephemerides;
+
+    FTransferPlanningContext()
+    {
+        ShipParentBodyIndex = 0;
+    }
+};
+
+// Stateless Lambert planning
+struct CELESTIALSYNDICATE_API FOrbitalTransferPlanner
+{
+    // Universal-variable Lambert solve; prograde relative to ReferenceNormal. Returns false when it fails to converge
+    static bool SolveLambert(const FVector& DeparturePosition, const FVector& ArrivalPosition, double TimeOfFlight, double Mu,
+                             const FVector& ReferenceNormal, FVector& OutDepartureVelocity, FVector& OutArrivalVelocity);
+
+    // Solves every query; results are in query order and invalid entries have bIsValid cleared
+    static TArray<FTransferOrbit> PlanBatch(const FTransferPlanningContext& Context, const TArray<FTransferQuery>& Queries);
+
+    // Departure times by time-of-flight grid for one target body
+    static TArray<FTransferQuery> MakePorkchopGrid(int32 TargetBodyIndex, double EarliestDeparture, double LatestDeparture, int32 NumDepartures,
+                                                   double MinTimeOfFlight, double MaxTimeOfFlight, int32 NumTimesOfFlight);
+
+private:
+    static FTransferOrbit PlanTransfer(const FTransferPlanningContext& Context, const FTransferQuery& Query);
+    static int32 FindCommonPrimary(const FTransferPlanningContext& Context, int32 BodyA, int32 BodyB);
+    static void GetBodyState(const FTransferPlanningContext& Context, int32 BodyIndex, double Time, FVector& OutPosition, FVector& OutVelocity);
+};
@@ -0,0 +1,138 @@
+// ReplicatedOrbit.cpp
+// Compact Replicated Orbit for Celestial Syndicate
+// Quantum Documentation: Implements conversion between Kepler orbits and their quantized wire form
+// Feature Context: Replaces raw position, velocity and element replication for orbital components
+// Dependencies: Unreal Engine networking (NetSerialize), KeplerOrbit
+// Usage Example: Serialized by the replication system whenever UOrbitalMechanics::ReplicatedOrbit changes
+// Security: Decoded values are clamped to their valid ranges before use
+// Performance: Smallest-three rotation packing spends 74 bits on the orbital plane and periapsis direction
+
+#include "ReplicatedOrbit.h"
+#include "Engine/NetSerialization.h"
+
+namespace
+{
+    constexpr int32 OrientationComponentBits = 24;
+    constexpr uint32 OrientationComponentMax = (1u << OrientationComponentBits) - 1;
+
+    // Smallest-three components lie in [-1/√2, 1/√2]
+    constexpr double OrientationComponentRange = UE_DOUBLE_INV_SQRT_2;
+
+    uint32 QuantizeUnit(double Value, double Range, uint32 Max)
+    {
+        const double Normalized = FMath::Clamp(Value / Range * 0.5 + 0.5, 0.0, 1.0);
+        return static_cast<uint32>(FMath::RoundToDouble(Normalized * Max));
+    }
+
+    double DequantizeUnit(uint32 Value, double Range, uint32 Max)
+    {
+        return (static_cast<double>(FMath::Min(Value, Max)) / Max * 2.0 - 1.0) * Range;
+    }
+}
+
+FReplicatedOrbit FReplicatedOrbit::FromKeplerOrbit(const FKeplerOrbit& Orbit, int32 InParentBodyIndex, float InTimeAcceleration)
+{
+    FReplicatedOrbit Result;
+    Result.ParentBodyIndex = InParentBodyIndex;
+    Result.TimeAcceleration = InTimeAcceleration;
+    Result.EpochTime = Orbit.EpochTime;
+    if (!Orbit.bIsValid)
+    {
+        return Result;
+    }
+
+    Result.SemiLatusRectum = Orbit.PeriapsisRadius * (1.0 + Orbit.Eccentricity);
+    Result.Eccentricity = Orbit.Eccentricity;
+    Result.TrueAnomalyAtEpoch = FMath::Atan2(FVector::DotProduct(Orbit.EpochPosition, Orbit.NormalAxis), FVector::DotProduct(Orbit.EpochPosition, Orbit.PeriapsisAxis));
+
+    const FVector AngularMomentumAxis = FVector::CrossProduct(Orbit.PeriapsisAxis, Orbit.NormalAxis);
+    Result.Orientation = FQuat(FMatrix(Orbit.PeriapsisAxis, Orbit.NormalAxis, AngularMomentumAxis, FVector::ZeroVector)).GetNormalized();
+    Result.bIsValid = true;
+    return Result;
+}
+
+FKeplerOrbit FReplicatedOrbit::ToKeplerOrbit(double Mu) const
+{
+    if (!bIsValid || SemiLatusRectum <= 0.0 || Mu <= 0.0)
+    {
+        return FKeplerOrbit();
+    }
+
+    const FVector PeriapsisAxis = Orientation.GetAxisX();
+    const FVector NormalAxis = Orientation.GetAxisY();
+
+    double SinNu, CosNu;
+    FMath::SinCos(&SinNu, &CosNu, TrueAnomalyAtEpoch);
+    const double Radius = SemiLatusRectum / (1.0 + Eccentricity * CosNu);
+    const double VelocityScale = FMath::Sqrt(Mu / SemiLatusRectum);
+
+    const FVector Position = (PeriapsisAxis * CosNu + NormalAxis * SinNu) * Radius;
+    const FVector Velocity = (PeriapsisAxis * -SinNu + NormalAxis * (Eccentricity + CosNu)) * VelocityScale;
+    return FKeplerOrbit::FromStateVectors(Position, Velocity, Mu, EpochTime);
+}
+
+bool FReplicatedOrbit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint8 bValidBit = bIsValid ? 1 : 0;
+    Ar.SerializeBits(&bValidBit, 1);
+    bIsValid = bValidBit != 0;
+
+    Ar << EpochTime;
+
+    uint8 Parent = static_cast<uint8>(FMath::Clamp(ParentBodyIndex, 0, 255));
+    Ar << Parent;
+    ParentBodyIndex = Parent;
+
+    // Same range SetTimeAcceleration allows; a bad value cannot freeze or run away the client's clock
+    Ar << TimeAcceleration;
+    TimeAcceleration = FMath::IsFinite(TimeAcceleration) ? FMath::Clamp(TimeAcceleration, 0.1f, 1000.0f) : 1.0f;
+
+    if (!bIsValid)
+    {
+        bOutSuccess = true;
+        return true;
+    }
+
+    // Shape in double precision: the period follows from it, and a float ulp on a heliocentric conic
+    // (kilometres) would let client phase drift without bound between the rare orbit changes
+    Ar << SemiLatusRectum;
+    Ar << Eccentricity;
+    SemiLatusRectum = FMath::IsFinite(SemiLatusRectum) ? FMath::Max(SemiLatusRectum, 0.0) : 0.0;
+    Eccentricity = FMath::IsFinite(Eccentricity) ? FMath::Max(Eccentricity, 0.0) : 0.0;
+
+    uint32 Anomaly = QuantizeUnit(FMath::UnwindRadians(TrueAnomalyAtEpoch), PI, MAX_uint32);
+    Ar << Anomaly;
+    TrueAnomalyAtEpoch = DequantizeUnit(Anomaly, PI, MAX_uint32);
+
+    // Smallest-three: drop the largest component, made positive, and rebuild it from the unit norm
+    FQuat Rotation = Orientation.GetNormalized();
+    double Components[4] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+    uint8 LargestIndex = 0;
+    for (uint8 i = 1; i < 4; i++)
+    {
+        if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+        {
+            LargestIndex = i;
+        }
+    }
+    Ar.SerializeBits(&LargestIndex, 2);
+
+    const double Sign = Components[LargestIndex] < 0.0 ? -1.0 : 1.0;
+    double SumSquares = 0.0;
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i == LargestIndex)
+        {
+            continue;
+        }
+        uint32 Packed = QuantizeUnit(Components[i] * Sign, OrientationComponentRange, OrientationComponentMax);
+        Ar.SerializeBits(&Packed, OrientationComponentBits);
+        Components[i] = DequantizeUnit(Packed, OrientationComponentRange, OrientationComponentMax);
+        SumSquares += Components[i] * Components[i];
+    }
+    Components[LargestIndex] = FMath::Sqrt(FMath::Max(1.0 - SumSquares, 0.0));
+    Orientation = FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+
+    bOutSuccess = true;
+    return true;
+}
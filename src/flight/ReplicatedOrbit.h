@@ -0,0 +1,77 @@
+// ReplicatedOrbit.h
+// Compact Replicated Orbit Header for Celestial Syndicate
+// Quantum Documentation: Describes the quantized conic sent to clients in place of per-frame Cartesian state
+// Feature Context: Clients propagate ships locally from the last conic the server sent
+// Dependencies: Unreal Engine networking (NetSerialize), KeplerOrbit
+// Usage Example: ReplicatedOrbit = FReplicatedOrbit::FromKeplerOrbit(Orbit, ParentBodyIndex, TimeAcceleration); Client: ToKeplerOrbit(ParentMu)
+// Security: All fields are range-checked on read; a malformed packet yields an invalid orbit, not a bad state
+// Performance: About 43 bytes per update, and updates only go out when the conic or the warp rate changes
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KeplerOrbit.h"
+#include "ReplicatedOrbit.generated.h"
+
+// Conic in classical form: shape, epoch anomaly and the perifocal frame as a rotation
+USTRUCT()
+struct CELESTIALSYNDICATE_API FReplicatedOrbit
+{
+    GENERATED_BODY()
+
+    double EpochTime;
+    int32 ParentBodyIndex;
+
+    // Simulated seconds per world second; clients advance the conic at the server's warp rate
+    float TimeAcceleration;
+
+    // Semi-latus rectum (m) and eccentricity stay finite for every conic, including parabolas
+    double SemiLatusRectum;
+    double Eccentricity;
+    double TrueAnomalyAtEpoch;
+
+    // Maps X to the periapsis axis and Y to the normal axis of the perifocal frame
+    FQuat Orientation;
+
+    bool bIsValid;
+
+    FReplicatedOrbit()
+    {
+        EpochTime = 0.0;
+        ParentBodyIndex = 0;
+        TimeAcceleration = 1.0f;
+        SemiLatusRectum = 0.0;
+        Eccentricity = 0.0;
+        TrueAnomalyAtEpoch = 0.0;
+        Orientation = FQuat::Identity;
+        bIsValid = false;
+    }
+
+    static FReplicatedOrbit FromKeplerOrbit(const FKeplerOrbit& Orbit, int32 InParentBodyIndex, float InTimeAcceleration = 1.0f);
+    FKeplerOrbit ToKeplerOrbit(double Mu) const;
+
+    // Epoch and shape in double precision; anomaly in 32-bit fixed point; orientation as smallest-three
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FReplicatedOrbit& Other) const
+    {
+        return EpochTime == Other.EpochTime
+            && ParentBodyIndex == Other.ParentBodyIndex
+            && TimeAcceleration == Other.TimeAcceleration
+            && SemiLatusRectum == Other.SemiLatusRectum
+            && Eccentricity == Other.Eccentricity
+            && TrueAnomalyAtEpoch == Other.TrueAnomalyAtEpoch
+            && Orientation == Other.Orientation
+            && bIsValid == Other.bIsValid;
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedOrbit> : public TStructOpsTypeTraitsBase2<FReplicatedOrbit>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true
+    };
+};
@@ -1,9 +1,16 @@
 #include "Spacecraft.h"
+#include "FlightProfiling.h"
+#include "OrbitalMechanics.h"
+#include "SpacecraftRegistrySubsystem.h"
 
 ASpacecraft::ASpacecraft()
 {
     PrimaryActorTick.bCanEverTick = true;
 
+    // State reaches clients through the orbit and flight prediction components, never as per-tick transforms
+    bReplicates = true;
+    SetReplicateMovement(false);
+
     // Create and setup components
     ShipMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ShipMesh"));
     RootComponent = ShipMesh;
@@ -16,10 +23,19 @@ ASpacecraft::ASpacecraft()
     CurrentThrust = 0.0f;
     Mass = 1000.0f;
     DragCoefficient = 0.1f;
+    DragReferenceArea = 10.0f;
+    FlightModelMode = EFlightModelMode::Orbital;
+    OrbitalMechanics = nullptr;
+
+    // Registry
+    TeamId = 0;
+    SpawnSlot = INDEX_NONE;
 
     // Initialize flight state
     Velocity = FVector::ZeroVector;
     Acceleration = FVector::ZeroVector;
+    PreviousVelocity = FVector::ZeroVector;
+    PendingRotation = FRotator::ZeroRotator;
 }
 
 void ASpacecraft::BeginPlay()
@@ -27,19 +43,58 @@ void ASpacecraft::BeginPlay()
     Super::BeginPlay();
     InitializeComponents();
     SetupPhysics();
+
+    if (USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>())
+    {
+        Registry->RegisterSpacecraft(this);
+    }
+}
+
+void ASpacecraft::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (USpacecraftRegistrySubsystem* Registry = World->GetSubsystem<USpacecraftRegistrySubsystem>())
+        {
+            Registry->UnregisterSpacecraft(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASpacecraft::PossessedBy(AController* NewController)
+{
+    Super::PossessedBy(NewController);
+
+    if (USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>())
+    {
+        Registry->NotifyPossessed(this, NewController);
+    }
+}
+
+void ASpacecraft::UnPossessed()
+{
+    Super::UnPossessed();
+
+    if (USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>())
+    {
+        Registry->NotifyUnpossessed(this);
+    }
 }
 
 void ASpacecraft::Tick(float DeltaTime)
 {
+    CELESTIAL_FLIGHT_SCOPE(SpacecraftTick);
+
     Super::Tick(DeltaTime);
     UpdateFlightPhysics(DeltaTime);
 }
 
 void ASpacecraft::InitializeComponents()
 {
-    // Setup collision
+    // Setup collision; only the root body ever simulates
     CollisionBox->SetCollisionProfileName(TEXT("PhysicsActor"));
-    CollisionBox->SetSimulatePhysics(true);
     CollisionBox->SetEnableGravity(false);
 
     // Setup mesh
@@ -52,7 +107,7 @@ void ASpacecraft::SetupPhysics()
     // Configure physics properties
     if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(ShipMesh))
     {
-        PrimitiveComponent->SetSimulatePhysics(true);
+        PrimitiveComponent->SetSimulatePhysics(FlightModelMode == EFlightModelMode::Chaos);
         PrimitiveComponent->SetEnableGravity(false);
         PrimitiveComponent->SetMassOverrideInKg(NAME_None, Mass);
         PrimitiveComponent->SetLinearDamping(DragCoefficient);
@@ -60,13 +115,46 @@ void ASpacecraft::SetupPhysics()
     }
 }
 
+void ASpacecraft::SetFlightModelMode(EFlightModelMode NewMode)
+{
+    if (NewMode == FlightModelMode)
+    {
+        return;
+    }
+
+    FlightModelMode = NewMode;
+
+    // Hand momentum across so the switch is seamless; orbital mode leaves the body kinematic
+    if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(ShipMesh))
+    {
+        const bool bChaos = FlightModelMode == EFlightModelMode::Chaos;
+        PrimitiveComponent->SetSimulatePhysics(bChaos);
+        if (bChaos)
+        {
+            PrimitiveComponent->SetPhysicsLinearVelocity(Velocity);
+        }
+    }
+}
+
+void ASpacecraft::ApplyFlightCommand(const FSpacecraftFlightCommand& Command)
+{
+    ApplyThrust(Command.Thrust);
+    ApplyRotation(Command.Pitch, Command.Yaw, Command.Roll);
+}
+
 void ASpacecraft::ApplyThrust(float ThrustAmount)
 {
     // Clamp thrust to valid range
     CurrentThrust = FMath::Clamp(ThrustAmount, 0.0f, MaxThrust);
-    
+
+    // Orbital mode integrates thrust itself; only Chaos takes it as a force
+    if (FlightModelMode != EFlightModelMode::Chaos)
+    {
+        return;
+    }
+
     // Calculate thrust direction based on ship's forward vector
-    FVector ThrustDirection = GetActorForwardVector();
+    FVector ThrustDirection = GetThrustVector();
     FVector ThrustForce = ThrustDirection * CurrentThrust;
 
     // Apply force to the ship
@@ -78,19 +166,49 @@ void ASpacecraft::ApplyThrust(float ThrustAmount)
 
 void ASpacecraft::ApplyRotation(float Pitch, float Yaw, float Roll)
 {
-    // Create rotation delta
-    FRotator RotationDelta(Pitch, Yaw, Roll);
-    
-    // Apply rotation
-    AddActorLocalRotation(RotationDelta);
+    // Accumulate; the flight model that owns the transform applies it in its single write
+    PendingRotation += FRotator(Pitch, Yaw, Roll);
+}
+
+FVector ASpacecraft::GetFlightVelocity() const
+{
+    if (FlightModelMode == EFlightModelMode::Chaos)
+    {
+        if (const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(ShipMesh))
+        {
+            return PrimitiveComponent->GetPhysicsLinearVelocity();
+        }
+    }
+    return Velocity;
+}
+
+FQuat ASpacecraft::ConsumeRotationInput()
+{
+    const FQuat Rotation = PendingRotation.Quaternion();
+    PendingRotation = FRotator::ZeroRotator;
+    return Rotation;
 }
 
 void ASpacecraft::UpdateFlightPhysics(float DeltaTime)
 {
-    // Update velocity based on current forces
-    if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(ShipMesh))
+    // Chaos owns the transform here, so the attitude input goes straight to the body; predicted mode consumes it as commands
+    if (FlightModelMode == EFlightModelMode::Chaos || (FlightModelMode == EFlightModelMode::Orbital && !OrbitalMechanics))
     {
-        Velocity = PrimitiveComponent->GetPhysicsLinearVelocity();
-        Acceleration = (Velocity - Velocity) / DeltaTime;
+        AddActorLocalRotation(ConsumeRotationInput());
     }
-} 
\ No newline at end of file
+
+    // Orbital mode reports velocity through SetVelocity; Chaos has it on the rigid body
+    if (FlightModelMode == EFlightModelMode::Chaos)
+    {
+        if (UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(ShipMesh))
+        {
+            Velocity = PrimitiveComponent->GetPhysicsLinearVelocity();
+        }
+    }
+
+    if (DeltaTime > 0.0f)
+    {
+        Acceleration = (Velocity - PreviousVelocity) / DeltaTime;
+    }
+    PreviousVelocity = Velocity;
+}
@@ -1,13 +1,53 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "Spacecraft.generated.h"
 
+class UOrbitalMechanics;
+
+// One frame of pilot input, applied to the ship in a single call
+USTRUCT(BlueprintType)
+struct FSpacecraftFlightCommand
+{
+    GENERATED_BODY()
+
+    // Requested thrust, clamped by the ship to [0, MaxThrust]
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Thrust;
+
+    // Attitude change this frame (degrees)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Pitch;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Yaw;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Roll;
+
+    FSpacecraftFlightCommand()
+    {
+        Thrust = 0.0f;
+        Pitch = 0.0f;
+        Yaw = 0.0f;
+        Roll = 0.0f;
+    }
+};
+
+// Which simulation owns the ship's transform
+UENUM(BlueprintType)
+enum class EFlightModelMode : uint8
+{
+    Orbital  UMETA(DisplayName = "Orbital (Cruise)"),
+    Chaos    UMETA(DisplayName = "Chaos (Proximity and Docking)"),
+    Predicted UMETA(DisplayName = "Predicted (Piloted, Network Predicted)")
+};
+
 UCLASS()
-class CELESTIALSYNDICATE_API ASpacecraft : public AActor
+class CELESTIALSYNDICATE_API ASpacecraft : public APawn
 {
     GENERATED_BODY()
 
@@ -16,6 +56,43 @@ public:
 
     virtual void Tick(float DeltaTime) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void PossessedBy(AController* NewController) override;
+    virtual void UnPossessed() override;
+
+    // Registry keys, read once when the ship registers
+    int32 GetTeamId() const { return TeamId; }
+    int32 GetSpawnSlot() const { return SpawnSlot; }
+
+    // Drag parameters, read by UOrbitalMechanics each frame
+    float GetMass() const { return Mass; }
+    float GetDragCoefficient() const { return DragCoefficient; }
+    float GetDragReferenceArea() const { return DragReferenceArea; }
+
+    // Thrust inputs, read by UOrbitalMechanics in orbital mode and by the flight prediction driver
+    FVector GetThrustVector() const { return GetActorForwardVector(); }
+    float GetThrustMagnitude() const { return CurrentThrust; }
+    float GetMaxThrust() const { return MaxThrust; }
+
+    // Velocity of whichever flight model owns the ship
+    FVector GetFlightVelocity() const;
+
+    // Orbital mode: the orbital component writes the whole transform once per frame and reports velocity back
+    void SetOrbitalMechanics(UOrbitalMechanics* InOrbitalMechanics) { OrbitalMechanics = InOrbitalMechanics; }
+    void SetVelocity(const FVector& NewVelocity) { Velocity = NewVelocity; }
+
+    // Pilot input for this frame; thrust and attitude land together in one update
+    UFUNCTION(BlueprintCallable, Category = "Flight")
+    void ApplyFlightCommand(const FSpacecraftFlightCommand& Command);
+
+    // Attitude input gathered since the last transform write, as a local-space rotation
+    FQuat ConsumeRotationInput();
+
+    UFUNCTION(BlueprintCallable, Category = "Flight")
+    void SetFlightModelMode(EFlightModelMode NewMode);
+
+    UFUNCTION(BlueprintPure, Category = "Flight")
+    EFlightModelMode GetFlightModelMode() const { return FlightModelMode; }
 
 protected:
     // Components
@@ -25,6 +102,14 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UBoxComponent* CollisionBox;
 
+    // Registry
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Registry")
+    int32 TeamId;
+
+    // Designer-assigned start position for player assignment; INDEX_NONE when the ship has none
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Registry")
+    int32 SpawnSlot;
+
     // Flight Properties
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
     float MaxThrust;
@@ -38,6 +123,14 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
     float DragCoefficient;
 
+    // Cross-section presented to the flow for atmospheric drag (m²)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
+    float DragReferenceArea;
+
+    // Orbital for cruise; Chaos for close proximity and docking; Predicted for networked pilots. Only one of them moves the ship
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flight")
+    EFlightModelMode FlightModelMode;
+
     // Flight State
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flight")
     FVector Velocity;
@@ -58,4 +151,10 @@ protected:
 private:
     void InitializeComponents();
     void SetupPhysics();
+
+    UPROPERTY()
+    UOrbitalMechanics* OrbitalMechanics;
+
+    FRotator PendingRotation;
+    FVector PreviousVelocity;
 }; 
\ No newline at end of file
@@ -1,11 +1,20 @@
 #include "SpacecraftController.h"
 #include "Spacecraft.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
+#include "SpacecraftRegistrySubsystem.h"
 
 ASpacecraftController::ASpacecraftController()
 {
     // Initialize control properties
     ThrustSensitivity = 1.0f;
     RotationSensitivity = 1.0f;
+    FlightMappingContext = nullptr;
+    ThrustAction = nullptr;
+    PitchAction = nullptr;
+    YawAction = nullptr;
+    RollAction = nullptr;
     ControlledSpacecraft = nullptr;
 }
 
@@ -13,17 +22,62 @@ void ASpacecraftController::BeginPlay()
 {
     Super::BeginPlay();
     FindAndPossessSpacecraft();
+
+    if (FlightMappingContext)
+    {
+        if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer()))
+        {
+            InputSubsystem->AddMappingContext(FlightMappingContext, 0);
+        }
+    }
 }
 
 void ASpacecraftController::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
+
+    // Only the local player's controller produces input; a server's copy of a remote client's controller
+    // would apply an empty command over the input arriving through NetworkPrediction
+    if (!IsLocalController())
+    {
+        return;
+    }
+
+    // Input has been processed for this frame; hand the ship one command and start the next
+    if (ControlledSpacecraft)
+    {
+        ControlledSpacecraft->ApplyFlightCommand(PendingCommand);
+    }
+    PendingCommand = FSpacecraftFlightCommand();
 }
 
 void ASpacecraftController::SetupInputComponent()
 {
     Super::SetupInputComponent();
 
+    UEnhancedInputComponent* EnhancedInput = Cast<UEnhancedInputComponent>(InputComponent);
+    if (EnhancedInput && FlightMappingContext)
+    {
+        // Triggered fires only while an axis is held; released axes stay at zero in the fresh command
+        if (ThrustAction)
+        {
+            EnhancedInput->BindAction(ThrustAction, ETriggerEvent::Triggered, this, &ASpacecraftController::HandleThrustAction);
+        }
+        if (PitchAction)
+        {
+            EnhancedInput->BindAction(PitchAction, ETriggerEvent::Triggered, this, &ASpacecraftController::HandlePitchAction);
+        }
+        if (YawAction)
+        {
+            EnhancedInput->BindAction(YawAction, ETriggerEvent::Triggered, this, &ASpacecraftController::HandleYawAction);
+        }
+        if (RollAction)
+        {
+            EnhancedInput->BindAction(RollAction, ETriggerEvent::Triggered, this, &ASpacecraftController::HandleRollAction);
+        }
+        return;
+    }
+
     // Bind thrust input
     InputComponent->BindAxis("Thrust", this, &ASpacecraftController::HandleThrustInput);
 
@@ -33,62 +87,106 @@ void ASpacecraftController::SetupInputComponent()
     InputComponent->BindAxis("Roll", this, &ASpacecraftController::HandleRollInput);
 }
 
-void ASpacecraftController::FindAndPossessSpacecraft()
+void ASpacecraftController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    // Find the first spacecraft in the level
-    TArray<AActor*> FoundSpacecraft;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASpacecraft::StaticClass(), FoundSpacecraft);
-
-    if (FoundSpacecraft.Num() > 0)
+    if (SpacecraftRegisteredHandle.IsValid())
     {
-        ControlledSpacecraft = Cast<ASpacecraft>(FoundSpacecraft[0]);
-        if (ControlledSpacecraft)
+        if (USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>())
         {
-            Possess(ControlledSpacecraft);
+            Registry->OnSpacecraftRegistered.Remove(SpacecraftRegisteredHandle);
         }
+        SpacecraftRegisteredHandle.Reset();
     }
+
+    Super::EndPlay(EndPlayReason);
 }
 
-void ASpacecraftController::HandleThrustInput(float Value)
+void ASpacecraftController::SetPawn(APawn* InPawn)
 {
-    if (!ControlledSpacecraft)
+    Super::SetPawn(InPawn);
+    ControlledSpacecraft = Cast<ASpacecraft>(InPawn);
+}
+
+void ASpacecraftController::FindAndPossessSpacecraft()
+{
+    // Possession is server-side; clients learn their ship through SetPawn
+    if (!HasAuthority() || ControlledSpacecraft)
     {
-        return; // Early exit improves readability and avoids nested blocks
+        return;
     }
 
-    const float ThrustAmount = Value * ThrustSensitivity; // Compute once for clarity
-    ControlledSpacecraft->ApplyThrust(ThrustAmount);
-}
+    USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>();
+    if (!Registry)
+    {
+        return;
+    }
 
-void ASpacecraftController::HandlePitchInput(float Value)
-{
-    if (!ControlledSpacecraft)
+    // O(1): take any free ship; possessing it removes it from the free list
+    if (ASpacecraft* Spacecraft = Registry->FindUnpossessedSpacecraft())
     {
-        return; // Guard clause keeps function lean
+        Possess(Spacecraft);
+        return;
     }
 
-    const float PitchAmount = Value * RotationSensitivity;
-    ControlledSpacecraft->ApplyRotation(PitchAmount, 0.0f, 0.0f);
+    // Ships may still be beginning play; claim the first one that registers
+    if (!SpacecraftRegisteredHandle.IsValid())
+    {
+        SpacecraftRegisteredHandle = Registry->OnSpacecraftRegistered.AddUObject(this, &ASpacecraftController::HandleSpacecraftRegistered);
+    }
 }
 
-void ASpacecraftController::HandleYawInput(float Value)
+void ASpacecraftController::HandleSpacecraftRegistered(ASpacecraft* Spacecraft)
 {
-    if (!ControlledSpacecraft)
+    if (ControlledSpacecraft || Spacecraft->GetController())
     {
         return;
     }
 
-    const float YawAmount = Value * RotationSensitivity;
-    ControlledSpacecraft->ApplyRotation(0.0f, YawAmount, 0.0f);
+    if (USpacecraftRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>())
+    {
+        Registry->OnSpacecraftRegistered.Remove(SpacecraftRegisteredHandle);
+    }
+    SpacecraftRegisteredHandle.Reset();
+
+    Possess(Spacecraft);
+}
+
+void ASpacecraftController::HandleThrustInput(float Value)
+{
+    PendingCommand.Thrust = Value * ThrustSensitivity;
+}
+
+void ASpacecraftController::HandlePitchInput(float Value)
+{
+    PendingCommand.Pitch += Value * RotationSensitivity;
+}
+
+void ASpacecraftController::HandleYawInput(float Value)
+{
+    PendingCommand.Yaw += Value * RotationSensitivity;
 }
 
 void ASpacecraftController::HandleRollInput(float Value)
 {
-    if (!ControlledSpacecraft)
-    {
-        return;
-    }
+    PendingCommand.Roll += Value * RotationSensitivity;
+}
+
+void ASpacecraftController::HandleThrustAction(const FInputActionValue& Value)
+{
+    HandleThrustInput(Value.Get<float>());
+}
 
-    const float RollAmount = Value * RotationSensitivity;
-    ControlledSpacecraft->ApplyRotation(0.0f, 0.0f, RollAmount);
-}
\ No newline at end of file
+void ASpacecraftController::HandlePitchAction(const FInputActionValue& Value)
+{
+    HandlePitchInput(Value.Get<float>());
+}
+
+void ASpacecraftController::HandleYawAction(const FInputActionValue& Value)
+{
+    HandleYawInput(Value.Get<float>());
+}
+
+void ASpacecraftController::HandleRollAction(const FInputActionValue& Value)
+{
+    HandleRollInput(Value.Get<float>());
+}
@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "InputActionValue.h"
+#include "Spacecraft.h"
 #include "SpacecraftController.generated.h"
 
-class ASpacecraft;
+class UInputAction;
+class UInputMappingContext;
 
 UCLASS()
 class CELESTIALSYNDICATE_API ASpacecraftController : public APlayerController
@@ -17,9 +20,13 @@ public:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
     virtual void SetupInputComponent() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Tracks the possessed ship on both server and owning client
+    virtual void SetPawn(APawn* InPawn) override;
 
 protected:
-    // Input functions
+    // Input functions; each only writes its axis into PendingCommand
     UFUNCTION()
     void HandleThrustInput(float Value);
 
@@ -32,6 +39,12 @@ protected:
     UFUNCTION()
     void HandleRollInput(float Value);
 
+    // Enhanced Input forwarding
+    void HandleThrustAction(const FInputActionValue& Value);
+    void HandlePitchAction(const FInputActionValue& Value);
+    void HandleYawAction(const FInputActionValue& Value);
+    void HandleRollAction(const FInputActionValue& Value);
+
     // Flight control properties
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
     float ThrustSensitivity;
@@ -39,7 +52,31 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
     float RotationSensitivity;
 
+    // Enhanced Input; when unset the legacy axis mappings are used instead
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    UInputMappingContext* FlightMappingContext;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    UInputAction* ThrustAction;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    UInputAction* PitchAction;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    UInputAction* YawAction;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    UInputAction* RollAction;
+
+    // All axes for the current frame, applied once in Tick
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flight")
+    FSpacecraftFlightCommand PendingCommand;
+
 private:
     ASpacecraft* ControlledSpacecraft;
     void FindAndPossessSpacecraft();
-}; 
\ No newline at end of file
+
+    // Set while waiting for a ship to register because none was free at BeginPlay
+    FDelegateHandle SpacecraftRegisteredHandle;
+    void HandleSpacecraftRegistered(ASpacecraft* Spacecraft);
+}; 
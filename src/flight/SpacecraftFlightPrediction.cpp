@@ -0,0 +1,268 @@
+// SpacecraftFlightPrediction.cpp
+// Predicted Spacecraft Flight Model for Celestial Syndicate
+// Quantum Documentation: Implements the NetworkPrediction flight simulation and its spacecraft driver
+// Feature Context: Replaces direct, unreplicated ApplyThrust/ApplyRotation for piloted ships
+// Dependencies: NetworkPrediction plugin, OrbitalIntegrator, OrbitalGravitySubsystem, OrbitalMechanics, OrbitalSimulationSubsystem, Spacecraft
+// Usage Example: NetworkPrediction ticks SimulationTick on both ends; FinalizeFrame moves the actor
+// Security: Input is clamped on deserialization so a client cannot command more than full throttle
+// Performance: One Verlet step and one ephemeris lookup per simulation frame; resimulation replays only buffered frames
+
+#include "SpacecraftFlightPrediction.h"
+#include "NetworkPredictionModelDefRegistry.h"
+#include "NetworkPredictionProxyInit.h"
+#include "OrbitalGravitySubsystem.h"
+#include "OrbitalIntegrator.h"
+#include "OrbitalMechanics.h"
+#include "OrbitalSimulationSubsystem.h"
+#include "Spacecraft.h"
+
+NP_MODEL_REGISTER(FSpacecraftFlightModelDef);
+
+namespace
+{
+    // Rates travel as int16 hundredths of a degree per second
+    constexpr double RotationRateScale = 100.0;
+
+    // Divergence that triggers a correction
+    constexpr double ReconcilePositionTolerance = 0.1; // m
+    constexpr double ReconcileVelocityTolerance = 0.01; // m/s
+    constexpr double ReconcileRotationTolerance = 0.1; // degrees
+
+    int16 QuantizeRate(double Rate)
+    {
+        return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Rate * RotationRateScale), -MAX_int16, MAX_int16));
+    }
+}
+
+void FSpacecraftFlightInputCmd::NetSerialize(const FNetSerializeParams& P)
+{
+    uint8 PackedThrottle = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Throttle, 0.0f, 1.0f) * 255.0f));
+    int16 PackedPitch = QuantizeRate(RotationRate.Pitch);
+    int16 PackedYaw = QuantizeRate(RotationRate.Yaw);
+    int16 PackedRoll = QuantizeRate(RotationRate.Roll);
+
+    P.Ar << PackedThrottle;
+    P.Ar << PackedPitch;
+    P.Ar << PackedYaw;
+    P.Ar << PackedRoll;
+
+    Throttle = PackedThrottle / 255.0f;
+    RotationRate = FRotator(PackedPitch / RotationRateScale, PackedYaw / RotationRateScale, PackedRoll / RotationRateScale);
+}
+
+void FSpacecraftFlightInputCmd::ToString(FAnsiStringBuilderBase& Out) const
+{
+    Out.Appendf("Throttle: %.3f\n", Throttle);
+    Out.Appendf("RotationRate: P=%.2f Y=%.2f R=%.2f\n", RotationRate.Pitch, RotationRate.Yaw, RotationRate.Roll);
+}
+
+void FSpacecraftFlightSyncState::NetSerialize(const FNetSerializeParams& P)
+{
+    // Position stays in full double precision; it is absolute in the system frame
+    P.Ar << Position;
+    P.Ar << Velocity;
+
+    bool bOutSuccess = true;
+    Rotation.NetSerialize(P.Ar, nullptr, bOutSuccess);
+}
+
+void FSpacecraftFlightSyncState::ToString(FAnsiStringBuilderBase& Out) const
+{
+    Out.Appendf("Position: %s\n", TCHAR_TO_ANSI(*Position.ToString()));
+    Out.Appendf("Velocity: %s\n", TCHAR_TO_ANSI(*Velocity.ToString()));
+    Out.Appendf("Rotation: %s\n", TCHAR_TO_ANSI(*Rotation.ToString()));
+}
+
+bool FSpacecraftFlightSyncState::ShouldReconcile(const FSpacecraftFlightSyncState& AuthorityState) const
+{
+    return !Position.Equals(AuthorityState.Position, ReconcilePositionTolerance)
+        || !Velocity.Equals(AuthorityState.Velocity, ReconcileVelocityTolerance)
+        || FMath::RadiansToDegrees(Rotation.AngularDistance(AuthorityState.Rotation)) > ReconcileRotationTolerance;
+}
+
+void FSpacecraftFlightSyncState::Interpolate(const FSpacecraftFlightSyncState* From, const FSpacecraftFlightSyncState* To, float PCT)
+{
+    Position = FMath::Lerp(From->Position, To->Position, PCT);
+    Velocity = FMath::Lerp(From->Velocity, To->Velocity, PCT);
+    Rotation = FQuat::Slerp(From->Rotation, To->Rotation, PCT);
+}
+
+void FSpacecraftFlightAuxState::NetSerialize(const FNetSerializeParams& P)
+{
+    P.Ar << Mass;
+    P.Ar << MaxThrust;
+    P.Ar << ParentBodyIndex;
+    P.Ar << EpochTime;
+}
+
+void FSpacecraftFlightAuxState::ToString(FAnsiStringBuilderBase& Out) const
+{
+    Out.Appendf("Mass: %.1f MaxThrust: %.1f\n", Mass, MaxThrust);
+    Out.Appendf("ParentBodyIndex: %d EpochTime: %.3f\n", ParentBodyIndex, EpochTime);
+}
+
+bool FSpacecraftFlightAuxState::ShouldReconcile(const FSpacecraftFlightAuxState& AuthorityState) const
+{
+    return Mass != AuthorityState.Mass
+        || MaxThrust != AuthorityState.MaxThrust
+        || ParentBodyIndex != AuthorityState.ParentBodyIndex
+        || EpochTime != AuthorityState.EpochTime;
+}
+
+void FSpacecraftFlightAuxState::Interpolate(const FSpacecraftFlightAuxState* From, const FSpacecraftFlightAuxState* To, float PCT)
+{
+    *this = *To;
+}
+
+void FSpacecraftFlightSimulation::SimulationTick(const FNetSimTimeStep& TimeStep, const TNetSimInput<FSpacecraftFlightStateTypes>& Input, const TNetSimOutput<FSpacecraftFlightStateTypes>& Output)
+{
+    const double Step = TimeStep.StepMS * 0.001;
+    const double Time = Input.Aux->EpochTime + TimeStep.TotalSimulationTime * 0.001;
+    const FSpacecraftFlightAuxState& Aux = *Input.Aux;
+
+    FSpacecraftFlightSyncState& Sync = *Output.Sync;
+    Sync = *Input.Sync;
+
+    // Attitude first, so thrust uses this frame's heading
+    const FRotator RotationDelta = Input.Cmd->RotationRate * Step;
+    Sync.Rotation = (Sync.Rotation * RotationDelta.Quaternion()).GetNormalized();
+
+    const double Throttle = FMath::Clamp(Input.Cmd->Throttle, 0.0f, 1.0f);
+    const FVector ThrustAcceleration = Aux.Mass > 0.0f ? Sync.Rotation.GetForwardVector() * (Throttle * Aux.MaxThrust / Aux.Mass) : FVector::ZeroVector;
+
+    // Parent gravity, with the body held where it is at the start of the step
+    FVector ParentPosition = FVector::ZeroVector;
+    FVector ParentVelocity = FVector::ZeroVector;
+    double Mu = 0.0;
+    const bool bHasBodies = Gravity && Aux.ParentBodyIndex < Gravity->GetNumBodies();
+    if (bHasBodies)
+    {
+        Gravity->GetBodyStateAtTime(Aux.ParentBodyIndex, Time, ParentPosition, ParentVelocity);
+        Mu = Gravity->GetBodyMu(Aux.ParentBodyIndex);
+    }
+
+    auto Acceleration = [&ParentPosition, Mu, &ThrustAcceleration](const FVector& Position, const FVector& Velocity)
+    {
+        const FVector Relative = Position - ParentPosition;
+        const double RadiusSquared = Relative.SizeSquared();
+        FVector Result = ThrustAcceleration;
+        if (RadiusSquared > SMALL_NUMBER)
+        {
+            Result -= Relative * (Mu / (RadiusSquared * FMath::Sqrt(RadiusSquared)));
+        }
+        return Result;
+    };
+
+    FVector CurrentAcceleration = Acceleration(Sync.Position, Sync.Velocity);
+    FOrbitalIntegrator::StepVelocityVerlet(Sync.Position, Sync.Velocity, CurrentAcceleration, Step, Acceleration);
+    LastStepEndTime = Time + Step;
+
+    // Body ephemerides are identical on both ends, so SOI changes predict too
+    if (bHasBodies)
+    {
+        const int32 DominantBody = Gravity->FindDominantBody(Sync.Position, Time + Step);
+        if (DominantBody != Aux.ParentBodyIndex)
+        {
+            Output.Aux.Get()->ParentBodyIndex = DominantBody;
+        }
+    }
+}
+
+USpacecraftFlightPredictionComponent::USpacecraftFlightPredictionComponent()
+{
+    SetIsReplicatedByDefault(true);
+    LastParentBodyIndex = INDEX_NONE;
+}
+
+void USpacecraftFlightPredictionComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // The predicted model owns the transform from now on
+    if (ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner()))
+    {
+        Spacecraft->SetFlightModelMode(EFlightModelMode::Predicted);
+    }
+}
+
+void USpacecraftFlightPredictionComponent::InitializeNetworkPredictionProxy()
+{
+    Simulation = MakeUnique<FSpacecraftFlightSimulation>();
+    Simulation->Gravity = GetWorld()->GetSubsystem<UOrbitalGravitySubsystem>();
+
+    NetworkPredictionProxy.Init<FSpacecraftFlightModelDef>(GetWorld(), GetReplicationProxies(), Simulation.Get(), this);
+}
+
+void USpacecraftFlightPredictionComponent::InitializeSimulationState(FSpacecraftFlightSyncState* Sync, FSpacecraftFlightAuxState* Aux)
+{
+    ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner());
+    if (!Spacecraft)
+    {
+        return;
+    }
+
+    const UOrbitalSimulationSubsystem* OrbitalSimulation = GetWorld()->GetSubsystem<UOrbitalSimulationSubsystem>();
+    const FVector WorldLocation = Spacecraft->GetActorLocation();
+    Sync->Position = OrbitalSimulation ? OrbitalSimulation->WorldToOrbital(WorldLocation) : WorldLocation;
+    Sync->Velocity = Spacecraft->GetFlightVelocity();
+    Sync->Rotation = Spacecraft->GetActorQuat();
+
+    Aux->Mass = Spacecraft->GetMass();
+    Aux->MaxThrust = Spacecraft->GetMaxThrust();
+
+    // Body ephemerides are keyed by orbital time, so the prediction clock starts at the orbital component's; simulation time is zero here
+    if (const UOrbitalMechanics* Orbital = Spacecraft->FindComponentByClass<UOrbitalMechanics>())
+    {
+        Aux->EpochTime = Orbital->SimulationTime;
+    }
+    if (Simulation.IsValid() && Simulation->Gravity)
+    {
+        Aux->ParentBodyIndex = Simulation->Gravity->FindDominantBody(Sync->Position, Aux->EpochTime);
+    }
+}
+
+void USpacecraftFlightPredictionComponent::ProduceInput(const int32 DeltaTimeMS, FSpacecraftFlightInputCmd* Cmd)
+{
+    ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner());
+    if (!Spacecraft || DeltaTimeMS <= 0)
+    {
+        return;
+    }
+
+    // The controller keeps calling ApplyThrust/ApplyRotation; this turns what accumulated into one command
+    const float MaxThrust = Spacecraft->GetMaxThrust();
+    Cmd->Throttle = MaxThrust > 0.0f ? Spacecraft->GetThrustMagnitude() / MaxThrust : 0.0f;
+    Cmd->RotationRate = Spacecraft->ConsumeRotationInput().Rotator() * (1000.0 / DeltaTimeMS);
+}
+
+void USpacecraftFlightPredictionComponent::FinalizeFrame(const FSpacecraftFlightSyncState* Sync, const FSpacecraftFlightAuxState* Aux)
+{
+    ASpacecraft* Spacecraft = Cast<ASpacecraft>(GetOwner());
+    if (!Spacecraft)
+    {
+        return;
+    }
+
+    // Single transform write; UOrbitalMechanics follows the actor in predicted mode
+    const UOrbitalSimulationSubsystem* OrbitalSimulation = GetWorld()->GetSubsystem<UOrbitalSimulationSubsystem>();
+    const FVector WorldLocation = OrbitalSimulation ? OrbitalSimulation->OrbitalToWorld(Sync->Position) : Sync->Position;
+    Spacecraft->SetActorLocationAndRotation(WorldLocation, Sync->Rotation);
+    Spacecraft->SetVelocity(Sync->Velocity);
+
+    // The new parent's position depends on the clock, so the authority lines the prediction clock back up with the orbital one
+    if (Aux->ParentBodyIndex != LastParentBodyIndex)
+    {
+        const bool bReanchor = LastParentBodyIndex != INDEX_NONE && GetOwnerRole() == ROLE_Authority;
+        LastParentBodyIndex = Aux->ParentBodyIndex;
+
+        const UOrbitalMechanics* Orbital = bReanchor ? Spacecraft->FindComponentByClass<UOrbitalMechanics>() : nullptr;
+        if (Orbital && Simulation.IsValid())
+        {
+            const double Drift = Orbital->SimulationTime - Simulation->LastStepEndTime;
+            NetworkPredictionProxy.WriteAuxState<FSpacecraftFlightAuxState>([Drift](FSpacecraftFlightAuxState& AuxState)
+            {
+                AuxState.EpochTime += Drift;
+            }, "ParentBodyChanged");
+        }
+    }
+}
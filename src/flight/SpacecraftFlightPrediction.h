@@ -0,0 +1,144 @@
+// SpacecraftFlightPrediction.h
+// Predicted Spacecraft Flight Model Header for Celestial Syndicate
+// Quantum Documentation: Describes the NetworkPrediction states, simulation and driver for piloted flight
+// Feature Context: Client-side prediction of pilot input with server-authoritative reconciliation and resimulation
+// Dependencies: NetworkPrediction plugin, OrbitalIntegrator, OrbitalGravitySubsystem, Spacecraft
+// Usage Example: Add USpacecraftFlightPredictionComponent to a piloted spacecraft; the controller input feeds it unchanged
+// Security: The server simulates every command itself; clients only ever propose input
+// Performance: Commands are 7 bytes; corrections go out only when a client's predicted state diverges
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkPredictionComponent.h"
+#include "NetworkPredictionModelDef.h"
+#include "NetworkPredictionReplicationProxy.h"
+#include "NetworkPredictionSimulation.h"
+#include "NetworkPredictionStateTypes.h"
+#include "NetworkPredictionTickState.h"
+#include "SpacecraftFlightPrediction.generated.h"
+
+// Forward declarations
+class UOrbitalGravitySubsystem;
+class USpacecraftFlightPredictionComponent;
+
+// One frame of pilot input
+struct FSpacecraftFlightInputCmd
+{
+    // 0..1 of MaxThrust
+    float Throttle;
+
+    // Body rates (deg/s)
+    FRotator RotationRate;
+
+    FSpacecraftFlightInputCmd()
+    {
+        Throttle = 0.0f;
+        RotationRate = FRotator::ZeroRotator;
+    }
+
+    void NetSerialize(const FNetSerializeParams& P);
+    void ToString(FAnsiStringBuilderBase& Out) const;
+};
+
+// Predicted state, in the absolute orbital (system) frame
+struct FSpacecraftFlightSyncState
+{
+    FVector Position;
+    FVector Velocity;
+    FQuat Rotation;
+
+    FSpacecraftFlightSyncState()
+    {
+        Position = FVector::ZeroVector;
+        Velocity = FVector::ZeroVector;
+        Rotation = FQuat::Identity;
+    }
+
+    void NetSerialize(const FNetSerializeParams& P);
+    void ToString(FAnsiStringBuilderBase& Out) const;
+    bool ShouldReconcile(const FSpacecraftFlightSyncState& AuthorityState) const;
+    void Interpolate(const FSpacecraftFlightSyncState* From, const FSpacecraftFlightSyncState* To, float PCT);
+};
+
+// Rarely changing parameters
+struct FSpacecraftFlightAuxState
+{
+    float Mass;
+    float MaxThrust;
+    int32 ParentBodyIndex;
+
+    // Orbital simulation time at which the prediction clock started; taken from UOrbitalMechanics and re-anchored on SOI changes
+    double EpochTime;
+
+    FSpacecraftFlightAuxState()
+    {
+        Mass = 1000.0f;
+        MaxThrust = 0.0f;
+        ParentBodyIndex = 0;
+        EpochTime = 0.0;
+    }
+
+    void NetSerialize(const FNetSerializeParams& P);
+    void ToString(FAnsiStringBuilderBase& Out) const;
+    bool ShouldReconcile(const FSpacecraftFlightAuxState& AuthorityState) const;
+    void Interpolate(const FSpacecraftFlightAuxState* From, const FSpacecraftFlightAuxState* To, float PCT);
+};
+
+using FSpacecraftFlightStateTypes = TNetworkPredictionStateTypes<FSpacecraftFlightInputCmd, FSpacecraftFlightSyncState, FSpacecraftFlightAuxState>;
+
+// Deterministic flight step: attitude rates, thrust and parent-body gravity
+class CELESTIALSYNDICATE_API FSpacecraftFlightSimulation
+{
+public:
+    FSpacecraftFlightSimulation()
+    {
+        Gravity = nullptr;
+        LastStepEndTime = 0.0;
+    }
+
+    void SimulationTick(const FNetSimTimeStep& TimeStep, const TNetSimInput<FSpacecraftFlightStateTypes>& Input, const TNetSimOutput<FSpacecraftFlightStateTypes>& Output);
+
+    // Read-only body set shared with the orbital simulation
+    const UOrbitalGravitySubsystem* Gravity;
+
+    // Orbital time at the end of the latest step, read back by the driver
+    double LastStepEndTime;
+};
+
+class FSpacecraftFlightModelDef : public FNetworkPredictionModelDef
+{
+public:
+    NP_MODEL_BODY();
+
+    using Simulation = FSpacecraftFlightSimulation;
+    using StateTypes = FSpacecraftFlightStateTypes;
+    using Driver = USpacecraftFlightPredictionComponent;
+
+    static const TCHAR* GetName() { return TEXT("SpacecraftFlight"); }
+    static constexpr int32 GetSortPriority() { return (int32)ESortPriority::PreKinematicMovers; }
+};
+
+// Driver: puts the owning spacecraft in predicted mode and writes the predicted transform once per frame
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class CELESTIALSYNDICATE_API USpacecraftFlightPredictionComponent : public UNetworkPredictionComponent
+{
+    GENERATED_BODY()
+
+public:
+    USpacecraftFlightPredictionComponent();
+
+    virtual void BeginPlay() override;
+
+    // NetworkPrediction driver interface
+    virtual void InitializeNetworkPredictionProxy() override;
+    void InitializeSimulationState(FSpacecraftFlightSyncState* Sync, FSpacecraftFlightAuxState* Aux);
+    void ProduceInput(const int32 DeltaTimeMS, FSpacecraftFlightInputCmd* Cmd);
+    void FinalizeFrame(const FSpacecraftFlightSyncState* Sync, const FSpacecraftFlightAuxState* Aux);
+
+private:
+    TUniquePtr<FSpacecraftFlightSimulation> Simulation;
+
+    // Parent seen by the last FinalizeFrame; a change there re-anchors the prediction clock
+    int32 LastParentBodyIndex;
+};
@@ -0,0 +1,158 @@
+// SpacecraftRegistrySubsystem.cpp
+// Spacecraft Registry Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements indexed spacecraft registration, possession tracking and lookup
+// Feature Context: Lets join storms assign ships without scanning the world once per controller
+// Dependencies: Unreal Engine world subsystems, Spacecraft
+// Usage Example: GetWorld()->GetSubsystem<USpacecraftRegistrySubsystem>()->FindBySpawnSlot(Slot)
+// Security: Duplicate and unknown registrations are ignored rather than corrupting the indices
+// Performance: Every list is dense and every removal is a swap, so no operation scales with ship count
+
+#include "SpacecraftRegistrySubsystem.h"
+#include "Spacecraft.h"
+#include "GameFramework/Controller.h"
+
+USpacecraftRegistrySubsystem::USpacecraftRegistrySubsystem()
+{
+}
+
+void USpacecraftRegistrySubsystem::RegisterSpacecraft(ASpacecraft* Spacecraft)
+{
+    if (!Spacecraft || Entries.Contains(Spacecraft))
+    {
+        return;
+    }
+
+    FSpacecraftRegistryEntry& Entry = Entries.Add(Spacecraft);
+    Entry.AllIndex = AllSpacecraft.Add(Spacecraft);
+    Entry.TeamId = Spacecraft->GetTeamId();
+    Entry.TeamIndex = TeamSpacecraft.FindOrAdd(Entry.TeamId).Add(Spacecraft);
+    Entry.SpawnSlot = Spacecraft->GetSpawnSlot();
+    Entry.UnpossessedIndex = INDEX_NONE;
+    Entry.Owner = nullptr;
+
+    if (Entry.SpawnSlot != INDEX_NONE)
+    {
+        SpacecraftBySpawnSlot.Add(Entry.SpawnSlot, Spacecraft);
+    }
+
+    if (AController* Owner = Spacecraft->GetController())
+    {
+        Entry.Owner = Owner;
+        SpacecraftByOwner.Add(Owner, Spacecraft);
+    }
+    else
+    {
+        AddUnpossessed(Spacecraft, Entry);
+    }
+
+    OnSpacecraftRegistered.Broadcast(Spacecraft);
+}
+
+void USpacecraftRegistrySubsystem::UnregisterSpacecraft(ASpacecraft* Spacecraft)
+{
+    FSpacecraftRegistryEntry* Entry = Entries.Find(Spacecraft);
+    if (!Entry)
+    {
+        return;
+    }
+
+    RemoveAtSwapIndexed(AllSpacecraft, Entry->AllIndex, &FSpacecraftRegistryEntry::AllIndex);
+    if (TArray<ASpacecraft*>* Team = TeamSpacecraft.Find(Entry->TeamId))
+    {
+        RemoveAtSwapIndexed(*Team, Entry->TeamIndex, &FSpacecraftRegistryEntry::TeamIndex);
+    }
+    RemoveUnpossessed(*Entry);
+
+    if (Entry->Owner)
+    {
+        SpacecraftByOwner.Remove(Entry->Owner);
+    }
+    if (Entry->SpawnSlot != INDEX_NONE)
+    {
+        SpacecraftBySpawnSlot.Remove(Entry->SpawnSlot);
+    }
+
+    Entries.Remove(Spacecraft);
+}
+
+void USpacecraftRegistrySubsystem::NotifyPossessed(ASpacecraft* Spacecraft, AController* NewOwner)
+{
+    FSpacecraftRegistryEntry* Entry = Entries.Find(Spacecraft);
+    if (!Entry || !NewOwner)
+    {
+        return;
+    }
+
+    if (Entry->Owner)
+    {
+        SpacecraftByOwner.Remove(Entry->Owner);
+    }
+    RemoveUnpossessed(*Entry);
+
+    Entry->Owner = NewOwner;
+    SpacecraftByOwner.Add(NewOwner, Spacecraft);
+}
+
+void USpacecraftRegistrySubsystem::NotifyUnpossessed(ASpacecraft* Spacecraft)
+{
+    FSpacecraftRegistryEntry* Entry = Entries.Find(Spacecraft);
+    if (!Entry || !Entry->Owner)
+    {
+        return;
+    }
+
+    SpacecraftByOwner.Remove(Entry->Owner);
+    Entry->Owner = nullptr;
+    AddUnpossessed(Spacecraft, *Entry);
+}
+
+ASpacecraft* USpacecraftRegistrySubsystem::FindByOwner(const AController* Owner) const
+{
+    ASpacecraft* const* Found = SpacecraftByOwner.Find(Owner);
+    return Found ? *Found : nullptr;
+}
+
+ASpacecraft* USpacecraftRegistrySubsystem::FindBySpawnSlot(int32 SpawnSlot) const
+{
+    ASpacecraft* const* Found = SpacecraftBySpawnSlot.Find(SpawnSlot);
+    return Found ? *Found : nullptr;
+}
+
+const TArray<ASpacecraft*>& USpacecraftRegistrySubsystem::GetTeamSpacecraft(int32 TeamId) const
+{
+    static const TArray<ASpacecraft*> NoSpacecraft;
+    const TArray<ASpacecraft*>* Team = TeamSpacecraft.Find(TeamId);
+    return Team ? *Team : NoSpacecraft;
+}
+
+void USpacecraftRegistrySubsystem::RemoveAtSwapIndexed(TArray<ASpacecraft*>& List, int32 Index, int32 FSpacecraftRegistryEntry::* IndexMember)
+{
+    if (!List.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    List.RemoveAtSwap(Index);
+    if (List.IsValidIndex(Index))
+    {
+        Entries.FindChecked(List[Index]).*IndexMember = Index;
+    }
+}
+
+void USpacecraftRegistrySubsystem::AddUnpossessed(ASpacecraft* Spacecraft, FSpacecraftRegistryEntry& Entry)
+{
+    if (Entry.UnpossessedIndex == INDEX_NONE)
+    {
+        Entry.UnpossessedIndex = UnpossessedSpacecraft.Add(Spacecraft);
+    }
+}
+
+void USpacecraftRegistrySubsystem::RemoveUnpossessed(FSpacecraftRegistryEntry& Entry)
+{
+    if (Entry.UnpossessedIndex != INDEX_NONE)
+    {
+        const int32 Index = Entry.UnpossessedIndex;
+        Entry.UnpossessedIndex = INDEX_NONE;
+        RemoveAtSwapIndexed(UnpossessedSpacecraft, Index, &FSpacecraftRegistryEntry::UnpossessedIndex);
+    }
+}
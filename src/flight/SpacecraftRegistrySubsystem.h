@@ -0,0 +1,77 @@
+// SpacecraftRegistrySubsystem.h
+// Spacecraft Registry Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level index of every spacecraft by owner, team and spawn slot
+// Feature Context: Replaces world actor scans when controllers look for a ship to possess, and serves other systems' ship queries
+// Dependencies: Unreal Engine world subsystems, Spacecraft
+// Usage Example: ASpacecraft registers in BeginPlay; ASpacecraftController possesses FindUnpossessedSpacecraft()
+// Security: Game-thread only; entries are removed in EndPlay so no pointer outlives its ship
+// Performance: Registration, possession changes and every lookup are O(1)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpacecraftRegistrySubsystem.generated.h"
+
+// Forward declarations
+class AController;
+class ASpacecraft;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSpacecraftRegistered, ASpacecraft* /*Spacecraft*/);
+
+// World-level spacecraft index
+UCLASS()
+class CELESTIALSYNDICATE_API USpacecraftRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    USpacecraftRegistrySubsystem();
+
+    // Called by ASpacecraft in BeginPlay/EndPlay; team and spawn slot are read at registration
+    void RegisterSpacecraft(ASpacecraft* Spacecraft);
+    void UnregisterSpacecraft(ASpacecraft* Spacecraft);
+
+    // Called by ASpacecraft when it is possessed or released
+    void NotifyPossessed(ASpacecraft* Spacecraft, AController* NewOwner);
+    void NotifyUnpossessed(ASpacecraft* Spacecraft);
+
+    // Any ship nobody controls, or null; the caller possesses it to claim it
+    ASpacecraft* FindUnpossessedSpacecraft() const { return UnpossessedSpacecraft.Num() > 0 ? UnpossessedSpacecraft.Last() : nullptr; }
+
+    ASpacecraft* FindByOwner(const AController* Owner) const;
+    ASpacecraft* FindBySpawnSlot(int32 SpawnSlot) const;
+
+    // Ships on a team; empty when the team has none
+    const TArray<ASpacecraft*>& GetTeamSpacecraft(int32 TeamId) const;
+
+    const TArray<ASpacecraft*>& GetAllSpacecraft() const { return AllSpacecraft; }
+    int32 GetNumSpacecraft() const { return AllSpacecraft.Num(); }
+
+    // Lets late controllers pick up ships that finish BeginPlay after them
+    FOnSpacecraftRegistered OnSpacecraftRegistered;
+
+private:
+    // Position of a ship in each dense list, so removal is a swap instead of a search
+    struct FSpacecraftRegistryEntry
+    {
+        int32 AllIndex;
+        int32 TeamIndex;
+        int32 UnpossessedIndex;
+        int32 TeamId;
+        int32 SpawnSlot;
+        const AController* Owner;
+    };
+
+    TMap<const ASpacecraft*, FSpacecraftRegistryEntry> Entries;
+    TArray<ASpacecraft*> AllSpacecraft;
+    TArray<ASpacecraft*> UnpossessedSpacecraft;
+    TMap<int32, TArray<ASpacecraft*>> TeamSpacecraft;
+    TMap<const AController*, ASpacecraft*> SpacecraftByOwner;
+    TMap<int32, ASpacecraft*> SpacecraftBySpawnSlot;
+
+    // Swap-removes Index from List and fixes up the moved ship's stored index
+    void RemoveAtSwapIndexed(TArray<ASpacecraft*>& List, int32 Index, int32 FSpacecraftRegistryEntry::* IndexMember);
+    void AddUnpossessed(ASpacecraft* Spacecraft, FSpacecraftRegistryEntry& Entry);
+    void RemoveUnpossessed(FSpacecraftRegistryEntry& Entry);
+};
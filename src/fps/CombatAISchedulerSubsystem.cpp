@@ -0,0 +1,198 @@
+// CombatAISchedulerSubsystem.cpp
+// Combat AI Scheduler Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements budgeted, player-prioritised scheduling of AI combat decisions
+// Feature Context: Spreads UpdateAICombat across frames so crowd fights have bounded AI cost
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: Ticked by the world once per frame; due AI closest to a player decide first
+// Security: Combatants destroyed without unregistering are skipped
+// Performance: One budget check per decision; the due list is reused so scheduling never allocates in steady state
+
+#include "CombatAISchedulerSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatSystem.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CELESTIAL_COMBAT_COUNTER(AIDecisions);
+DECLARE_CELESTIAL_COMBAT_COUNTER(AIDecisionsDeferred);
+
+UCombatAISchedulerSubsystem::UCombatAISchedulerSubsystem()
+{
+    DecisionRate = 10.0f; // Hz
+    DistantDecisionRate = 2.0f; // Hz
+    FrameBudgetMicroseconds = 1000.0; // µs
+    NearPlayerDistance = 5000.0f; // uu
+    PriorityUpdateInterval = 0.5f; // s
+    PriorityTimer = 0.0f;
+    bRunningDecisions = false;
+    bHasStaleSlots = false;
+}
+
+void UCombatAISchedulerSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatAIScheduler);
+
+    if (Combatants.Num() == 0)
+    {
+        return;
+    }
+
+    PriorityTimer -= DeltaTime;
+    if (PriorityTimer <= 0.0f)
+    {
+        PriorityTimer = PriorityUpdateInterval;
+        UpdatePriorities();
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    DueSlots.Reset();
+    for (int32 Slot = 0; Slot < Combatants.Num(); Slot++)
+    {
+        if (NextDecisionTimes[Slot] <= Now)
+        {
+            DueSlots.Add(Slot);
+        }
+    }
+
+    // Closest to a player first, so the budget runs out on AI nobody is watching
+    DueSlots.Sort([this](int32 A, int32 B)
+    {
+        return PlayerDistancesSquared[A] < PlayerDistancesSquared[B];
+    });
+
+    const double BudgetEnd = FPlatformTime::Seconds() + FrameBudgetMicroseconds * 1e-6;
+    bRunningDecisions = true;
+    int32 NumDecisions = 0;
+    for (int32 i = 0; i < DueSlots.Num(); i++)
+    {
+        if (i > 0 && FPlatformTime::Seconds() >= BudgetEnd)
+        {
+            break; // The rest stay due and go first next frame
+        }
+
+        const int32 Slot = DueSlots[i];
+        UCombatSystem* Combat = Combatants[Slot].Get();
+        if (!Combat)
+        {
+            bHasStaleSlots = true;
+            continue;
+        }
+
+        const float Elapsed = static_cast<float>(Now - LastDecisionTimes[Slot]);
+        LastDecisionTimes[Slot] = Now;
+        NextDecisionTimes[Slot] = Now + GetDecisionInterval(Slot);
+        Combat->RunScheduledAICombat(Elapsed);
+        NumDecisions++;
+    }
+    bRunningDecisions = false;
+
+    SET_CELESTIAL_COMBAT_COUNTER(AIDecisions, NumDecisions);
+    SET_CELESTIAL_COMBAT_COUNTER(AIDecisionsDeferred, DueSlots.Num() - NumDecisions);
+
+    if (bHasStaleSlots)
+    {
+        bHasStaleSlots = false;
+        for (int32 Slot = Combatants.Num() - 1; Slot >= 0; Slot--)
+        {
+            if (!Combatants[Slot].IsValid())
+            {
+                RemoveSlot(Slot);
+            }
+        }
+    }
+}
+
+TStatId UCombatAISchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatAISchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatAISchedulerSubsystem::RegisterCombatant(UCombatSystem* Combat)
+{
+    if (!Combat || Combat->AIScheduleSlot != INDEX_NONE)
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    Combat->AIScheduleSlot = Combatants.Add(Combat);
+    LastDecisionTimes.Add(Now);
+    PlayerDistancesSquared.Add(TNumericLimits<float>::Max());
+
+    // Random phase so AI spawned together do not decide in lockstep
+    NextDecisionTimes.Add(Now + FMath::FRand() / DistantDecisionRate);
+}
+
+void UCombatAISchedulerSubsystem::UnregisterCombatant(UCombatSystem* Combat)
+{
+    if (!Combat || !Combatants.IsValidIndex(Combat->AIScheduleSlot))
+    {
+        return;
+    }
+
+    const int32 Slot = Combat->AIScheduleSlot;
+    Combat->AIScheduleSlot = INDEX_NONE;
+
+    if (bRunningDecisions)
+    {
+        Combatants[Slot] = nullptr;
+        bHasStaleSlots = true;
+        return;
+    }
+
+    RemoveSlot(Slot);
+}
+
+void UCombatAISchedulerSubsystem::RemoveSlot(int32 Slot)
+{
+    // Swap-remove keeps the lists dense; the moved combatant takes over the freed slot
+    Combatants.RemoveAtSwap(Slot);
+    NextDecisionTimes.RemoveAtSwap(Slot);
+    LastDecisionTimes.RemoveAtSwap(Slot);
+    PlayerDistancesSquared.RemoveAtSwap(Slot);
+
+    if (Combatants.IsValidIndex(Slot))
+    {
+        if (UCombatSystem* Moved = Combatants[Slot].Get())
+        {
+            Moved->AIScheduleSlot = Slot;
+        }
+    }
+}
+
+void UCombatAISchedulerSubsystem::UpdatePriorities()
+{
+    TArray<FVector, TInlineAllocator<8>> PlayerLocations;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PlayerController = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            PlayerLocations.Add(ViewLocation);
+        }
+    }
+
+    for (int32 Slot = 0; Slot < Combatants.Num(); Slot++)
+    {
+        float NearestDistanceSquared = TNumericLimits<float>::Max();
+        if (const UCombatSystem* Combat = Combatants[Slot].Get())
+        {
+            const FVector Location = Combat->GetOwner()->GetActorLocation();
+            for (const FVector& PlayerLocation : PlayerLocations)
+            {
+                NearestDistanceSquared = FMath::Min(NearestDistanceSquared, static_cast<float>(FVector::DistSquared(Location, PlayerLocation)));
+            }
+        }
+        PlayerDistancesSquared[Slot] = NearestDistanceSquared;
+    }
+}
+
+float UCombatAISchedulerSubsystem::GetDecisionInterval(int32 Slot) const
+{
+    const bool bNearPlayer = PlayerDistancesSquared[Slot] < FMath::Square(NearPlayerDistance);
+    return 1.0f / FMath::Max(bNearPlayer ? DecisionRate : DistantDecisionRate, KINDA_SMALL_NUMBER);
+}
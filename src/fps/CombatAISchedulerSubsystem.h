@@ -0,0 +1,69 @@
+// CombatAISchedulerSubsystem.h
+// Combat AI Scheduler Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level scheduler that runs AI combat decisions under a per-frame time budget
+// Feature Context: Replaces the per-tick UpdateAICombat call every AI combat system made from TickComponent
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: UCombatSystem registers AI-owned combatants in BeginPlay; the scheduler calls their decisions at DecisionRate
+// Security: Game-thread only; combatants unregister on death and in EndPlay
+// Performance: Decision cost per frame is capped by FrameBudgetMicroseconds no matter how many AI are fighting
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatAISchedulerSubsystem.generated.h"
+
+// Forward declarations
+class UCombatSystem;
+
+// World-level AI combat decision scheduler
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatAISchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatAISchedulerSubsystem();
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Combatant registration, assigns the component's AIScheduleSlot
+    void RegisterCombatant(UCombatSystem* Combat);
+    void UnregisterCombatant(UCombatSystem* Combat);
+
+    int32 GetNumCombatants() const { return Combatants.Num(); }
+
+    // Decisions per second for AI within NearPlayerDistance of a player, and for the rest
+    float DecisionRate;
+    float DistantDecisionRate;
+
+    // Real time (µs) decisions may use per frame; at least one always runs so nobody starves
+    double FrameBudgetMicroseconds;
+
+private:
+    // Registered combatants, densely packed by slot, with their schedule alongside
+    TArray<TWeakObjectPtr<UCombatSystem>> Combatants;
+    TArray<double> NextDecisionTimes;
+    TArray<double> LastDecisionTimes;
+    TArray<float> PlayerDistancesSquared;
+
+    // Distance (uu) within which AI decide at DecisionRate
+    float NearPlayerDistance;
+
+    // Player distances are refreshed at this cadence rather than every frame
+    float PriorityUpdateInterval;
+    float PriorityTimer;
+
+    // Slots due this frame, reused across frames
+    TArray<int32> DueSlots;
+
+    // Decisions can kill other combatants; their slots are cleared then, and removed once the frame's decisions finish
+    bool bRunningDecisions;
+    bool bHasStaleSlots;
+
+    void RemoveSlot(int32 Slot);
+    void UpdatePriorities();
+    float GetDecisionInterval(int32 Slot) const;
+};
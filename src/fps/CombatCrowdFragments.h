@@ -0,0 +1,111 @@
+// CombatCrowdFragments.h
+// Combat Crowd Fragments Header for Celestial Syndicate
+// Quantum Documentation: Describes the MassEntity fragments of crowd combatants: health, weapon, team, target and grid slot
+// Feature Context: Lets distant or background AI fight as entities instead of AAICharacter actors with ticking UCombatSystems
+// Dependencies: Unreal Engine MassEntity, MassCommon (FTransformFragment)
+// Usage Example: Created by UCombatCrowdSubsystem::SpawnCombatant; processed by the CombatCrowd processor group
+// Security: Server-side simulation state only; nothing here replicates
+// Performance: Fragments are plain data laid out per archetype chunk, so processors stream them linearly
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "CombatCrowdFragments.generated.h"
+
+// Forward declarations
+class AActor;
+class UCombatSystem;
+
+namespace UE::CombatCrowd
+{
+    // Processor group every crowd combat processor executes in
+    const FName ProcessorGroupName = TEXT("CombatCrowd");
+}
+
+// Marks entities owned by UCombatCrowdSubsystem
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdTag : public FMassTag
+{
+    GENERATED_BODY()
+};
+
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdHealthFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    float Health = 100.0f;
+    float MaxHealth = 100.0f;
+    float Shield = 50.0f;
+    float ShieldCapacity = 50.0f;
+    float ShieldRechargeRate = 5.0f; // per s
+    float ShieldRechargeDelay = 3.0f; // s
+
+    // Since damage was last taken (s)
+    float TimeSinceDamage = 0.0f;
+};
+
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdTeamFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 TeamId = 0;
+
+    // Combatant id in UCombatTelemetrySubsystem, INDEX_NONE without one
+    int32 TelemetryId = INDEX_NONE;
+};
+
+// Weapon stats copied from the weapon definition table at spawn
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdWeaponFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 DefinitionIndex = 0;
+    float Damage = 100.0f;
+    float Range = 800.0f; // uu
+    float FireInterval = 0.1f; // s
+    float ReloadTime = 2.0f; // s
+    int32 MaxAmmo = 30;
+    int32 Ammo = 30;
+
+    // Until the next shot may fire, including any reload (s)
+    float Cooldown = 0.0f;
+};
+
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdTargetFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    // Either an entity or an actor combatant from the registry, never both
+    FMassEntityHandle Target;
+    TWeakObjectPtr<UCombatSystem> TargetCombatant;
+
+    // Target's slot in this frame's grid snapshot, INDEX_NONE when it has none
+    int32 TargetSlot = INDEX_NONE;
+
+    float CombatRange = 1000.0f; // uu
+    float RetargetCooldown = 0.0f; // s
+};
+
+// Slot in UCombatCrowdSubsystem's grid snapshot, rewritten every frame
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdGridFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 Slot = INDEX_NONE;
+};
+
+// Actor spawned when the entity is promoted near a player; entities without one stay crowd-only
+USTRUCT()
+struct CELESTIALSYNDICATE_API FCombatCrowdActorFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TSubclassOf<AActor> ActorClass;
+};
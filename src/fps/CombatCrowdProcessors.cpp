@@ -0,0 +1,405 @@
+// CombatCrowdProcessors.cpp
+// Combat Crowd Processors for Celestial Syndicate
+// Quantum Documentation: Implements the per-frame crowd combat pipeline: grid, targeting, weapons, damage
+// Feature Context: Simulates crowd combatants without actors, components or timers
+// Dependencies: Unreal Engine MassEntity, MassCommon, CombatCrowdFragments, CombatCrowdSubsystem, CombatRegistrySubsystem, CombatSystem, CombatTelemetrySubsystem
+// Usage Example: Grid runs first; targeting, weapons and damage each execute after the previous processor
+// Security: Targets and damage are resolved through this frame's snapshot slots, never through stale entity pointers
+// Performance: The grid pass is single-threaded and linear; the three others run chunk-parallel, actor damage is applied after the chunks
+
+#include "CombatCrowdProcessors.h"
+#include "CombatCrowdFragments.h"
+#include "CombatProfiling.h"
+#include "CombatCrowdSubsystem.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "CombatTelemetrySubsystem.h"
+#include "Engine/World.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+
+namespace
+{
+    UCombatCrowdSubsystem* GetCrowdSubsystem(const FMassEntityManager& EntityManager)
+    {
+        const UWorld* World = EntityManager.GetWorld();
+        return World ? World->GetSubsystem<UCombatCrowdSubsystem>() : nullptr;
+    }
+
+    UCombatTelemetrySubsystem* GetTelemetrySubsystem(const FMassEntityManager& EntityManager)
+    {
+        const UWorld* World = EntityManager.GetWorld();
+        return World ? World->GetSubsystem<UCombatTelemetrySubsystem>() : nullptr;
+    }
+
+    constexpr int32 SimulationExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Standalone);
+}
+
+UCombatCrowdGridProcessor::UCombatCrowdGridProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = SimulationExecutionFlags;
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteInGroup = UE::CombatCrowd::ProcessorGroupName;
+
+    // Reads actor locations and combat state
+    bRequiresGameThreadExecution = true;
+}
+
+void UCombatCrowdGridProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTeamFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdHealthFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTargetFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdGridFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FCombatCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UCombatCrowdGridProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    CELESTIAL_COMBAT_SCOPE(CrowdGrid);
+
+    UCombatCrowdSubsystem* Crowd = GetCrowdSubsystem(EntityManager);
+    if (!Crowd)
+    {
+        return;
+    }
+
+    Crowd->Cells.Reset();
+    Crowd->SlotsByEntity.Reset();
+    Crowd->SlotsByCombatant.Reset();
+    Crowd->CombatantSlots.Reset();
+    ScratchCells.Reset();
+    ScratchCombatants.Reset();
+
+    // Registry actors, the player's side and promoted crowd alike, are targets too while any entity could engage them
+    const UCombatRegistrySubsystem* Registry = EntityManager.GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (Registry && EntityQuery.GetNumMatchingEntities(EntityManager) > 0)
+    {
+        for (UCombatSystem* Combat : Registry->GetAllCombatants())
+        {
+            if (Combat->IsAlive())
+            {
+                const FIntVector Key = Crowd->GetCellKey(Combat->GetOwner()->GetActorLocation());
+                ScratchCombatants.Emplace(Combat, Key);
+                Crowd->Cells.FindOrAdd(Key, { 0, 0 }).Count++;
+            }
+        }
+    }
+
+    // Count entities per cell
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, Crowd](FMassExecutionContext& Context)
+    {
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        for (int32 i = 0; i < Context.GetNumEntities(); i++)
+        {
+            const FIntVector Key = Crowd->GetCellKey(Transforms[i].GetTransform().GetLocation());
+            ScratchCells.Add(Key);
+            Crowd->Cells.FindOrAdd(Key, { 0, 0 }).Count++;
+        }
+    });
+
+    // Give each cell its contiguous range
+    int32 NumSlots = 0;
+    for (TPair<FIntVector, FCombatGridCell>& Pair : Crowd->Cells)
+    {
+        Pair.Value.Start = NumSlots;
+        NumSlots += Pair.Value.Count;
+        Pair.Value.Count = 0;
+    }
+
+    Crowd->NumCrowdEntities = ScratchCells.Num();
+    Crowd->Positions.SetNumUninitialized(NumSlots);
+    Crowd->Teams.SetNumUninitialized(NumSlots);
+    Crowd->HealthFractions.SetNumUninitialized(NumSlots);
+    Crowd->Entities.SetNumUninitialized(NumSlots);
+    Crowd->Combatants.SetNumUninitialized(NumSlots);
+    Crowd->CurrentTargets.SetNumUninitialized(NumSlots);
+    Crowd->CurrentCombatantTargets.SetNumUninitialized(NumSlots);
+    Crowd->PendingDamage.Reset();
+    Crowd->PendingDamage.SetNumZeroed(NumSlots);
+    Crowd->PendingAttackers.Init(INDEX_NONE, NumSlots);
+    Crowd->SlotsByEntity.Reserve(Crowd->NumCrowdEntities);
+    Crowd->SlotsByCombatant.Reserve(ScratchCombatants.Num());
+
+    // Scatter into cell order; the query visits entities in the same order as the counting pass
+    int32 Gathered = 0;
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, Crowd, &Gathered](FMassExecutionContext& Context)
+    {
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        const TConstArrayView<FCombatCrowdTeamFragment> Teams = Context.GetFragmentView<FCombatCrowdTeamFragment>();
+        const TConstArrayView<FCombatCrowdHealthFragment> Healths = Context.GetFragmentView<FCombatCrowdHealthFragment>();
+        const TConstArrayView<FCombatCrowdTargetFragment> Targets = Context.GetFragmentView<FCombatCrowdTargetFragment>();
+        const TArrayView<FCombatCrowdGridFragment> Grids = Context.GetMutableFragmentView<FCombatCrowdGridFragment>();
+
+        for (int32 i = 0; i < Context.GetNumEntities(); i++)
+        {
+            FCombatGridCell& Cell = Crowd->Cells.FindChecked(ScratchCells[Gathered++]);
+            const int32 Slot = Cell.Start + Cell.Count++;
+
+            Crowd->Positions[Slot] = Transforms[i].GetTransform().GetLocation();
+            Crowd->Teams[Slot] = Teams[i].TeamId;
+            Crowd->HealthFractions[Slot] = Healths[i].MaxHealth > 0.0f ? Healths[i].Health / Healths[i].MaxHealth : 0.0f;
+            Crowd->Entities[Slot] = Context.GetEntity(i);
+            Crowd->Combatants[Slot] = nullptr;
+            Crowd->CurrentTargets[Slot] = Targets[i].Target;
+            Crowd->CurrentCombatantTargets[Slot] = Targets[i].TargetCombatant;
+            Crowd->SlotsByEntity.Add(Context.GetEntity(i), Slot);
+            Grids[i].Slot = Slot;
+        }
+    });
+
+    for (const TPair<UCombatSystem*, FIntVector>& Sample : ScratchCombatants)
+    {
+        UCombatSystem* Combat = Sample.Key;
+        FCombatGridCell& Cell = Crowd->Cells.FindChecked(Sample.Value);
+        const int32 Slot = Cell.Start + Cell.Count++;
+
+        // Actors carry no entity target, so they never earn an entity's threat bonus
+        Crowd->Positions[Slot] = Combat->GetOwner()->GetActorLocation();
+        Crowd->Teams[Slot] = Combat->GetTeamId();
+        Crowd->HealthFractions[Slot] = Combat->GetMaxHealth() > 0.0f ? Combat->GetCurrentHealth() / Combat->GetMaxHealth() : 0.0f;
+        Crowd->Entities[Slot] = FMassEntityHandle();
+        Crowd->Combatants[Slot] = Combat;
+        Crowd->CurrentTargets[Slot] = FMassEntityHandle();
+        Crowd->CurrentCombatantTargets[Slot] = nullptr;
+        Crowd->SlotsByCombatant.Add(Combat, Slot);
+        Crowd->CombatantSlots.Add(Slot);
+    }
+}
+
+UCombatCrowdTargetingProcessor::UCombatCrowdTargetingProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = SimulationExecutionFlags;
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteInGroup = UE::CombatCrowd::ProcessorGroupName;
+    ExecutionOrder.ExecuteAfter.Add(UCombatCrowdGridProcessor::StaticClass()->GetFName());
+}
+
+void UCombatCrowdTargetingProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTeamFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTargetFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FCombatCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UCombatCrowdTargetingProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    CELESTIAL_COMBAT_SCOPE(CrowdTargeting);
+
+    const UCombatCrowdSubsystem* Crowd = GetCrowdSubsystem(EntityManager);
+    if (!Crowd)
+    {
+        return;
+    }
+
+    EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Crowd](FMassExecutionContext& Context)
+    {
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        const TConstArrayView<FCombatCrowdTeamFragment> Teams = Context.GetFragmentView<FCombatCrowdTeamFragment>();
+        const TArrayView<FCombatCrowdTargetFragment> Targets = Context.GetMutableFragmentView<FCombatCrowdTargetFragment>();
+
+        for (int32 i = 0; i < Context.GetNumEntities(); i++)
+        {
+            FCombatCrowdTargetFragment& Target = Targets[i];
+
+            // Dead, promoted or demoted targets have no slot this frame
+            const bool bHasTarget = Target.Target.IsSet() || !Target.TargetCombatant.IsExplicitlyNull();
+            const int32* TargetSlot = Target.Target.IsSet() ? Crowd->SlotsByEntity.Find(Target.Target)
+                : bHasTarget ? Crowd->SlotsByCombatant.Find(Target.TargetCombatant) : nullptr;
+            Target.TargetSlot = TargetSlot ? *TargetSlot : INDEX_NONE;
+            Target.RetargetCooldown -= DeltaTime;
+
+            if (Target.RetargetCooldown <= 0.0f || (bHasTarget && Target.TargetSlot == INDEX_NONE))
+            {
+                Target.TargetSlot = Crowd->FindBestTarget(Context.GetEntity(i), Transforms[i].GetTransform().GetLocation(), Teams[i].TeamId, Target.CombatRange);
+                Target.Target = Target.TargetSlot != INDEX_NONE ? Crowd->Entities[Target.TargetSlot] : FMassEntityHandle();
+                Target.TargetCombatant = Target.TargetSlot != INDEX_NONE ? Crowd->Combatants[Target.TargetSlot] : nullptr;
+                Target.RetargetCooldown = Crowd->RetargetInterval;
+            }
+        }
+    });
+}
+
+UCombatCrowdWeaponProcessor::UCombatCrowdWeaponProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = SimulationExecutionFlags;
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteInGroup = UE::CombatCrowd::ProcessorGroupName;
+    ExecutionOrder.ExecuteAfter.Add(UCombatCrowdTargetingProcessor::StaticClass()->GetFName());
+}
+
+void UCombatCrowdWeaponProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTeamFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTargetFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdWeaponFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FCombatCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UCombatCrowdWeaponProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    CELESTIAL_COMBAT_SCOPE(CrowdWeapons);
+
+    UCombatCrowdSubsystem* Crowd = GetCrowdSubsystem(EntityManager);
+    if (!Crowd)
+    {
+        return;
+    }
+    UCombatTelemetrySubsystem* Telemetry = GetTelemetrySubsystem(EntityManager);
+
+    EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Crowd, Telemetry](FMassExecutionContext& Context)
+    {
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        const TConstArrayView<FCombatCrowdTeamFragment> Teams = Context.GetFragmentView<FCombatCrowdTeamFragment>();
+        const TConstArrayView<FCombatCrowdTargetFragment> Targets = Context.GetFragmentView<FCombatCrowdTargetFragment>();
+        const TArrayView<FCombatCrowdWeaponFragment> Weapons = Context.GetMutableFragmentView<FCombatCrowdWeaponFragment>();
+
+        // Target slot, damage, shooter's telemetry id
+        TArray<TTuple<int32, float, int32>, TInlineAllocator<64>> ChunkDamage;
+        for (int32 i = 0; i < Context.GetNumEntities(); i++)
+        {
+            FCombatCrowdWeaponFragment& Weapon = Weapons[i];
+            Weapon.Cooldown = FMath::Max(Weapon.Cooldown - DeltaTime, 0.0f);
+
+            const int32 TargetSlot = Targets[i].TargetSlot;
+            if (Weapon.Cooldown > 0.0f || TargetSlot == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const float Distance = FVector::Dist(Transforms[i].GetTransform().GetLocation(), Crowd->Positions[TargetSlot]);
+            if (Distance > Weapon.Range)
+            {
+                continue;
+            }
+
+            // Distance falloff as in UCombatSystem::CalculateDamage; crowd hits carry no bone multiplier
+            const float Damage = Weapon.Damage * FMath::Max(0.5f, 1.0f - Distance / Weapon.Range);
+            const int32 ShooterId = Teams[i].TelemetryId;
+            ChunkDamage.Emplace(TargetSlot, Damage, ShooterId);
+
+            // Crowd shots always hit; targets record the damage they take when it lands
+            if (Telemetry)
+            {
+                Telemetry->RecordEvent(ECombatTelemetryEventType::Shot, ShooterId, INDEX_NONE);
+                Telemetry->RecordEvent(ECombatTelemetryEventType::Hit, ShooterId, INDEX_NONE);
+                Telemetry->RecordEvent(ECombatTelemetryEventType::Damage, ShooterId, INDEX_NONE, Damage);
+            }
+
+            Weapon.Cooldown = Weapon.FireInterval;
+            if (--Weapon.Ammo <= 0)
+            {
+                Weapon.Ammo = Weapon.MaxAmmo;
+                Weapon.Cooldown = Weapon.ReloadTime;
+            }
+        }
+
+        if (ChunkDamage.Num() > 0)
+        {
+            FScopeLock Lock(&Crowd->DamageLock);
+            for (const TTuple<int32, float, int32>& Hit : ChunkDamage)
+            {
+                Crowd->PendingDamage[Hit.Get<0>()] += Hit.Get<1>();
+                Crowd->PendingAttackers[Hit.Get<0>()] = Hit.Get<2>();
+            }
+        }
+    });
+}
+
+UCombatCrowdDamageProcessor::UCombatCrowdDamageProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = SimulationExecutionFlags;
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteInGroup = UE::CombatCrowd::ProcessorGroupName;
+    ExecutionOrder.ExecuteAfter.Add(UCombatCrowdWeaponProcessor::StaticClass()->GetFName());
+
+    // Damage on actor targets goes through UCombatSystem once the chunks finish
+    bRequiresGameThreadExecution = true;
+}
+
+void UCombatCrowdDamageProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FCombatCrowdGridFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdTeamFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FCombatCrowdHealthFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FCombatCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UCombatCrowdDamageProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    CELESTIAL_COMBAT_SCOPE(CrowdDamage);
+
+    const UCombatCrowdSubsystem* Crowd = GetCrowdSubsystem(EntityManager);
+    if (!Crowd)
+    {
+        return;
+    }
+    UCombatTelemetrySubsystem* Telemetry = GetTelemetrySubsystem(EntityManager);
+
+    EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Crowd, Telemetry](FMassExecutionContext& Context)
+    {
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+        const TConstArrayView<FCombatCrowdGridFragment> Grids = Context.GetFragmentView<FCombatCrowdGridFragment>();
+        const TConstArrayView<FCombatCrowdTeamFragment> Teams = Context.GetFragmentView<FCombatCrowdTeamFragment>();
+        const TArrayView<FCombatCrowdHealthFragment> Healths = Context.GetMutableFragmentView<FCombatCrowdHealthFragment>();
+
+        for (int32 i = 0; i < Context.GetNumEntities(); i++)
+        {
+            FCombatCrowdHealthFragment& Health = Healths[i];
+            Health.TimeSinceDamage += DeltaTime;
+
+            // Entities spawned after this frame's grid pass have no slot yet
+            const int32 Slot = Grids[i].Slot;
+            float Damage = Crowd->PendingDamage.IsValidIndex(Slot) ? Crowd->PendingDamage[Slot] : 0.0f;
+            const bool bHit = Damage > 0.0f;
+            if (bHit)
+            {
+                if (Telemetry)
+                {
+                    Telemetry->RecordEvent(ECombatTelemetryEventType::Damage, INDEX_NONE, Teams[i].TelemetryId, Damage);
+                }
+
+                const float ShieldDamage = FMath::Min(Damage, Health.Shield);
+                Health.Shield -= ShieldDamage;
+                Damage -= ShieldDamage;
+                Health.Health = FMath::Max(0.0f, Health.Health - Damage);
+                Health.TimeSinceDamage = 0.0f;
+            }
+
+            if (Health.Health <= 0.0f)
+            {
+                // Credits the killing frame's shooter, once: the entity is gone next frame
+                if (Telemetry && bHit)
+                {
+                    Telemetry->RecordEvent(ECombatTelemetryEventType::Kill, Crowd->PendingAttackers[Slot], Teams[i].TelemetryId);
+                }
+                Context.Defer().DestroyEntity(Context.GetEntity(i));
+                continue;
+            }
+
+            if (Health.TimeSinceDamage >= Health.ShieldRechargeDelay && Health.Shield < Health.ShieldCapacity)
+            {
+                Health.Shield = FMath::Min(Health.ShieldCapacity, Health.Shield + Health.ShieldRechargeRate * DeltaTime);
+            }
+        }
+    });
+
+    // Crowd fire has no causing actor; TakeCrowdDamage ignores actors that died since the grid pass
+    for (const int32 Slot : Crowd->CombatantSlots)
+    {
+        UCombatSystem* Combat = Crowd->PendingDamage[Slot] > 0.0f ? Crowd->Combatants[Slot].Get() : nullptr;
+        if (Combat)
+        {
+            Combat->TakeCrowdDamage(Crowd->PendingDamage[Slot], Crowd->PendingAttackers[Slot]);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// CombatCrowdProcessors.h
+// Combat Crowd Processors Header for Celestial Syndicate
+// Quantum Documentation: Describes the grid, targeting, weapon and damage processors that simulate crowd combatants
+// Feature Context: Entity counterparts of UCombatTargetingSubsystem queries, UCombatSystem::FireWeapon and TakeDamage
+// Dependencies: Unreal Engine MassEntity, MassCommon, CombatCrowdFragments, CombatCrowdSubsystem, CombatRegistrySubsystem, CombatSystem
+// Usage Example: Registered automatically; they run in the CombatCrowd group whenever crowd entities exist
+// Security: Server and standalone only; cross-entity writes go through the subsystem's per-slot damage buffer
+// Performance: Everything but the grid rebuild runs as parallel chunks; a chunk takes the damage lock once
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "CombatCrowdProcessors.generated.h"
+
+// Forward declarations
+class UCombatSystem;
+
+// Rebuilds UCombatCrowdSubsystem's cell-ordered snapshot of entities and registry actors and writes each entity's slot
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatCrowdGridProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UCombatCrowdGridProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+
+    // Cell key of each gathered entity, in query order
+    TArray<FIntVector> ScratchCells;
+
+    // Live registry combatant and cell key of each gathered actor
+    TArray<TPair<UCombatSystem*, FIntVector>> ScratchCombatants;
+};
+
+// Resolves target slots and re-picks targets every RetargetInterval
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatCrowdTargetingProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UCombatCrowdTargetingProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+// Fires at targets in weapon range, accumulates the damage per target slot and records shots in combat telemetry
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatCrowdWeaponProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UCombatCrowdWeaponProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+// Applies accumulated damage to shield then health, regenerates shields and destroys the dead; actor targets take theirs through UCombatSystem::TakeCrowdDamage
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatCrowdDamageProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UCombatCrowdDamageProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
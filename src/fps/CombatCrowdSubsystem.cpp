@@ -0,0 +1,386 @@
+// CombatCrowdSubsystem.cpp
+// Combat Crowd Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements crowd combatant spawning, the shared target scoring, and promotion to and from actors
+// Feature Context: Keeps large AI battles as entities and hands players real UCombatSystem actors up close
+// Dependencies: Unreal Engine world subsystems, MassEntity, MassCommon, WeaponDefinitions, CombatRegistrySubsystem, CombatSystem, CombatTelemetrySubsystem
+// Usage Example: Ticked by the world once per frame; idle until SpawnCombatant creates the first entity
+// Security: Promotion and demotion carry health, shield, team, weapon and ammo, so switching modes never heals or re-arms
+// Performance: Each check scans only the grid cells around players; at most MaxPromotionsPerFrame actors spawn per frame
+
+#include "CombatCrowdSubsystem.h"
+#include "CombatCrowdFragments.h"
+#include "CombatProfiling.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "CombatTelemetrySubsystem.h"
+#include "WeaponDefinitions.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+
+DECLARE_CELESTIAL_COMBAT_COUNTER(CrowdEntities);
+DECLARE_CELESTIAL_COMBAT_COUNTER(CrowdPromotedActors);
+
+namespace
+{
+    // Same weights as UCombatTargetingSubsystem, so entities and actors choose targets alike
+    constexpr float DistanceScoreWeight = 1000.0f;
+    constexpr float MissingHealthScoreWeight = 500.0f;
+    constexpr float ThreatScoreBonus = 300.0f;
+}
+
+UCombatCrowdSubsystem::UCombatCrowdSubsystem()
+{
+    WeaponDefinitions = nullptr;
+    CellSize = 1000.0f; // uu
+    PromotionDistance = 8000.0f; // uu
+    DemotionDistance = 12000.0f; // uu
+    PromotionCheckInterval = 0.25f; // s
+    MaxPromotionsPerFrame = 4;
+    RetargetInterval = 0.5f; // s
+    NextPromotionCheckTime = 0.0;
+    NumCrowdEntities = 0;
+}
+
+void UCombatCrowdSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    Collection.InitializeDependency<UMassEntitySubsystem>();
+}
+
+void UCombatCrowdSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatCrowdPromotion);
+    SET_CELESTIAL_COMBAT_COUNTER(CrowdEntities, NumCrowdEntities);
+    SET_CELESTIAL_COMBAT_COUNTER(CrowdPromotedActors, PromotedActors.Num());
+
+    if (!IsSimulating() || (NumCrowdEntities == 0 && PromotedActors.Num() == 0 && PromotionQueue.Num() == 0))
+    {
+        return;
+    }
+
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!EntityManager)
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now >= NextPromotionCheckTime)
+    {
+        NextPromotionCheckTime = Now + PromotionCheckInterval;
+
+        TArray<FVector, TInlineAllocator<8>> PlayerLocations;
+        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+        {
+            const APlayerController* Controller = It->Get();
+            if (const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr)
+            {
+                PlayerLocations.Add(Pawn->GetActorLocation());
+            }
+        }
+
+        TSet<const UCombatSystem*> CrowdEngaged;
+        QueuePromotions(PlayerLocations);
+        QueueEngagingEntities(PlayerLocations, CrowdEngaged);
+        DemoteActors(PlayerLocations, CrowdEngaged);
+    }
+
+    // Spread actor spawns over frames
+    const int32 NumToPromote = FMath::Min(PromotionQueue.Num(), MaxPromotionsPerFrame);
+    for (int32 i = 0; i < NumToPromote; i++)
+    {
+        PromoteEntity(*EntityManager, PromotionQueue[i]);
+    }
+    PromotionQueue.RemoveAt(0, NumToPromote, false);
+}
+
+TStatId UCombatCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatCrowdSubsystem, STATGROUP_Tickables);
+}
+
+FMassEntityHandle UCombatCrowdSubsystem::SpawnCombatant(const FTransform& Transform, const FCombatCrowdState& State, TSubclassOf<AActor> ActorClass)
+{
+    FMassEntityManager* EntityManager = IsSimulating() ? GetEntityManager() : nullptr;
+    if (!EntityManager)
+    {
+        return FMassEntityHandle();
+    }
+
+    // Game thread, outside Mass processing
+    check(IsInGameThread());
+
+    if (!CombatantArchetype.IsValid())
+    {
+        CombatantArchetype = EntityManager->CreateArchetype({
+            FTransformFragment::StaticStruct(),
+            FCombatCrowdHealthFragment::StaticStruct(),
+            FCombatCrowdTeamFragment::StaticStruct(),
+            FCombatCrowdWeaponFragment::StaticStruct(),
+            FCombatCrowdTargetFragment::StaticStruct(),
+            FCombatCrowdGridFragment::StaticStruct(),
+            FCombatCrowdActorFragment::StaticStruct(),
+            FCombatCrowdTag::StaticStruct() });
+    }
+
+    const FMassEntityHandle Entity = EntityManager->CreateEntity(CombatantArchetype);
+    EntityManager->GetFragmentDataChecked<FTransformFragment>(Entity).SetTransform(Transform);
+
+    FCombatCrowdHealthFragment& Health = EntityManager->GetFragmentDataChecked<FCombatCrowdHealthFragment>(Entity);
+    Health.MaxHealth = State.MaxHealth;
+    Health.Health = FMath::Clamp(State.Health, 0.0f, State.MaxHealth);
+    Health.ShieldCapacity = State.ShieldCapacity;
+    Health.Shield = FMath::Clamp(State.Shield, 0.0f, State.ShieldCapacity);
+
+    FCombatCrowdTeamFragment& Team = EntityManager->GetFragmentDataChecked<FCombatCrowdTeamFragment>(Entity);
+    Team.TeamId = State.TeamId;
+    if (UCombatTelemetrySubsystem* Telemetry = GetWorld()->GetSubsystem<UCombatTelemetrySubsystem>())
+    {
+        const FString Name = FString::Printf(TEXT("%s_Crowd%d"), ActorClass ? *ActorClass->GetName() : TEXT("Combatant"), Entity.Index);
+        Team.TelemetryId = Telemetry->RegisterCombatant(Name, State.TeamId);
+    }
+    EntityManager->GetFragmentDataChecked<FCombatCrowdTargetFragment>(Entity).CombatRange = State.CombatRange;
+    EntityManager->GetFragmentDataChecked<FCombatCrowdActorFragment>(Entity).ActorClass = ActorClass;
+
+    const UWeaponDefinitionSet* Definitions = WeaponDefinitions ? WeaponDefinitions : GetDefault<UWeaponDefinitionSet>();
+    const FWeaponDefinitionTablePtr Table = Definitions->GetWeaponTable();
+    FCombatCrowdWeaponFragment& Weapon = EntityManager->GetFragmentDataChecked<FCombatCrowdWeaponFragment>(Entity);
+    if (const FWeaponData* Data = Table.IsValid() ? Table->Find(State.WeaponIndex) : nullptr)
+    {
+        Weapon.DefinitionIndex = State.WeaponIndex;
+        Weapon.Damage = Data->Damage;
+        Weapon.Range = Data->Range;
+        Weapon.FireInterval = Data->FireRate;
+        Weapon.ReloadTime = Data->ReloadTime;
+        Weapon.MaxAmmo = Data->MaxAmmo;
+    }
+    Weapon.Ammo = State.Ammo >= 0 ? FMath::Min(State.Ammo, Weapon.MaxAmmo) : Weapon.MaxAmmo;
+
+    return Entity;
+}
+
+FIntVector UCombatCrowdSubsystem::GetCellKey(const FVector& Position) const
+{
+    const FVector Cell = Position / CellSize;
+    return FIntVector(FMath::FloorToInt32(Cell.X), FMath::FloorToInt32(Cell.Y), FMath::FloorToInt32(Cell.Z));
+}
+
+int32 UCombatCrowdSubsystem::FindBestTarget(FMassEntityHandle Self, const FVector& Origin, int32 TeamId, float Range) const
+{
+    const FIntVector MinCell = GetCellKey(Origin - FVector(Range));
+    const FIntVector MaxCell = GetCellKey(Origin + FVector(Range));
+    const float RangeSquared = Range * Range;
+
+    int32 BestSlot = INDEX_NONE;
+    float BestScore = 0.0f;
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            {
+                const FCombatGridCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+                if (!Cell)
+                {
+                    continue;
+                }
+
+                const int32 End = Cell->Start + Cell->Count;
+                for (int32 i = Cell->Start; i < End; i++)
+                {
+                    if (Teams[i] == TeamId || HealthFractions[i] <= 0.0f)
+                    {
+                        continue;
+                    }
+
+                    const float DistanceSquared = FVector::DistSquared(Origin, Positions[i]);
+                    if (DistanceSquared > RangeSquared)
+                    {
+                        continue;
+                    }
+
+                    // Closer, weaker and already-engaged targets score higher
+                    float Score = DistanceScoreWeight / (FMath::Sqrt(DistanceSquared) + 1.0f);
+                    Score += (1.0f - HealthFractions[i]) * MissingHealthScoreWeight;
+                    if (CurrentTargets[i] == Self)
+                    {
+                        Score += ThreatScoreBonus;
+                    }
+
+                    if (Score > BestScore)
+                    {
+                        BestScore = Score;
+                        BestSlot = i;
+                    }
+                }
+            }
+        }
+    }
+
+    return BestSlot;
+}
+
+FMassEntityManager* UCombatCrowdSubsystem::GetEntityManager() const
+{
+    UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+    return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+bool UCombatCrowdSubsystem::IsSimulating() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+void UCombatCrowdSubsystem::QueuePromotions(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations)
+{
+    const float DistanceSquared = PromotionDistance * PromotionDistance;
+
+    for (const FVector& Location : PlayerLocations)
+    {
+        const FIntVector MinCell = GetCellKey(Location - FVector(PromotionDistance));
+        const FIntVector MaxCell = GetCellKey(Location + FVector(PromotionDistance));
+
+        for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+            {
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+                {
+                    const FCombatGridCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+                    if (!Cell)
+                    {
+                        continue;
+                    }
+
+                    const int32 End = Cell->Start + Cell->Count;
+                    for (int32 i = Cell->Start; i < End; i++)
+                    {
+                        if (Entities[i].IsSet() && FVector::DistSquared(Location, Positions[i]) <= DistanceSquared)
+                        {
+                            PromotionQueue.AddUnique(Entities[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void UCombatCrowdSubsystem::QueueEngagingEntities(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations, TSet<const UCombatSystem*>& OutCrowdEngaged)
+{
+    const float DistanceSquared = DemotionDistance * DemotionDistance;
+
+    for (int32 i = 0; i < Entities.Num(); i++)
+    {
+        const int32* CombatantSlot = Entities[i].IsSet() && CurrentCombatantTargets[i].IsValid() ? SlotsByCombatant.Find(CurrentCombatantTargets[i]) : nullptr;
+        if (!CombatantSlot)
+        {
+            continue;
+        }
+
+        // Actors only fight actors, so an entity engaging one inside the player bubble becomes one
+        const FVector& Location = Positions[*CombatantSlot];
+        const bool bNearPlayer = PlayerLocations.ContainsByPredicate([&Location, DistanceSquared](const FVector& PlayerLocation)
+        {
+            return FVector::DistSquared(Location, PlayerLocation) <= DistanceSquared;
+        });
+        if (bNearPlayer)
+        {
+            PromotionQueue.AddUnique(Entities[i]);
+        }
+        else
+        {
+            OutCrowdEngaged.Add(Combatants[*CombatantSlot].Get());
+        }
+    }
+}
+
+void UCombatCrowdSubsystem::PromoteEntity(FMassEntityManager& EntityManager, FMassEntityHandle Entity)
+{
+    if (!EntityManager.IsEntityValid(Entity))
+    {
+        return;
+    }
+
+    const FCombatCrowdActorFragment& ActorFragment = EntityManager.GetFragmentDataChecked<FCombatCrowdActorFragment>(Entity);
+    const FCombatCrowdHealthFragment& Health = EntityManager.GetFragmentDataChecked<FCombatCrowdHealthFragment>(Entity);
+    if (!ActorFragment.ActorClass || Health.Health <= 0.0f)
+    {
+        return;
+    }
+
+    const FCombatCrowdWeaponFragment& Weapon = EntityManager.GetFragmentDataChecked<FCombatCrowdWeaponFragment>(Entity);
+
+    FCombatCrowdState State;
+    State.Health = Health.Health;
+    State.MaxHealth = Health.MaxHealth;
+    State.Shield = Health.Shield;
+    State.ShieldCapacity = Health.ShieldCapacity;
+    State.TeamId = EntityManager.GetFragmentDataChecked<FCombatCrowdTeamFragment>(Entity).TeamId;
+    State.WeaponIndex = Weapon.DefinitionIndex;
+    State.Ammo = Weapon.Ammo;
+    State.CombatRange = EntityManager.GetFragmentDataChecked<FCombatCrowdTargetFragment>(Entity).CombatRange;
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    const FTransform Transform = EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetTransform();
+    AActor* Actor = GetWorld()->SpawnActor<AActor>(ActorFragment.ActorClass, Transform, SpawnParams);
+    if (!Actor)
+    {
+        return;
+    }
+
+    const UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (UCombatSystem* Combat = Registry ? Registry->FindCombatSystem(Actor) : nullptr)
+    {
+        Combat->ApplyCrowdState(State);
+    }
+
+    PromotedActors.Add(Actor);
+    EntityManager.Defer().DestroyEntity(Entity);
+}
+
+void UCombatCrowdSubsystem::DemoteActors(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations, const TSet<const UCombatSystem*>& CrowdEngaged)
+{
+    const UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    const float DistanceSquared = DemotionDistance * DemotionDistance;
+
+    for (int32 i = PromotedActors.Num() - 1; i >= 0; i--)
+    {
+        AActor* Actor = PromotedActors[i].Get();
+        UCombatSystem* Combat = Actor && Registry ? Registry->FindCombatSystem(Actor) : nullptr;
+
+        // Dead actors play out their own death; they are no longer ours to return
+        if (!Combat || !Combat->IsAlive())
+        {
+            PromotedActors.RemoveAtSwap(i);
+            continue;
+        }
+
+        // Out past the bubble, actors the crowd is shooting cannot shoot back; they finish the fight as entities
+        if (Combat->IsInCombat() && !CrowdEngaged.Contains(Combat))
+        {
+            continue;
+        }
+
+        const FVector Location = Actor->GetActorLocation();
+        const bool bNearPlayer = PlayerLocations.ContainsByPredicate([&Location, DistanceSquared](const FVector& PlayerLocation)
+        {
+            return FVector::DistSquared(Location, PlayerLocation) <= DistanceSquared;
+        });
+        if (bNearPlayer)
+        {
+            continue;
+        }
+
+        SpawnCombatant(Actor->GetActorTransform(), Combat->GetCrowdState(), Actor->GetClass());
+        PromotedActors.RemoveAtSwap(i);
+        Actor->Destroy();
+    }
+}
@@ -0,0 +1,106 @@
+// CombatCrowdSubsystem.h
+// Combat Crowd Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes crowd combatant spawning, the grid snapshot crowd processors share, and actor promotion
+// Feature Context: Optional MassEntity mode for thousands of background combatants; only those near players become actors
+// Dependencies: Unreal Engine world subsystems, MassEntity, MassCommon, WeaponDefinitions, CombatRegistrySubsystem, CombatSystem
+// Usage Example: CrowdSubsystem->SpawnCombatant(Transform, State, AFleetTrooper::StaticClass())
+// Security: Server and standalone only; clients see promoted actors through normal replication
+// Performance: Promotion and demotion are rate-limited; the snapshot is rebuilt once per frame in cell order
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "HAL/CriticalSection.h"
+#include "CombatTargetingSubsystem.h"
+#include "CombatCrowdSubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class UCombatSystem;
+class UWeaponDefinitionSet;
+struct FCombatCrowdState;
+struct FMassEntityManager;
+
+// World-level owner of crowd combat entities
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatCrowdSubsystem();
+
+    // USubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Creates a crowd combatant; ActorClass, which needs a UCombatSystem, is what it becomes near players
+    FMassEntityHandle SpawnCombatant(const FTransform& Transform, const FCombatCrowdState& State, TSubclassOf<AActor> ActorClass);
+
+    int32 GetNumCrowdCombatants() const { return NumCrowdEntities; }
+    int32 GetNumPromotedActors() const { return PromotedActors.Num(); }
+
+    // Weapon stats for new entities; the default definition set when unset
+    UPROPERTY()
+    UWeaponDefinitionSet* WeaponDefinitions;
+
+    // Grid cell edge (uu), matching UCombatTargetingSubsystem
+    float CellSize;
+
+    // Entities within PromotionDistance of a player pawn become actors; promoted actors beyond DemotionDistance and out of combat return
+    float PromotionDistance; // uu
+    float DemotionDistance; // uu
+    float PromotionCheckInterval; // s
+    int32 MaxPromotionsPerFrame;
+
+    // Between target re-evaluations of one entity (s)
+    float RetargetInterval;
+
+private:
+    friend class UCombatCrowdGridProcessor;
+    friend class UCombatCrowdTargetingProcessor;
+    friend class UCombatCrowdWeaponProcessor;
+    friend class UCombatCrowdDamageProcessor;
+
+    // Snapshot written by the grid processor, read by the rest; one entry per live entity or registry actor in cell order.
+    // A slot holds either an entity or an actor combatant, the other handle is unset
+    TArray<FVector> Positions;
+    TArray<int32> Teams;
+    TArray<float> HealthFractions;
+    TArray<FMassEntityHandle> Entities;
+    TArray<TWeakObjectPtr<UCombatSystem>> Combatants;
+    TArray<FMassEntityHandle> CurrentTargets;
+    TArray<TWeakObjectPtr<UCombatSystem>> CurrentCombatantTargets;
+    TMap<FIntVector, FCombatGridCell> Cells;
+    TMap<FMassEntityHandle, int32> SlotsByEntity;
+    TMap<TWeakObjectPtr<UCombatSystem>, int32> SlotsByCombatant;
+    TArray<int32> CombatantSlots;
+    int32 NumCrowdEntities;
+
+    // Damage landing on each slot this frame; weapon chunks merge into it under DamageLock once per chunk.
+    // PendingAttackers holds the telemetry id of one shooter per slot, credited if the hit kills
+    TArray<float> PendingDamage;
+    TArray<int32> PendingAttackers;
+    FCriticalSection DamageLock;
+
+    FMassArchetypeHandle CombatantArchetype;
+
+    TArray<TWeakObjectPtr<AActor>> PromotedActors;
+    TArray<FMassEntityHandle> PromotionQueue;
+    double NextPromotionCheckTime;
+
+    FIntVector GetCellKey(const FVector& Position) const;
+    int32 FindBestTarget(FMassEntityHandle Self, const FVector& Origin, int32 TeamId, float Range) const;
+
+    FMassEntityManager* GetEntityManager() const;
+    bool IsSimulating() const;
+    void QueuePromotions(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations);
+    void QueueEngagingEntities(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations, TSet<const UCombatSystem*>& OutCrowdEngaged);
+    void PromoteEntity(FMassEntityManager& EntityManager, FMassEntityHandle Entity);
+    void DemoteActors(const TArray<FVector, TInlineAllocator<8>>& PlayerLocations, const TSet<const UCombatSystem*>& CrowdEngaged);
+};
@@ -0,0 +1,271 @@
+// CombatFeedbackSubsystem.cpp
+// Combat Feedback Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements the feedback pools, their per-frame caps and view-distance culling
+// Feature Context: Keeps sustained fire from creating and destroying a component or widget per hit
+// Dependencies: Unreal Engine world subsystems, particle and audio components, UMG, DamageNumber widget
+// Usage Example: Ticked by the world once per frame to reset caps, refresh local views and retire damage numbers
+// Security: Pools only ever hold ownerless cosmetic components registered with this world
+// Performance: A free entry is found by a round-robin scan; nothing is allocated once a pool reaches its size
+
+#include "CombatFeedbackSubsystem.h"
+#include "CombatProfiling.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/AudioComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+
+UCombatFeedbackSubsystem::UCombatFeedbackSubsystem()
+{
+    MaxPooledEffects = 64;
+    MaxPooledSounds = 32;
+    MaxPooledDamageNumbers = 16;
+
+    MaxEffectsPerFrame = 16;
+    MaxSoundsPerFrame = 12;
+    MaxDamageNumbersPerFrame = 8;
+
+    EffectCullDistance = 6000.0f; // uu
+    SoundCullDistance = 8000.0f; // uu
+    DamageNumberCullDistance = 3000.0f; // uu
+
+    DamageNumberLifetime = 1.0f; // s
+
+    NextEffect = 0;
+    NextSound = 0;
+    EffectsThisFrame = 0;
+    SoundsThisFrame = 0;
+    DamageNumbersThisFrame = 0;
+}
+
+void UCombatFeedbackSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatFeedback);
+
+    if (!IsFeedbackEnabled())
+    {
+        return;
+    }
+
+    EffectsThisFrame = 0;
+    SoundsThisFrame = 0;
+    DamageNumbersThisFrame = 0;
+
+    ViewLocations.Reset();
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ViewLocations.Add(ViewLocation);
+        }
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (FPooledDamageNumber& Entry : DamageNumberPool)
+    {
+        if (Entry.bInUse && Now >= Entry.ReleaseTime)
+        {
+            Entry.bInUse = false;
+            if (Entry.Widget)
+            {
+                Entry.Widget->SetVisibility(ESlateVisibility::Collapsed);
+            }
+        }
+    }
+}
+
+TStatId UCombatFeedbackSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatFeedbackSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatFeedbackSubsystem::SpawnEffect(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+    CELESTIAL_COMBAT_SCOPE(SpawnEffect);
+
+    if (!Template || !IsFeedbackEnabled() || EffectsThisFrame >= MaxEffectsPerFrame || !IsWithinView(Location, EffectCullDistance))
+    {
+        return false;
+    }
+
+    UParticleSystemComponent* Effect = AcquireEffect();
+    if (!Effect)
+    {
+        return false;
+    }
+
+    if (Effect->GetAttachParent())
+    {
+        Effect->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+    }
+    Effect->SetTemplate(Template);
+    Effect->SetWorldLocationAndRotation(Location, Rotation);
+    Effect->ActivateSystem(true);
+
+    EffectsThisFrame++;
+    return true;
+}
+
+bool UCombatFeedbackSubsystem::SpawnEffectAttached(UParticleSystem* Template, USceneComponent* AttachTo, FName SocketName)
+{
+    CELESTIAL_COMBAT_SCOPE(SpawnEffectAttached);
+
+    if (!Template || !AttachTo || !IsFeedbackEnabled() || EffectsThisFrame >= MaxEffectsPerFrame
+        || !IsWithinView(AttachTo->GetSocketLocation(SocketName), EffectCullDistance))
+    {
+        return false;
+    }
+
+    UParticleSystemComponent* Effect = AcquireEffect();
+    if (!Effect)
+    {
+        return false;
+    }
+
+    Effect->SetTemplate(Template);
+    Effect->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale, SocketName);
+    Effect->ActivateSystem(true);
+
+    EffectsThisFrame++;
+    return true;
+}
+
+bool UCombatFeedbackSubsystem::PlaySound(USoundBase* Sound, const FVector& Location)
+{
+    CELESTIAL_COMBAT_SCOPE(PlaySound);
+
+    if (!Sound || !IsFeedbackEnabled() || SoundsThisFrame >= MaxSoundsPerFrame || !IsWithinView(Location, SoundCullDistance))
+    {
+        return false;
+    }
+
+    UAudioComponent* Audio = AcquireSound();
+    if (!Audio)
+    {
+        return false;
+    }
+
+    Audio->SetSound(Sound);
+    Audio->SetWorldLocation(Location);
+    Audio->Play();
+
+    SoundsThisFrame++;
+    return true;
+}
+
+bool UCombatFeedbackSubsystem::ShowDamageNumber(TSubclassOf<UDamageNumber> WidgetClass, float Damage, const FVector& Location)
+{
+    CELESTIAL_COMBAT_SCOPE(ShowDamageNumber);
+
+    if (!WidgetClass || !IsFeedbackEnabled() || DamageNumbersThisFrame >= MaxDamageNumbersPerFrame
+        || !IsWithinView(Location, DamageNumberCullDistance))
+    {
+        return false;
+    }
+
+    FPooledDamageNumber* Entry = DamageNumberPool.FindByPredicate([&WidgetClass](const FPooledDamageNumber& Candidate)
+    {
+        return !Candidate.bInUse && Candidate.Widget && Candidate.WidgetClass == WidgetClass;
+    });
+
+    // Widgets join the viewport once and are only shown and hidden afterwards
+    if (!Entry && DamageNumberPool.Num() < MaxPooledDamageNumbers)
+    {
+        UDamageNumber* Widget = CreateWidget<UDamageNumber>(GetWorld(), WidgetClass);
+        if (Widget)
+        {
+            Widget->AddToViewport();
+            Entry = &DamageNumberPool.AddDefaulted_GetRef();
+            Entry->Widget = Widget;
+            Entry->WidgetClass = WidgetClass;
+        }
+    }
+
+    if (!Entry)
+    {
+        return false;
+    }
+
+    Entry->Widget->SetDamage(Damage);
+    Entry->Widget->SetWorldLocation(Location);
+    Entry->Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+    Entry->ReleaseTime = GetWorld()->GetTimeSeconds() + DamageNumberLifetime;
+    Entry->bInUse = true;
+
+    DamageNumbersThisFrame++;
+    return true;
+}
+
+bool UCombatFeedbackSubsystem::IsFeedbackEnabled() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetNetMode() != NM_DedicatedServer;
+}
+
+bool UCombatFeedbackSubsystem::IsWithinView(const FVector& Location, float CullDistance) const
+{
+    const float CullDistanceSquared = FMath::Square(CullDistance);
+    for (const FVector& ViewLocation : ViewLocations)
+    {
+        if (FVector::DistSquared(ViewLocation, Location) <= CullDistanceSquared)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+UParticleSystemComponent* UCombatFeedbackSubsystem::AcquireEffect()
+{
+    for (int32 i = 0; i < EffectPool.Num(); i++)
+    {
+        const int32 Index = (NextEffect + i) % EffectPool.Num();
+        if (!EffectPool[Index]->IsActive())
+        {
+            NextEffect = Index + 1;
+            return EffectPool[Index];
+        }
+    }
+
+    if (EffectPool.Num() >= MaxPooledEffects)
+    {
+        return nullptr;
+    }
+
+    UParticleSystemComponent* Effect = NewObject<UParticleSystemComponent>(GetWorld());
+    Effect->bAutoActivate = false;
+    Effect->bAutoDestroy = false;
+    Effect->RegisterComponentWithWorld(GetWorld());
+    EffectPool.Add(Effect);
+    return Effect;
+}
+
+UAudioComponent* UCombatFeedbackSubsystem::AcquireSound()
+{
+    for (int32 i = 0; i < SoundPool.Num(); i++)
+    {
+        const int32 Index = (NextSound + i) % SoundPool.Num();
+        if (!SoundPool[Index]->IsPlaying())
+        {
+            NextSound = Index + 1;
+            return SoundPool[Index];
+        }
+    }
+
+    if (SoundPool.Num() >= MaxPooledSounds)
+    {
+        return nullptr;
+    }
+
+    UAudioComponent* Audio = NewObject<UAudioComponent>(GetWorld());
+    Audio->bAutoActivate = false;
+    Audio->bAutoDestroy = false;
+    Audio->RegisterComponentWithWorld(GetWorld());
+    SoundPool.Add(Audio);
+    return Audio;
+}
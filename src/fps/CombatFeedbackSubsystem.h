@@ -0,0 +1,109 @@
+// CombatFeedbackSubsystem.h
+// Combat Feedback Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the pooled particle, audio and damage-number feedback shared by every combatant
+// Feature Context: Replaces per-hit SpawnEmitterAtLocation, PlaySoundAtLocation and CreateWidget calls in UCombatSystem
+// Dependencies: Unreal Engine world subsystems, particle and audio components, UMG, DamageNumber widget
+// Usage Example: CombatFeedback->SpawnEffect(ImpactEffect, Hit.Location, Hit.Normal.Rotation())
+// Security: Purely cosmetic; every entry point is a no-op on dedicated servers
+// Performance: Components and widgets are created once and recycled; per-frame caps and view distance bound the work
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatFeedbackSubsystem.generated.h"
+
+// Forward declarations
+class UAudioComponent;
+class UDamageNumber;
+class UParticleSystem;
+class UParticleSystemComponent;
+class USceneComponent;
+class USoundBase;
+
+// Pooled damage-number widget, shown until ReleaseTime
+USTRUCT()
+struct FPooledDamageNumber
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    UDamageNumber* Widget;
+
+    UPROPERTY()
+    TSubclassOf<UDamageNumber> WidgetClass;
+
+    double ReleaseTime;
+    bool bInUse;
+
+    FPooledDamageNumber()
+    {
+        Widget = nullptr;
+        ReleaseTime = 0.0;
+        bInUse = false;
+    }
+};
+
+// World-level pooled combat feedback
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatFeedbackSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatFeedbackSubsystem();
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Each returns false when the request was culled, capped or the pool was exhausted
+    bool SpawnEffect(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+    bool SpawnEffectAttached(UParticleSystem* Template, USceneComponent* AttachTo, FName SocketName);
+    bool PlaySound(USoundBase* Sound, const FVector& Location);
+    bool ShowDamageNumber(TSubclassOf<UDamageNumber> WidgetClass, float Damage, const FVector& Location);
+
+    // Pool sizes
+    int32 MaxPooledEffects;
+    int32 MaxPooledSounds;
+    int32 MaxPooledDamageNumbers;
+
+    // Requests honoured per frame
+    int32 MaxEffectsPerFrame;
+    int32 MaxSoundsPerFrame;
+    int32 MaxDamageNumbersPerFrame;
+
+    // Distance from the local view (uu) beyond which requests are dropped
+    float EffectCullDistance;
+    float SoundCullDistance;
+    float DamageNumberCullDistance;
+
+    // How long a damage number stays visible (s)
+    float DamageNumberLifetime;
+
+private:
+    UPROPERTY()
+    TArray<UParticleSystemComponent*> EffectPool;
+
+    UPROPERTY()
+    TArray<UAudioComponent*> SoundPool;
+
+    UPROPERTY()
+    TArray<FPooledDamageNumber> DamageNumberPool;
+
+    // Round-robin search starts, so recently used entries are tried last
+    int32 NextEffect;
+    int32 NextSound;
+
+    int32 EffectsThisFrame;
+    int32 SoundsThisFrame;
+    int32 DamageNumbersThisFrame;
+
+    // Local views, refreshed each tick
+    TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+    bool IsFeedbackEnabled() const;
+    bool IsWithinView(const FVector& Location, float CullDistance) const;
+    UParticleSystemComponent* AcquireEffect();
+    UAudioComponent* AcquireSound();
+};
@@ -0,0 +1,152 @@
+// CombatHitscanSubsystem.cpp
+// Combat Hitscan Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements the submit/resolve cycle for batched weapon traces
+// Feature Context: Moves hitscan traces off the firing call and resolves all damage for a frame in one pass
+// Dependencies: Unreal Engine world subsystems, async collision traces, CombatRegistrySubsystem, CombatLagCompensationSubsystem, CombatSystem
+// Usage Example: Ticked by the world once per frame: resolve last frame's traces, then submit this frame's
+// Security: The shooter is ignored by its own trace, matching the synchronous path this replaces
+// Performance: Both shot lists keep their allocations across frames
+
+#include "CombatHitscanSubsystem.h"
+#include "CombatLagCompensationSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+UCombatHitscanSubsystem::UCombatHitscanSubsystem()
+{
+    TraceChannel = ECC_Visibility;
+}
+
+void UCombatHitscanSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatHitscan);
+
+    ResolveInFlightShots();
+    SubmitQueuedShots();
+}
+
+TStatId UCombatHitscanSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHitscanSubsystem::QueueShot(UCombatSystem* Shooter, const FVector& Start, const FVector& End, float Damage, float Range)
+{
+    if (Shooter)
+    {
+        FHitscanShot& Shot = QueuedShots.AddDefaulted_GetRef();
+        Shot.Shooter = Shooter;
+        Shot.Start = Start;
+        Shot.End = End;
+        Shot.Damage = Damage;
+        Shot.Range = Range;
+
+        const UCombatLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UCombatLagCompensationSubsystem>();
+        Shot.Timestamp = LagCompensation ? LagCompensation->GetShotTimestamp(Shooter->GetOwner()) : GetWorld()->GetTimeSeconds();
+    }
+}
+
+void UCombatHitscanSubsystem::ResolveInFlightShots()
+{
+    UWorld* World = GetWorld();
+    const UCombatRegistrySubsystem* Registry = World->GetSubsystem<UCombatRegistrySubsystem>();
+
+    FTraceDatum TraceData;
+    for (const FHitscanShot& Shot : InFlightShots)
+    {
+        UCombatSystem* Shooter = Shot.Shooter.Get();
+        if (!Shooter || !World->QueryTraceData(Shot.TraceHandle, TraceData))
+        {
+            continue;
+        }
+
+        FHitResult Hit;
+        bool bHit = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit;
+        if (bHit)
+        {
+            Hit = TraceData.OutHits[0];
+        }
+
+        if (Shot.bRewound)
+        {
+            // Combatants where they are now do not count; where the shooter saw them does
+            if (bHit && Registry && Registry->FindCombatant(Hit.GetActor()))
+            {
+                bHit = false;
+            }
+            if (Shot.bRewoundHit && (!bHit || Shot.RewoundHit.Distance < Hit.Distance))
+            {
+                bHit = true;
+                Hit = Shot.RewoundHit;
+            }
+        }
+        else if (bHit && Registry && Registry->FindCombatant(Hit.GetActor()))
+        {
+            // Only hits on combatants need bone-accurate collision for the damage multiplier
+            RefineCombatantHit(Shot, Hit);
+        }
+
+        Shooter->ResolveHitscanShot(bHit, Hit, Shot.Damage, Shot.Range);
+    }
+
+    InFlightShots.Reset();
+}
+
+void UCombatHitscanSubsystem::SubmitQueuedShots()
+{
+    UWorld* World = GetWorld();
+    const UCombatLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UCombatLagCompensationSubsystem>();
+
+    // Rewound shots trace the live channel with pawns ignored, so everything else blocks them exactly as it blocks
+    // live shots; combatants come from the hitbox history, and any non-pawn combatant hit is dropped on resolve
+    FCollisionResponseParams RewoundResponses;
+    RewoundResponses.CollisionResponse.SetResponse(ECC_Pawn, ECR_Ignore);
+
+    for (FHitscanShot& Shot : QueuedShots)
+    {
+        const UCombatSystem* Shooter = Shot.Shooter.Get();
+        if (!Shooter)
+        {
+            continue;
+        }
+
+        FCollisionQueryParams QueryParams;
+        QueryParams.AddIgnoredActor(Shooter->GetOwner());
+        QueryParams.bTraceComplex = false;
+
+        Shot.bRewound = LagCompensation && LagCompensation->ShouldRewind(Shot.Timestamp);
+        if (Shot.bRewound)
+        {
+            Shot.bRewoundHit = LagCompensation->RewindLineTrace(Shot.Start, Shot.End, Shot.Timestamp, Shooter->GetOwner(), Shot.RewoundHit);
+            Shot.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.End, TraceChannel, QueryParams, RewoundResponses);
+        }
+        else
+        {
+            Shot.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.End, TraceChannel, QueryParams);
+        }
+        InFlightShots.Add(Shot);
+    }
+
+    QueuedShots.Reset();
+}
+
+void UCombatHitscanSubsystem::RefineCombatantHit(const FHitscanShot& Shot, FHitResult& InOutHit) const
+{
+    UPrimitiveComponent* Component = InOutHit.GetComponent();
+    if (!Component)
+    {
+        return;
+    }
+
+    FCollisionQueryParams QueryParams;
+    QueryParams.bTraceComplex = true;
+
+    FHitResult ComplexHit;
+    if (Component->LineTraceComponent(ComplexHit, Shot.Start, Shot.End, QueryParams))
+    {
+        InOutHit = ComplexHit;
+    }
+}
@@ -0,0 +1,73 @@
+// CombatHitscanSubsystem.h
+// Combat Hitscan Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level queue that batches weapon hitscans into async traces
+// Feature Context: Replaces the synchronous complex line trace UCombatSystem::FireWeapon ran per shot
+// Dependencies: Unreal Engine world subsystems, async collision traces, CombatRegistrySubsystem, CombatLagCompensationSubsystem, CombatSystem
+// Usage Example: FireWeapon calls QueueShot; damage for shots fired in frame N resolves in frame N+1
+// Security: Shots are resolved on the game thread against the shooter that fired them; destroyed shooters' shots are dropped
+// Performance: One async simple-collision trace per shot; complex collision is traced only against the component a shot hit
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "CombatHitscanSubsystem.generated.h"
+
+// Forward declarations
+class UCombatLagCompensationSubsystem;
+class UCombatSystem;
+
+// One fired shot, from queueing until its damage is resolved
+struct FHitscanShot
+{
+    TWeakObjectPtr<UCombatSystem> Shooter;
+    FVector Start;
+    FVector End;
+    float Damage;
+
+    // Range of the weapon that fired, for falloff; the shooter may have switched weapons by resolve time
+    float Range;
+    FTraceHandle TraceHandle;
+
+    // World time the shooter saw; shots from the past are traced against rewound hitboxes
+    double Timestamp;
+    bool bRewound;
+    bool bRewoundHit;
+    FHitResult RewoundHit;
+};
+
+// World-level batched hitscan resolution
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatHitscanSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatHitscanSubsystem();
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Queues a shot for this frame's trace batch
+    void QueueShot(UCombatSystem* Shooter, const FVector& Start, const FVector& End, float Damage, float Range);
+
+    int32 GetNumQueuedShots() const { return QueuedShots.Num(); }
+    int32 GetNumShotsInFlight() const { return InFlightShots.Num(); }
+
+private:
+    // Shots fired this frame, submitted at the end of it
+    TArray<FHitscanShot> QueuedShots;
+
+    // Shots whose traces were submitted last frame
+    TArray<FHitscanShot> InFlightShots;
+
+    ECollisionChannel TraceChannel;
+
+    void ResolveInFlightShots();
+    void SubmitQueuedShots();
+
+    // Re-traces a simple-collision hit on a combatant against complex collision of just that component
+    void RefineCombatantHit(const FHitscanShot& Shot, FHitResult& InOutHit) const;
+};
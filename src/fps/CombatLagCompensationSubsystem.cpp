@@ -0,0 +1,412 @@
+// CombatLagCompensationSubsystem.cpp
+// Combat Lag Compensation Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements hitbox snapshot recording, slot management and the rewound capsule trace
+// Feature Context: Server traces for remote shooters run against combatant hitboxes interpolated at the shooter's view time
+// Dependencies: Unreal Engine world subsystems, CombatRegistrySubsystem, CombatSystem, skeletal mesh and capsule components
+// Usage Example: Ticked by the server world; records a snapshot every 1 / SnapshotRate seconds
+// Security: Slots carry a serial so history recorded for a departed combatant is never attributed to its slot's next owner
+// Performance: Components and bone indices are resolved once per slot; each snapshot reads bone transforms by index
+
+#include "CombatLagCompensationSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+
+UCombatLagCompensationSubsystem::UCombatLagCompensationSubsystem()
+{
+    MaxCombatants = 128;
+    SnapshotRate = 30.0f; // Hz
+    MaxRewindTime = 0.5f; // s
+    ClientInterpolationDelay = 0.1f; // s
+    SnapshotTimer = 0.0f;
+    MaxSnapshots = 0;
+    NextSerial = 1;
+    NewestSnapshot = 0;
+    NumSnapshots = 0;
+
+    // Head and torso carry the damage multipliers; everything else lands on the root capsule
+    HitboxDefinitions.Add({ TEXT("head"), NAME_None, 15.0f });
+    HitboxDefinitions.Add({ TEXT("spine_02"), TEXT("pelvis"), 25.0f });
+}
+
+void UCombatLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Every snapshot that can bracket a MaxRewindTime-old shot, plus the one being overwritten
+    MaxSnapshots = FMath::CeilToInt32(MaxRewindTime * SnapshotRate) + 2;
+
+    Slots.SetNumZeroed(MaxCombatants);
+    FreeSlots.Reserve(MaxCombatants);
+    for (int32 Slot = MaxCombatants - 1; Slot >= 0; Slot--)
+    {
+        FreeSlots.Add(Slot);
+    }
+    SlotByActor.Reserve(MaxCombatants);
+
+    SnapshotTimes.SetNumZeroed(MaxSnapshots);
+    Frames.SetNumZeroed(MaxSnapshots * MaxCombatants);
+}
+
+void UCombatLagCompensationSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatLagCompensation);
+
+    // History is only read by server-side hit resolution
+    if (GetWorld()->GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    SnapshotTimer -= DeltaTime;
+    if (SnapshotTimer > 0.0f)
+    {
+        return;
+    }
+    SnapshotTimer = FMath::Max(SnapshotTimer + 1.0f / SnapshotRate, 0.0f);
+
+    const UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (Registry)
+    {
+        ReleaseStaleSlots(Registry);
+        RecordSnapshot(Registry);
+    }
+}
+
+TStatId UCombatLagCompensationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+double UCombatLagCompensationSubsystem::GetShotTimestamp(const AActor* Shooter) const
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    const APawn* Pawn = Cast<APawn>(Shooter);
+    const APlayerState* PlayerState = Pawn ? Pawn->GetPlayerState() : nullptr;
+    if (!PlayerState || Pawn->IsLocallyControlled() || GetWorld()->GetNetMode() == NM_Client)
+    {
+        return Now;
+    }
+
+    // The client saw the world one interpolation delay plus half a round trip late, and its shot took the other half to arrive
+    const double Latency = PlayerState->GetPingInMilliseconds() * 0.001 + ClientInterpolationDelay;
+    return Now - FMath::Min(Latency, static_cast<double>(MaxRewindTime));
+}
+
+bool UCombatLagCompensationSubsystem::ShouldRewind(double Timestamp) const
+{
+    return NumSnapshots > 0 && GetWorld()->GetTimeSeconds() - Timestamp > 0.5 / SnapshotRate;
+}
+
+bool UCombatLagCompensationSubsystem::RewindLineTrace(const FVector& Start, const FVector& End, double Timestamp, const AActor* IgnoreActor, FHitResult& OutHit) const
+{
+    if (NumSnapshots == 0)
+    {
+        return false;
+    }
+
+    // Bracketing snapshots, walking back from the newest; out-of-range times clamp to the ends
+    int32 Newer = NewestSnapshot;
+    int32 Older = NewestSnapshot;
+    if (Timestamp < SnapshotTimes[NewestSnapshot])
+    {
+        for (int32 i = 1; i < NumSnapshots; i++)
+        {
+            Older = (NewestSnapshot - i + MaxSnapshots) % MaxSnapshots;
+            if (SnapshotTimes[Older] <= Timestamp)
+            {
+                break;
+            }
+            Newer = Older;
+        }
+    }
+
+    const double Span = SnapshotTimes[Newer] - SnapshotTimes[Older];
+    const float Alpha = Span > 0.0 ? static_cast<float>(FMath::Clamp((Timestamp - SnapshotTimes[Older]) / Span, 0.0, 1.0)) : 1.0f;
+
+    const FVector Ray = End - Start;
+    const double TraceLength = Ray.Size();
+    if (TraceLength <= KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+    const FVector Direction = Ray / TraceLength;
+
+    double BestDistance = TraceLength;
+    int32 BestSlot = INDEX_NONE;
+    int32 BestHitbox = INDEX_NONE;
+    FVector BestLocation = FVector::ZeroVector;
+    FVector BestNormal = FVector::ZeroVector;
+
+    for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+    {
+        const FCompensatedCombatant& Combatant = Slots[Slot];
+        if (Combatant.Serial == 0 || Combatant.ActorKey == IgnoreActor)
+        {
+            continue;
+        }
+
+        // A combatant recorded in only one of the two snapshots is tested where it was seen
+        const FCompensatedHitboxFrame& OlderFrame = GetFrame(Older, Slot);
+        const FCompensatedHitboxFrame& NewerFrame = GetFrame(Newer, Slot);
+        const bool bHasOlder = OlderFrame.Serial == Combatant.Serial;
+        const bool bHasNewer = NewerFrame.Serial == Combatant.Serial;
+        if (!bHasOlder && !bHasNewer)
+        {
+            continue;
+        }
+        const FCompensatedHitboxFrame& From = bHasOlder ? OlderFrame : NewerFrame;
+        const FCompensatedHitboxFrame& To = bHasNewer ? NewerFrame : OlderFrame;
+
+        // Broadphase
+        const FVector BoundsCenter = FVector(FMath::Lerp(From.BoundsCenter, To.BoundsCenter, Alpha));
+        const double BoundsRadius = FMath::Max(From.BoundsRadius, To.BoundsRadius);
+        if (FMath::PointDistToSegment(BoundsCenter, Start, End) > BoundsRadius)
+        {
+            continue;
+        }
+
+        // The root capsule comes last and encloses the bone hitboxes, so it only takes shots that miss every one of them
+        double CombatantDistance = TraceLength;
+        int32 CombatantHitbox = INDEX_NONE;
+        FVector CombatantLocation = FVector::ZeroVector;
+        FVector CombatantNormal = FVector::ZeroVector;
+
+        const int32 NumCapsules = FMath::Min(From.NumCapsules, To.NumCapsules);
+        for (int32 Hitbox = 0; Hitbox < NumCapsules; Hitbox++)
+        {
+            if (Combatant.StartBones[Hitbox] == INDEX_NONE && CombatantHitbox != INDEX_NONE)
+            {
+                break;
+            }
+
+            const FCompensatedCapsule& FromCapsule = From.Capsules[Hitbox];
+            const FCompensatedCapsule& ToCapsule = To.Capsules[Hitbox];
+            const FVector CapsuleA = FVector(FMath::Lerp(FromCapsule.A, ToCapsule.A, Alpha));
+            const FVector CapsuleB = FVector(FMath::Lerp(FromCapsule.B, ToCapsule.B, Alpha));
+            const double Radius = FMath::Lerp(FromCapsule.Radius, ToCapsule.Radius, Alpha);
+
+            FVector OnRay;
+            FVector OnAxis;
+            FMath::SegmentDistToSegmentSafe(Start, End, CapsuleA, CapsuleB, OnRay, OnAxis);
+            const double AxisDistanceSquared = FVector::DistSquared(OnRay, OnAxis);
+            if (AxisDistanceSquared > Radius * Radius)
+            {
+                continue;
+            }
+
+            // Back off from the closest approach to the surface; exact for the capsule's spherical caps
+            const FVector Location = OnRay - Direction * FMath::Sqrt(Radius * Radius - AxisDistanceSquared);
+            const double Distance = FMath::Max(FVector::DotProduct(Location - Start, Direction), 0.0);
+            if (Distance < CombatantDistance)
+            {
+                CombatantDistance = Distance;
+                CombatantHitbox = Hitbox;
+                CombatantLocation = Start + Direction * Distance;
+                CombatantNormal = (CombatantLocation - OnAxis).GetSafeNormal();
+            }
+        }
+
+        if (CombatantHitbox != INDEX_NONE && CombatantDistance < BestDistance)
+        {
+            BestDistance = CombatantDistance;
+            BestSlot = Slot;
+            BestHitbox = CombatantHitbox;
+            BestLocation = CombatantLocation;
+            BestNormal = CombatantNormal;
+        }
+    }
+
+    if (BestSlot == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FCompensatedCombatant& Combatant = Slots[BestSlot];
+    AActor* HitActor = Combatant.Actor.Get();
+    if (!HitActor)
+    {
+        return false;
+    }
+
+    UPrimitiveComponent* HitComponent = Combatant.StartBones[BestHitbox] == INDEX_NONE
+        ? static_cast<UPrimitiveComponent*>(Combatant.RootCapsule.Get())
+        : static_cast<UPrimitiveComponent*>(Combatant.Mesh.Get());
+
+    OutHit = FHitResult(HitActor, HitComponent, BestLocation, BestNormal);
+    OutHit.bBlockingHit = true;
+    OutHit.TraceStart = Start;
+    OutHit.TraceEnd = End;
+    OutHit.Distance = BestDistance;
+    OutHit.Time = BestDistance / TraceLength;
+    OutHit.BoneName = Combatant.HitboxBoneNames[BestHitbox];
+    return true;
+}
+
+void UCombatLagCompensationSubsystem::RecordSnapshot(const UCombatRegistrySubsystem* Registry)
+{
+    NewestSnapshot = (NewestSnapshot + 1) % MaxSnapshots;
+    NumSnapshots = FMath::Min(NumSnapshots + 1, MaxSnapshots);
+    SnapshotTimes[NewestSnapshot] = GetWorld()->GetTimeSeconds();
+
+    FCompensatedHitboxFrame* SnapshotFrames = &Frames[NewestSnapshot * MaxCombatants];
+    for (int32 Slot = 0; Slot < MaxCombatants; Slot++)
+    {
+        SnapshotFrames[Slot].Serial = 0;
+    }
+
+    for (UCombatSystem* Combat : Registry->GetAllCombatants())
+    {
+        AActor* Owner = Combat->GetOwner();
+        if (!Combat->IsAlive())
+        {
+            continue;
+        }
+
+        const int32* ExistingSlot = SlotByActor.Find(Owner);
+        const int32 Slot = ExistingSlot ? *ExistingSlot : AcquireSlot(Owner);
+        if (Slot == INDEX_NONE)
+        {
+            continue;
+        }
+
+        RecordFrame(Slots[Slot], SnapshotFrames[Slot]);
+        SnapshotFrames[Slot].Serial = Slots[Slot].Serial;
+    }
+}
+
+void UCombatLagCompensationSubsystem::ReleaseStaleSlots(const UCombatRegistrySubsystem* Registry)
+{
+    for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+    {
+        FCompensatedCombatant& Combatant = Slots[Slot];
+        if (Combatant.Serial != 0 && (!Combatant.Actor.IsValid() || !Registry->FindCombatant(Combatant.ActorKey)))
+        {
+            SlotByActor.Remove(Combatant.ActorKey);
+            Combatant = FCompensatedCombatant();
+            FreeSlots.Add(Slot);
+        }
+    }
+}
+
+int32 UCombatLagCompensationSubsystem::AcquireSlot(AActor* Actor)
+{
+    if (FreeSlots.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Slot = FreeSlots.Pop(false);
+    FCompensatedCombatant& Combatant = Slots[Slot];
+    Combatant.ActorKey = Actor;
+    Combatant.Actor = Actor;
+    Combatant.Mesh = Actor->FindComponentByClass<USkeletalMeshComponent>();
+    Combatant.RootCapsule = Cast<UCapsuleComponent>(Actor->GetRootComponent());
+    Combatant.NumHitboxes = 0;
+
+    // Bone hitboxes the mesh actually has, leaving room for the root capsule
+    const USkeletalMeshComponent* Mesh = Combatant.Mesh.Get();
+    const int32 MaxBoneHitboxes = Combatant.RootCapsule.IsValid() ? MaxCompensatedHitboxes - 1 : MaxCompensatedHitboxes;
+    for (const FCombatHitboxDefinition& Definition : HitboxDefinitions)
+    {
+        if (!Mesh || Combatant.NumHitboxes >= MaxBoneHitboxes)
+        {
+            break;
+        }
+
+        const int32 StartBone = Mesh->GetBoneIndex(Definition.BoneName);
+        if (StartBone == INDEX_NONE)
+        {
+            continue;
+        }
+
+        const int32 Hitbox = Combatant.NumHitboxes++;
+        Combatant.StartBones[Hitbox] = StartBone;
+        Combatant.EndBones[Hitbox] = Definition.EndBoneName.IsNone() ? INDEX_NONE : Mesh->GetBoneIndex(Definition.EndBoneName);
+        Combatant.Radii[Hitbox] = Definition.Radius;
+        Combatant.HitboxBoneNames[Hitbox] = Definition.BoneName;
+    }
+
+    if (Combatant.RootCapsule.IsValid())
+    {
+        const int32 Hitbox = Combatant.NumHitboxes++;
+        Combatant.StartBones[Hitbox] = INDEX_NONE;
+        Combatant.EndBones[Hitbox] = INDEX_NONE;
+        Combatant.Radii[Hitbox] = 0.0f;
+        Combatant.HitboxBoneNames[Hitbox] = NAME_None;
+    }
+
+    Combatant.Serial = NextSerial++;
+    if (NextSerial == 0)
+    {
+        NextSerial = 1;
+    }
+
+    SlotByActor.Add(Actor, Slot);
+    return Slot;
+}
+
+void UCombatLagCompensationSubsystem::RecordFrame(const FCompensatedCombatant& Combatant, FCompensatedHitboxFrame& OutFrame) const
+{
+    const USkeletalMeshComponent* Mesh = Combatant.Mesh.Get();
+    const UCapsuleComponent* RootCapsule = Combatant.RootCapsule.Get();
+
+    // Capsule i is always hitbox i, so a combatant that lost a component is left out of this snapshot
+    OutFrame.NumCapsules = 0;
+    OutFrame.BoundsCenter = FVector3f::ZeroVector;
+    OutFrame.BoundsRadius = 0.0f;
+    for (int32 Hitbox = 0; Hitbox < Combatant.NumHitboxes; Hitbox++)
+    {
+        if (Combatant.StartBones[Hitbox] == INDEX_NONE ? !RootCapsule : !Mesh)
+        {
+            return;
+        }
+    }
+
+    for (int32 Hitbox = 0; Hitbox < Combatant.NumHitboxes; Hitbox++)
+    {
+        FCompensatedCapsule& Capsule = OutFrame.Capsules[Hitbox];
+        if (Combatant.StartBones[Hitbox] == INDEX_NONE)
+        {
+            // Root capsule as a segment between its hemisphere centres
+            const float Radius = RootCapsule->GetScaledCapsuleRadius();
+            const FVector Center = RootCapsule->GetComponentLocation();
+            const FVector Axis = RootCapsule->GetUpVector() * (RootCapsule->GetScaledCapsuleHalfHeight() - Radius);
+            Capsule.A = FVector3f(Center - Axis);
+            Capsule.B = FVector3f(Center + Axis);
+            Capsule.Radius = Radius;
+        }
+        else
+        {
+            const FVector A = Mesh->GetBoneTransform(Combatant.StartBones[Hitbox]).GetLocation();
+            const FVector B = Combatant.EndBones[Hitbox] == INDEX_NONE ? A : Mesh->GetBoneTransform(Combatant.EndBones[Hitbox]).GetLocation();
+            Capsule.A = FVector3f(A);
+            Capsule.B = FVector3f(B);
+            Capsule.Radius = Combatant.Radii[Hitbox];
+        }
+    }
+    OutFrame.NumCapsules = Combatant.NumHitboxes;
+
+    // Broadphase sphere
+    FVector3f Center = FVector3f::ZeroVector;
+    for (int32 i = 0; i < OutFrame.NumCapsules; i++)
+    {
+        Center += (OutFrame.Capsules[i].A + OutFrame.Capsules[i].B) * 0.5f;
+    }
+    Center /= FMath::Max(OutFrame.NumCapsules, 1);
+
+    float BoundsRadius = 0.0f;
+    for (int32 i = 0; i < OutFrame.NumCapsules; i++)
+    {
+        const FCompensatedCapsule& Capsule = OutFrame.Capsules[i];
+        BoundsRadius = FMath::Max(BoundsRadius, FMath::Max(FVector3f::Dist(Center, Capsule.A), FVector3f::Dist(Center, Capsule.B)) + Capsule.Radius);
+    }
+
+    OutFrame.BoundsCenter = Center;
+    OutFrame.BoundsRadius = BoundsRadius;
+}
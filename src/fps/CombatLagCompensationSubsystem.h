@@ -0,0 +1,125 @@
+// CombatLagCompensationSubsystem.h
+// Combat Lag Compensation Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the server-side hitbox history ring buffer and the rewound line trace against it
+// Feature Context: Lets the server resolve high-ping players' shots against what they saw instead of the current world
+// Dependencies: Unreal Engine world subsystems, CombatRegistrySubsystem, skeletal mesh and capsule components
+// Usage Example: UCombatHitscanSubsystem stamps each shot with GetShotTimestamp and traces RewindLineTrace for rewound shots
+// Security: Rewind is capped at MaxRewindTime and runs only on the server, so clients cannot request arbitrary history
+// Performance: History is one preallocated flat array of MaxSnapshots x MaxCombatants frames; recording and tracing never allocate
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatLagCompensationSubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class UCapsuleComponent;
+class USkeletalMeshComponent;
+class UCombatRegistrySubsystem;
+
+// Hitbox capsules recorded per combatant per snapshot
+constexpr int32 MaxCompensatedHitboxes = 4;
+
+// Bone-driven hitbox; a capsule between two bones, or a sphere on BoneName when EndBoneName is none
+struct FCombatHitboxDefinition
+{
+    FName BoneName;
+    FName EndBoneName;
+    float Radius;
+};
+
+// Capsule segment and radius in world space
+struct FCompensatedCapsule
+{
+    FVector3f A;
+    FVector3f B;
+    float Radius;
+};
+
+// One combatant at one snapshot
+struct FCompensatedHitboxFrame
+{
+    // Broadphase sphere around every capsule
+    FVector3f BoundsCenter;
+    float BoundsRadius;
+
+    // Slot serial when recorded; 0 marks an empty frame
+    uint32 Serial;
+    int32 NumCapsules;
+    FCompensatedCapsule Capsules[MaxCompensatedHitboxes];
+};
+
+// Server-side combatant hitbox history
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatLagCompensationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatLagCompensationSubsystem();
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // World time the shooter saw when it fired: now for AI and local players, now minus latency for remote players
+    double GetShotTimestamp(const AActor* Shooter) const;
+
+    // True when Timestamp is far enough in the past that history should stand in for the current world
+    bool ShouldRewind(double Timestamp) const;
+
+    // Nearest hitbox along Start..End at Timestamp, interpolated between the bracketing snapshots
+    bool RewindLineTrace(const FVector& Start, const FVector& End, double Timestamp, const AActor* IgnoreActor, FHitResult& OutHit) const;
+
+    // Hitboxes sampled from each combatant's skeletal mesh; the root capsule is always added, and only hit when they all miss
+    TArray<FCombatHitboxDefinition> HitboxDefinitions;
+
+private:
+    // Capacity; combatants past MaxCombatants are not compensated
+    int32 MaxCombatants;
+    int32 MaxSnapshots;
+
+    // Snapshot cadence (Hz), oldest rewind (s) and the client's interpolation delay added to ping (s)
+    float SnapshotRate;
+    float MaxRewindTime;
+    float ClientInterpolationDelay;
+    float SnapshotTimer;
+
+    // Per-slot record of which combatant the slot tracks, with its bone indices resolved once;
+    // a hitbox with StartBone INDEX_NONE is the root capsule, one with EndBone INDEX_NONE a sphere
+    struct FCompensatedCombatant
+    {
+        const AActor* ActorKey;
+        TWeakObjectPtr<AActor> Actor;
+        TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+        TWeakObjectPtr<UCapsuleComponent> RootCapsule;
+        int32 StartBones[MaxCompensatedHitboxes];
+        int32 EndBones[MaxCompensatedHitboxes];
+        float Radii[MaxCompensatedHitboxes];
+        FName HitboxBoneNames[MaxCompensatedHitboxes];
+        int32 NumHitboxes;
+        uint32 Serial;
+    };
+
+    TArray<FCompensatedCombatant> Slots;
+    TArray<int32> FreeSlots;
+    TMap<const AActor*, int32> SlotByActor;
+    uint32 NextSerial;
+
+    // Ring of snapshot times and their frames, Frames[Snapshot * MaxCombatants + Slot]
+    TArray<double> SnapshotTimes;
+    TArray<FCompensatedHitboxFrame> Frames;
+    int32 NewestSnapshot;
+    int32 NumSnapshots;
+
+    void RecordSnapshot(const UCombatRegistrySubsystem* Registry);
+    void ReleaseStaleSlots(const UCombatRegistrySubsystem* Registry);
+    int32 AcquireSlot(AActor* Actor);
+    void RecordFrame(const FCompensatedCombatant& Combatant, FCompensatedHitboxFrame& OutFrame) const;
+
+    const FCompensatedHitboxFrame& GetFrame(int32 Snapshot, int32 Slot) const { return Frames[Snapshot * MaxCombatants + Slot]; }
+};
@@ -0,0 +1,14 @@
+// CombatProfiling.cpp
+// Combat Profiling for Celestial Syndicate
+// Quantum Documentation: Defines the combat CSV category and log category
+// Feature Context: Per-subsystem combat timings and counters for stat commands, Unreal Insights, benchmark captures and -csvprofile
+// Dependencies: Unreal Engine stats, CSV profiler, logging
+// Usage Example: Include CombatProfiling.h and add CELESTIAL_COMBAT_SCOPE(<Stage>) scopes
+// Security: Timing data and counters only; nothing gameplay-relevant is recorded
+// Performance: Enabled by default; scopes only record while a capture is running
+
+#include "CombatProfiling.h"
+
+CSV_DEFINE_CATEGORY(CelestialCombat, true);
+
+DEFINE_LOG_CATEGORY(LogCelestialCombat);
@@ -0,0 +1,38 @@
+// CombatProfiling.h
+// Combat Profiling Header for Celestial Syndicate
+// Quantum Documentation: Declares the combat stat group, CSV category, Insights counters and log category
+// Feature Context: Per-subsystem combat timings and counters for stat commands, Unreal Insights, benchmark captures and -csvprofile
+// Dependencies: Unreal Engine stats, CSV profiler, trace counters, logging
+// Usage Example: CELESTIAL_COMBAT_SCOPE(FireWeapon); UE_LOG(LogCelestialCombat, Verbose, TEXT("..."))
+// Security: Timing data and counters only; nothing gameplay-relevant is recorded
+// Performance: Scopes cost a few branches when no capture is running and compile out with stats, trace and CSV disabled
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("Celestial Combat"), STATGROUP_CelestialCombat, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(CelestialCombat);
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCelestialCombat, Log, All);
+
+// One cycle stat ("stat CelestialCombat"), Insights CPU event and CSV timing, all called Name
+#define CELESTIAL_COMBAT_SCOPE(Name) \
+    DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_CelestialCombat_##Name, STATGROUP_CelestialCombat); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(Name); \
+    CSV_SCOPED_TIMING_STAT(CelestialCombat, Name)
+
+// Per-frame counter shown in the stat group, in Insights and in CSV captures; declare at file scope, set once a frame
+#define DECLARE_CELESTIAL_COMBAT_COUNTER(Name) \
+    DECLARE_DWORD_COUNTER_STAT(TEXT(#Name), STAT_CelestialCombat_##Name, STATGROUP_CelestialCombat); \
+    TRACE_DECLARE_INT_COUNTER(CelestialCombat_##Name, TEXT("CelestialCombat/" #Name))
+
+#define SET_CELESTIAL_COMBAT_COUNTER(Name, Value) \
+    SET_DWORD_STAT(STAT_CelestialCombat_##Name, Value); \
+    TRACE_COUNTER_SET(CelestialCombat_##Name, Value); \
+    CSV_CUSTOM_STAT(CelestialCombat, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set)
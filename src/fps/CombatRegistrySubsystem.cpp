@@ -0,0 +1,63 @@
+// CombatRegistrySubsystem.cpp
+// Combat Registry Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements combatant registration, death tracking and actor lookup
+// Feature Context: Lets target validation and scoring cost one hash lookup per candidate
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: GetWorld()->GetSubsystem<UCombatRegistrySubsystem>()->FindCombatSystem(Actor)
+// Security: Duplicate and unknown registrations are ignored rather than corrupting the index
+// Performance: The combatant list is dense and removal is a swap, so no operation scales with combatant count
+
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+
+UCombatRegistrySubsystem::UCombatRegistrySubsystem()
+{
+}
+
+void UCombatRegistrySubsystem::RegisterCombatant(UCombatSystem* Combat)
+{
+    const AActor* Owner = Combat ? Combat->GetOwner() : nullptr;
+    if (!Owner || Entries.Contains(Owner))
+    {
+        return;
+    }
+
+    FCombatantEntry& Entry = Entries.Add(Owner);
+    Entry.Combat = Combat;
+    Entry.TeamId = Combat->GetTeamId();
+    Entry.bAlive = Combat->IsAlive();
+    Entry.Index = Combatants.Add(Combat);
+}
+
+void UCombatRegistrySubsystem::UnregisterCombatant(UCombatSystem* Combat)
+{
+    const AActor* Owner = Combat ? Combat->GetOwner() : nullptr;
+    const FCombatantEntry* Entry = Entries.Find(Owner);
+    if (!Entry || Entry->Combat != Combat)
+    {
+        return;
+    }
+
+    const int32 Index = Entry->Index;
+    Combatants.RemoveAtSwap(Index);
+    if (Combatants.IsValidIndex(Index))
+    {
+        Entries.FindChecked(Combatants[Index]->GetOwner()).Index = Index;
+    }
+
+    Entries.Remove(Owner);
+}
+
+void UCombatRegistrySubsystem::NotifyDied(UCombatSystem* Combat)
+{
+    if (FCombatantEntry* Entry = Entries.Find(Combat ? Combat->GetOwner() : nullptr))
+    {
+        Entry->bAlive = false;
+    }
+}
+
+UCombatSystem* UCombatRegistrySubsystem::FindCombatSystem(const AActor* Actor) const
+{
+    const FCombatantEntry* Entry = Entries.Find(Actor);
+    return Entry ? Entry->Combat : nullptr;
+}
@@ -0,0 +1,57 @@
+// CombatRegistrySubsystem.h
+// Combat Registry Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level map from combatant actor to its combat system, team and alive flag
+// Feature Context: Replaces FindComponentByClass<UCombatSystem>() wherever combat code resolves a target
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: const FCombatantEntry* Entry = CombatRegistry->FindCombatant(HitActor)
+// Security: Game-thread only; entries are removed in EndPlay so no pointer outlives its combatant
+// Performance: Registration, death and every lookup are O(1); nothing walks an actor's components
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatRegistrySubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class UCombatSystem;
+
+// What target resolution needs about a combatant, kept next to its component pointer
+struct FCombatantEntry
+{
+    UCombatSystem* Combat;
+    int32 TeamId;
+    bool bAlive;
+
+    // Position in the dense combatant list
+    int32 Index;
+};
+
+// World-level combatant index
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatRegistrySubsystem();
+
+    // Called by UCombatSystem in BeginPlay/EndPlay; team is read at registration
+    void RegisterCombatant(UCombatSystem* Combat);
+    void UnregisterCombatant(UCombatSystem* Combat);
+
+    // Called by UCombatSystem on death; the entry stays until EndPlay so killers can still resolve it
+    void NotifyDied(UCombatSystem* Combat);
+
+    // Null when the actor has no registered combat system
+    const FCombatantEntry* FindCombatant(const AActor* Actor) const { return Entries.Find(Actor); }
+    UCombatSystem* FindCombatSystem(const AActor* Actor) const;
+
+    const TArray<UCombatSystem*>& GetAllCombatants() const { return Combatants; }
+    int32 GetNumCombatants() const { return Combatants.Num(); }
+
+private:
+    TMap<const AActor*, FCombatantEntry> Entries;
+    TArray<UCombatSystem*> Combatants;
+};
@@ -8,9 +8,18 @@
 // Performance: Optimized for real-time multiplayer combat
 
 #include "CombatSystem.h"
+#include "CombatAISchedulerSubsystem.h"
+#include "CombatFeedbackSubsystem.h"
+#include "CombatHitscanSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatTargetingSubsystem.h"
+#include "CombatTelemetrySubsystem.h"
+#include "CombatTimeoutSubsystem.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkinnedAsset.h"
 #include "Components/AudioComponent.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "GameFramework/Character.h"
@@ -19,10 +28,21 @@
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 
+namespace
+{
+    // AI cover thresholds
+    constexpr float LowHealthFraction = 0.3f;
+    constexpr float RecentDamageWindow = 2.0f; // s
+    
+    // Time after the last shot fired or taken before leaving combat
+    constexpr float CombatTimeout = 10.0f; // s
+}
+
 // Combat System Implementation
 UCombatSystem::UCombatSystem()
 {
     PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
     SetIsReplicated(true);
     
     // Initialize combat parameters
@@ -32,86 +52,159 @@ UCombatSystem::UCombatSystem()
     CurrentShield = ShieldCapacity;
     ShieldRechargeRate = 5.0f;
     ShieldRechargeDelay = 3.0f;
+    HealthRegenRate = 0.0f;
+    HealthRegenDelay = 5.0f;
     
     // Weapon system
+    WeaponDefinitions = nullptr;
+    CurrentSlot = INDEX_NONE;
     CurrentWeapon = nullptr;
-    WeaponInventory.SetNum(3); // 3 weapon slots
     
     // Combat state
     bIsInCombat = false;
     bIsReloading = false;
+    bDormantWhenIdle = false;
     LastDamageTime = 0.0f;
+    LastDamageTakenTime = 0.0;
+    RegenSettledTime = 0.0;
+    TimeoutGeneration = 0;
+    ScheduledTimeoutTime = 0.0;
+    TeamId = 0;
+    CombatRegistry = nullptr;
+    CombatTargeting = nullptr;
+    CombatHitscan = nullptr;
+    CombatFeedback = nullptr;
+    CombatAIScheduler = nullptr;
+    CombatTimeouts = nullptr;
+    CombatTelemetry = nullptr;
+    TelemetryId = INDEX_NONE;
     
     // AI combat parameters
     CombatRange = 1000.0f;
     TacticalRange = 500.0f;
     CoverPreference = 0.7f;
     AggressionLevel = 0.5f;
+    CurrentTarget = nullptr;
+    bTargetQueryPending = false;
+    AIOwner = nullptr;
+    CachedDecision = EAICombatDecision::None;
+    AIScheduleSlot = INDEX_NONE;
 }
 
 void UCombatSystem::BeginPlay()
 {
     Super::BeginPlay();
     
+    CombatRegistry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (CombatRegistry)
+    {
+        CombatRegistry->RegisterCombatant(this);
+    }
+    CombatTargeting = GetWorld()->GetSubsystem<UCombatTargetingSubsystem>();
+    CombatHitscan = GetWorld()->GetSubsystem<UCombatHitscanSubsystem>();
+    CombatFeedback = GetWorld()->GetSubsystem<UCombatFeedbackSubsystem>();
+    CombatTimeouts = GetWorld()->GetSubsystem<UCombatTimeoutSubsystem>();
+    CombatTelemetry = GetWorld()->GetSubsystem<UCombatTelemetrySubsystem>();
+    if (CombatTelemetry)
+    {
+        TelemetryId = CombatTelemetry->RegisterCombatant(this);
+    }
+    RegenSettledTime = GetWorld()->GetTimeSeconds();
+    
     // Initialize weapon systems
     InitializeWeaponSystems();
     
-    // Start shield recharge timer
-    GetWorld()->GetTimerManager().SetTimer(
-        ShieldRechargeTimer,
-        this,
-        &UCombatSystem::RechargeShield,
-        1.0f,
-        true
-    );
+    // Initialize AI combat behavior; decisions run from the scheduler rather than every tick
+    AIOwner = Cast<AAICharacter>(GetOwner());
+    if (AIOwner)
+    {
+        InitializeAICombat(AIOwner);
+        
+        CombatAIScheduler = GetWorld()->GetSubsystem<UCombatAISchedulerSubsystem>();
+        if (CombatAIScheduler)
+        {
+            CombatAIScheduler->RegisterCombatant(this);
+        }
+    }
     
-    // Initialize AI combat behavior
-    if (AAICharacter* AIChar = Cast<AAICharacter>(GetOwner()))
+    // Ticks only while something needs per-frame work
+    RefreshTickEnabled();
+    RefreshNetDormancy();
+}
+
+void UCombatSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (CombatRegistry)
+    {
+        CombatRegistry->UnregisterCombatant(this);
+        CombatRegistry = nullptr;
+    }
+    if (CombatAIScheduler)
+    {
+        CombatAIScheduler->UnregisterCombatant(this);
+        CombatAIScheduler = nullptr;
+    }
+    if (CurrentWeapon)
     {
-        InitializeAICombat(AIChar);
+        CurrentWeapon->Destroy();
+        CurrentWeapon = nullptr;
     }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void UCombatSystem::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    CELESTIAL_COMBAT_SCOPE(CombatSystemTick);
     
-    // Update combat state
-    UpdateCombatState(DeltaTime);
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
-    // Update AI combat behavior
-    if (AAICharacter* AIChar = Cast<AAICharacter>(GetOwner()))
+    // Aim stays smooth between scheduled decisions
+    if (AIOwner && CurrentTarget)
     {
-        UpdateAICombat(AIChar, DeltaTime);
+        UpdateTargetTracking(CurrentTarget);
     }
     
     // Update weapon effects
     UpdateWeaponEffects(DeltaTime);
 }
 
+void UCombatSystem::RunScheduledAICombat(float DeltaTime)
+{
+    UpdateAICombat(AIOwner, DeltaTime);
+}
+
 void UCombatSystem::InitializeWeaponSystems()
 {
-    // Create default weapon loadout
-    TArray<FWeaponData> DefaultWeapons = {
-        { EWeaponType::PulseRifle, "PulseRifle", 30, 100.0f, 0.1f, 800.0f },
-        { EWeaponType::PlasmaCannon, "PlasmaCannon", 10, 200.0f, 0.5f, 600.0f },
-        { EWeaponType::QuantumBlaster, "QuantumBlaster", 5, 500.0f, 1.0f, 1200.0f }
-    };
+    WeaponTable = GetWeaponDefinitions()->GetWeaponTable();
     
-    for (int32 i = 0; i < DefaultWeapons.Num() && i < WeaponInventory.Num(); i++)
+    // Slots only reference the shared table; no actors exist until a weapon is equipped
+    WeaponSlots.SetNum(WeaponTable->Weapons.Num());
+    for (int32 i = 0; i < WeaponSlots.Num(); i++)
     {
-        WeaponInventory[i] = CreateWeapon(DefaultWeapons[i]);
+        WeaponSlots[i].DefinitionIndex = i;
+        WeaponSlots[i].CurrentAmmo = WeaponTable->Weapons[i].MaxAmmo;
     }
     
     // Set primary weapon
-    if (WeaponInventory.Num() > 0)
+    if (WeaponSlots.Num() > 0)
     {
         EquipWeapon(0);
     }
 }
 
-AWeapon* UCombatSystem::CreateWeapon(const FWeaponData& WeaponData)
+const UWeaponDefinitionSet* UCombatSystem::GetWeaponDefinitions() const
 {
+    return WeaponDefinitions ? WeaponDefinitions : GetDefault<UWeaponDefinitionSet>();
+}
+
+AWeapon* UCombatSystem::SpawnWeaponActor(const FWeaponData& WeaponData)
+{
+    if (!WeaponData.WeaponClass)
+    {
+        return nullptr;
+    }
+    
     // Spawn weapon actor
     FActorSpawnParameters SpawnParams;
     SpawnParams.Owner = GetOwner();
@@ -133,76 +226,74 @@ AWeapon* UCombatSystem::CreateWeapon(const FWeaponData& WeaponData)
     return NewWeapon;
 }
 
+const FWeaponData* UCombatSystem::GetCurrentWeaponData() const
+{
+    return WeaponTable.IsValid() && WeaponSlots.IsValidIndex(CurrentSlot) ? WeaponTable->Find(WeaponSlots[CurrentSlot].DefinitionIndex) : nullptr;
+}
+
 void UCombatSystem::EquipWeapon(int32 WeaponIndex)
 {
-    if (WeaponIndex >= 0 && WeaponIndex < WeaponInventory.Num() && WeaponInventory[WeaponIndex])
+    if (WeaponIndex == CurrentSlot || !WeaponSlots.IsValidIndex(WeaponIndex) || !WeaponTable.IsValid())
     {
-        // Unequip current weapon
-        if (CurrentWeapon)
-        {
-            CurrentWeapon->SetActorHiddenInGame(true);
-            CurrentWeapon->SetActorEnableCollision(false);
-        }
-        
-        // Equip new weapon
-        CurrentWeapon = WeaponInventory[WeaponIndex];
-        CurrentWeapon->SetActorHiddenInGame(false);
-        CurrentWeapon->SetActorEnableCollision(true);
-        
-        // Update UI
-        OnWeaponEquipped.Broadcast(CurrentWeapon);
-        
-        UE_LOG(LogTemp, Log, TEXT("Equipped weapon: %s"), *CurrentWeapon->GetWeaponName());
+        return;
+    }
+    
+    const FWeaponData* WeaponData = WeaponTable->Find(WeaponSlots[WeaponIndex].DefinitionIndex);
+    if (!WeaponData)
+    {
+        return;
+    }
+    
+    // Only the equipped weapon has an actor
+    if (CurrentWeapon)
+    {
+        CurrentWeapon->Destroy();
+        CurrentWeapon = nullptr;
     }
+    
+    CurrentSlot = WeaponIndex;
+    CurrentWeapon = SpawnWeaponActor(*WeaponData);
+    RefreshTickEnabled();
+    
+    // Update UI
+    OnWeaponEquipped.Broadcast(CurrentWeapon);
+    
+    UE_LOG(LogCelestialCombat, Verbose, TEXT("Equipped weapon: %s"), *WeaponData->WeaponName);
 }
 
 void UCombatSystem::FireWeapon()
 {
-    if (!CurrentWeapon || bIsReloading || !CanFire())
+    CELESTIAL_COMBAT_SCOPE(FireWeapon);
+    
+    const FWeaponData* WeaponData = GetCurrentWeaponData();
+    if (!WeaponData || bIsReloading)
     {
         return;
     }
     
     // Check ammo
-    if (CurrentWeapon->GetCurrentAmmo() <= 0)
+    FWeaponSlot& Slot = WeaponSlots[CurrentSlot];
+    if (Slot.CurrentAmmo <= 0)
     {
         ReloadWeapon();
         return;
     }
     
-    // Fire weapon
-    FHitResult HitResult;
+    // Fire weapon; the trace joins this frame's batch and resolves in ResolveHitscanShot next frame
     FVector StartLocation = GetOwner()->GetActorLocation() + GetOwner()->GetActorForwardVector() * 100.0f;
-    FVector EndLocation = StartLocation + GetOwner()->GetActorForwardVector() * CurrentWeapon->GetRange();
-    
-    // Perform line trace
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(GetOwner());
-    QueryParams.bTraceComplex = true;
-    
-    bool bHit = GetWorld()->LineTraceSingleByChannel(
-        HitResult,
-        StartLocation,
-        EndLocation,
-        ECC_Visibility,
-        QueryParams
-    );
+    FVector EndLocation = StartLocation + GetOwner()->GetActorForwardVector() * WeaponData->Range;
     
-    if (bHit)
+    if (CombatHitscan)
     {
-        // Apply damage to hit target
-        AActor* HitActor = HitResult.GetActor();
-        if (HitActor)
-        {
-            ApplyDamage(HitActor, CurrentWeapon->GetDamage(), HitResult);
-        }
-        
-        // Spawn impact effects
-        SpawnImpactEffects(HitResult);
+        CombatHitscan->QueueShot(this, StartLocation, EndLocation, WeaponData->Damage, WeaponData->Range);
     }
     
     // Consume ammo
-    CurrentWeapon->ConsumeAmmo(1);
+    Slot.CurrentAmmo--;
+    if (CombatTelemetry)
+    {
+        CombatTelemetry->RecordEvent(ECombatTelemetryEventType::Shot, TelemetryId, INDEX_NONE);
+    }
     
     // Play weapon effects
     PlayWeaponEffects();
@@ -210,24 +301,44 @@ void UCombatSystem::FireWeapon()
     // Update combat state
     bIsInCombat = true;
     LastDamageTime = GetWorld()->GetTimeSeconds();
+    ScheduleCombatTimeout();
+    RefreshNetDormancy();
     
     // Notify AI systems
     NotifyCombatAction(ECombatAction::WeaponFired);
 }
 
-void UCombatSystem::ApplyDamage(AActor* Target, float Damage, const FHitResult& HitResult)
+void UCombatSystem::ResolveHitscanShot(bool bHit, const FHitResult& HitResult, float Damage, float Range)
+{
+    if (!bHit)
+    {
+        return;
+    }
+    
+    // Apply damage to hit target
+    AActor* HitActor = HitResult.GetActor();
+    if (HitActor)
+    {
+        ApplyDamage(HitActor, Damage, Range, HitResult);
+    }
+    
+    // Spawn impact effects
+    SpawnImpactEffects(HitResult);
+}
+
+void UCombatSystem::ApplyDamage(AActor* Target, float Damage, float Range, const FHitResult& HitResult)
 {
     if (!Target)
     {
         return;
     }
     
-    // Check if target has combat system
-    UCombatSystem* TargetCombat = Target->FindComponentByClass<UCombatSystem>();
-    if (TargetCombat)
+    // Check if target has combat system; corpses stay registered until EndPlay but take no more hits
+    UCombatSystem* TargetCombat = CombatRegistry ? CombatRegistry->FindCombatSystem(Target) : nullptr;
+    if (TargetCombat && TargetCombat->IsAlive())
     {
         // Calculate damage based on hit location
-        float FinalDamage = CalculateDamage(Damage, HitResult);
+        float FinalDamage = CalculateDamage(Damage, Range, HitResult);
         
         // Apply damage to target
         TargetCombat->TakeDamage(FinalDamage, GetOwner());
@@ -235,41 +346,71 @@ void UCombatSystem::ApplyDamage(AActor* Target, float Damage, const FHitResult&
         // Spawn damage effects
         SpawnDamageEffects(Target, FinalDamage, HitResult);
         
-        // Update combat statistics
-        UpdateCombatStats(FinalDamage, Target);
+        // Update combat statistics; damage is recorded by the target as it applies it
+        if (CombatTelemetry)
+        {
+            CombatTelemetry->RecordEvent(ECombatTelemetryEventType::Hit, TelemetryId, TargetCombat->TelemetryId);
+        }
     }
 }
 
-float UCombatSystem::CalculateDamage(float BaseDamage, const FHitResult& HitResult)
+float UCombatSystem::CalculateDamage(float BaseDamage, float Range, const FHitResult& HitResult)
 {
-    float DamageMultiplier = 1.0f;
+    float DamageMultiplier = GetBoneDamageMultiplier(HitResult);
     
-    // Headshot multiplier
-    if (HitResult.BoneName == TEXT("head"))
-    {
-        DamageMultiplier = 2.0f;
-    }
-    // Body shot
-    else if (HitResult.BoneName == TEXT("spine_01") || HitResult.BoneName == TEXT("spine_02"))
+    // Distance falloff against the range of the weapon that fired, not the one held now
+    float Distance = HitResult.Distance;
+    float DistanceMultiplier = Range > 0.0f ? FMath::Max(0.5f, 1.0f - (Distance / Range)) : 1.0f;
+    
+    return BaseDamage * DamageMultiplier * DistanceMultiplier;
+}
+
+float UCombatSystem::GetBoneDamageMultiplier(const FHitResult& HitResult)
+{
+    const USkinnedMeshComponent* Mesh = Cast<USkinnedMeshComponent>(HitResult.GetComponent());
+    const USkinnedAsset* SkinnedAsset = Mesh ? Mesh->GetSkinnedAsset() : nullptr;
+    if (!SkinnedAsset || HitResult.BoneName == NAME_None)
     {
-        DamageMultiplier = 1.5f;
+        return 1.0f;
     }
-    // Limb shot
-    else if (HitResult.BoneName.Contains(TEXT("arm")) || HitResult.BoneName.Contains(TEXT("leg")))
+    
+    // Targets usually share a skeleton, so the last table is kept to skip the per-asset lookup
+    if (BoneDamageTableMesh.Get() != SkinnedAsset)
     {
-        DamageMultiplier = 0.7f;
+        BoneDamageTable = GetWeaponDefinitions()->GetBoneDamageTable(SkinnedAsset);
+        BoneDamageTableMesh = SkinnedAsset;
     }
     
-    // Distance falloff
-    float Distance = HitResult.Distance;
-    float Range = CurrentWeapon ? CurrentWeapon->GetRange() : 1000.0f;
-    float DistanceMultiplier = FMath::Max(0.5f, 1.0f - (Distance / Range));
-    
-    return BaseDamage * DamageMultiplier * DistanceMultiplier;
+    return BoneDamageTable.IsValid() ? BoneDamageTable->GetMultiplier(Mesh->GetBoneIndex(HitResult.BoneName)) : 1.0f;
 }
 
 void UCombatSystem::TakeDamage(float Damage, AActor* DamageCauser)
 {
+    ApplyIncomingDamage(Damage, DamageCauser, GetTelemetryId(DamageCauser));
+}
+
+void UCombatSystem::TakeCrowdDamage(float Damage, int32 KillerTelemetryId)
+{
+    ApplyIncomingDamage(Damage, nullptr, KillerTelemetryId);
+}
+
+void UCombatSystem::ApplyIncomingDamage(float Damage, AActor* DamageCauser, int32 KillerTelemetryId)
+{
+    // The dead die once: no second Kill, Death or OnDeath
+    if (!IsAlive())
+    {
+        return;
+    }
+    
+    // Fold in regeneration up to this hit before applying it
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    SettleRegen(WorldTime);
+    
+    if (CombatTelemetry)
+    {
+        CombatTelemetry->RecordEvent(ECombatTelemetryEventType::Damage, GetTelemetryId(DamageCauser), TelemetryId, Damage);
+    }
+    
     // Apply damage to shield first
     if (CurrentShield > 0.0f)
     {
@@ -292,46 +433,164 @@ void UCombatSystem::TakeDamage(float Damage, AActor* DamageCauser)
         // Check for death
         if (CurrentHealth <= 0.0f)
         {
-            Die(DamageCauser);
+            Die(DamageCauser, KillerTelemetryId);
         }
     }
     
-    // Update combat state
+    // Update combat state; regeneration restarts from this hit without touching a timer
     bIsInCombat = true;
-    LastDamageTime = GetWorld()->GetTimeSeconds();
-    
-    // Reset shield recharge timer
-    GetWorld()->GetTimerManager().ClearTimer(ShieldRechargeTimer);
-    GetWorld()->GetTimerManager().SetTimer(
-        ShieldRechargeTimer,
-        this,
-        &UCombatSystem::RechargeShield,
-        ShieldRechargeDelay,
-        false
-    );
+    LastDamageTime = WorldTime;
+    LastDamageTakenTime = WorldTime;
+    ScheduleCombatTimeout();
+    RefreshNetDormancy();
     
     // Notify UI
     OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
     OnShieldChanged.Broadcast(CurrentShield, ShieldCapacity);
 }
 
+void UCombatSystem::Heal(float Amount)
+{
+    if (Amount <= 0.0f || !IsAlive())
+    {
+        return;
+    }
+    
+    SettleRegen(GetWorld()->GetTimeSeconds());
+    CurrentHealth = FMath::Min(MaxHealth, CurrentHealth + Amount);
+    RefreshNetDormancy();
+    
+    OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+}
+
 void UCombatSystem::RechargeShield()
 {
-    if (CurrentShield < ShieldCapacity && !bIsInCombat)
+    SettleRegen(GetWorld()->GetTimeSeconds());
+    
+    OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+    OnShieldChanged.Broadcast(CurrentShield, ShieldCapacity);
+}
+
+float UCombatSystem::GetCurrentHealth() const
+{
+    const UWorld* World = GetWorld();
+    return World ? EvaluateHealth(World->GetTimeSeconds()) : CurrentHealth;
+}
+
+float UCombatSystem::GetCurrentShield() const
+{
+    const UWorld* World = GetWorld();
+    return World ? EvaluateShield(World->GetTimeSeconds()) : CurrentShield;
+}
+
+double UCombatSystem::GetHealthRegenStartTime() const
+{
+    return FMath::Max(RegenSettledTime, LastDamageTakenTime + HealthRegenDelay);
+}
+
+double UCombatSystem::GetShieldRegenStartTime() const
+{
+    return FMath::Max(RegenSettledTime, LastDamageTakenTime + ShieldRechargeDelay);
+}
+
+float UCombatSystem::EvaluateHealth(double WorldTime) const
+{
+    // The dead do not regenerate
+    if (CurrentHealth <= 0.0f || HealthRegenRate <= 0.0f || GetOwnerRole() != ROLE_Authority)
+    {
+        return CurrentHealth;
+    }
+    
+    const double Elapsed = FMath::Max(WorldTime - GetHealthRegenStartTime(), 0.0);
+    return FMath::Min(MaxHealth, CurrentHealth + static_cast<float>(HealthRegenRate * Elapsed));
+}
+
+float UCombatSystem::EvaluateShield(double WorldTime) const
+{
+    if (CurrentHealth <= 0.0f || ShieldRechargeRate <= 0.0f || GetOwnerRole() != ROLE_Authority)
+    {
+        return CurrentShield;
+    }
+    
+    const double Elapsed = FMath::Max(WorldTime - GetShieldRegenStartTime(), 0.0);
+    return FMath::Min(ShieldCapacity, CurrentShield + static_cast<float>(ShieldRechargeRate * Elapsed));
+}
+
+void UCombatSystem::SettleRegen(double WorldTime)
+{
+    CurrentHealth = EvaluateHealth(WorldTime);
+    CurrentShield = EvaluateShield(WorldTime);
+    RegenSettledTime = FMath::Max(RegenSettledTime, WorldTime);
+}
+
+void UCombatSystem::ScheduleCombatTimeout()
+{
+    if (!CombatTimeouts || !IsAlive())
+    {
+        return;
+    }
+    
+    // Earliest moment the combatant's state or its listeners need attention
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    double WakeTime = bIsInCombat ? LastDamageTime + CombatTimeout : 0.0;
+    
+    if (ShieldRechargeRate > 0.0f && CurrentShield < ShieldCapacity)
+    {
+        const double ShieldFullTime = GetShieldRegenStartTime() + (ShieldCapacity - CurrentShield) / ShieldRechargeRate;
+        WakeTime = WakeTime > 0.0 ? FMath::Min(WakeTime, ShieldFullTime) : ShieldFullTime;
+    }
+    if (HealthRegenRate > 0.0f && CurrentHealth < MaxHealth)
+    {
+        const double HealthFullTime = GetHealthRegenStartTime() + (MaxHealth - CurrentHealth) / HealthRegenRate;
+        WakeTime = WakeTime > 0.0 ? FMath::Min(WakeTime, HealthFullTime) : HealthFullTime;
+    }
+    
+    if (WakeTime > 0.0)
+    {
+        CombatTimeouts->ScheduleTimeout(this, FMath::Max(WakeTime, WorldTime + KINDA_SMALL_NUMBER));
+    }
+}
+
+void UCombatSystem::HandleCombatTimeout(double WorldTime)
+{
+    if (!IsAlive())
+    {
+        return;
+    }
+    
+    const float PreviousHealth = CurrentHealth;
+    const float PreviousShield = CurrentShield;
+    SettleRegen(WorldTime);
+    
+    if (CurrentHealth != PreviousHealth)
+    {
+        OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+    }
+    if (CurrentShield != PreviousShield)
     {
-        CurrentShield = FMath::Min(ShieldCapacity, CurrentShield + ShieldRechargeRate);
         OnShieldChanged.Broadcast(CurrentShield, ShieldCapacity);
     }
+    
+    // Check if out of combat
+    if (bIsInCombat && WorldTime - LastDamageTime >= CombatTimeout)
+    {
+        bIsInCombat = false;
+    }
+    
+    ScheduleCombatTimeout();
+    RefreshNetDormancy();
 }
 
 void UCombatSystem::ReloadWeapon()
 {
-    if (!CurrentWeapon || bIsReloading)
+    const FWeaponData* WeaponData = GetCurrentWeaponData();
+    if (!WeaponData || bIsReloading || WeaponSlots[CurrentSlot].CurrentAmmo >= WeaponData->MaxAmmo)
     {
         return;
     }
     
     bIsReloading = true;
+    RefreshNetDormancy();
     
     // Play reload animation
     if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
@@ -344,7 +603,7 @@ void UCombatSystem::ReloadWeapon()
         ReloadTimer,
         this,
         &UCombatSystem::FinishReload,
-        CurrentWeapon->GetReloadTime(),
+        WeaponData->ReloadTime,
         false
     );
     
@@ -354,17 +613,22 @@ void UCombatSystem::ReloadWeapon()
 
 void UCombatSystem::FinishReload()
 {
-    if (CurrentWeapon)
+    if (const FWeaponData* WeaponData = GetCurrentWeaponData())
     {
-        CurrentWeapon->Reload();
+        WeaponSlots[CurrentSlot].CurrentAmmo = WeaponData->MaxAmmo;
+        if (CurrentWeapon)
+        {
+            CurrentWeapon->Reload();
+        }
         bIsReloading = false;
+        RefreshNetDormancy();
         
         // Play reload complete sound
         PlayReloadCompleteSound();
     }
 }
 
-void UCombatSystem::Die(AActor* Killer)
+void UCombatSystem::Die(AActor* Killer, int32 KillerTelemetryId)
 {
     // Play death animation
     if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
@@ -375,8 +639,21 @@ void UCombatSystem::Die(AActor* Killer)
     // Spawn death effects
     SpawnDeathEffects();
     
+    if (CombatTelemetry)
+    {
+        CombatTelemetry->RecordEvent(ECombatTelemetryEventType::Kill, KillerTelemetryId, TelemetryId);
+    }
+    
     // Disable combat system
     SetComponentTickEnabled(false);
+    if (CombatRegistry)
+    {
+        CombatRegistry->NotifyDied(this);
+    }
+    if (CombatAIScheduler)
+    {
+        CombatAIScheduler->UnregisterCombatant(this);
+    }
     
     // Notify game mode
     if (AGameModeBase* GameMode = GetWorld()->GetAuthGameMode())
@@ -387,7 +664,7 @@ void UCombatSystem::Die(AActor* Killer)
     // Notify UI
     OnDeath.Broadcast(Killer);
     
-    UE_LOG(LogTemp, Warning, TEXT("Combat system destroyed for: %s"), *GetOwner()->GetName());
+    UE_LOG(LogCelestialCombat, Verbose, TEXT("Combat system destroyed for: %s"), *GetOwner()->GetName());
 }
 
 void UCombatSystem::InitializeAICombat(AAICharacter* AICharacter)
@@ -420,13 +697,18 @@ void UCombatSystem::UpdateAICombat(AAICharacter* AICharacter, float DeltaTime)
     // Update AI combat state
     AICombatData.UpdateCombatState(DeltaTime);
     
-    // Check for targets
-    AActor* CurrentTarget = AICharacter->GetCurrentTarget();
+    // Check for targets; dead or departed targets are dropped
+    CurrentTarget = AICharacter->GetCurrentTarget();
+    if (CurrentTarget && !IsValidTarget(CurrentTarget))
+    {
+        CurrentTarget = nullptr;
+        AICharacter->SetCurrentTarget(nullptr);
+        NotifyCombatAction(ECombatAction::TargetLost);
+    }
+    RefreshTickEnabled();
+    
     if (CurrentTarget)
     {
-        // Update target tracking
-        UpdateTargetTracking(CurrentTarget);
-        
         // Make combat decisions
         MakeCombatDecision(AICharacter, CurrentTarget);
     }
@@ -488,28 +770,40 @@ void UCombatSystem::MakeCombatDecision(AAICharacter* AICharacter, AActor* Target
     
     float DistanceToTarget = FVector::Dist(AICharacter->GetActorLocation(), Target->GetActorLocation());
     
-    // Tactical decision making
-    if (DistanceToTarget > CombatRange)
-    {
-        // Target is too far, move closer
-        AICharacter->MoveToTarget(Target);
-    }
-    else if (DistanceToTarget < TacticalRange)
+    FAICombatDecisionInputs Inputs;
+    Inputs.Target = Target;
+    Inputs.RangeBand = DistanceToTarget > CombatRange ? 2 : (DistanceToTarget < TacticalRange ? 0 : 1);
+    Inputs.bLowHealth = GetCurrentHealth() < MaxHealth * LowHealthFraction;
+    Inputs.bRecentlyDamaged = GetWorld()->GetTimeSeconds() - LastDamageTime < RecentDamageWindow;
+    
+    // Tactical decision making, only when the situation changed; orders are issued once per decision
+    if (CachedDecision == EAICombatDecision::None || !(Inputs == CachedDecisionInputs))
     {
-        // Target is close, take cover or engage
-        if (ShouldTakeCover(AICharacter, Target))
+        CachedDecisionInputs = Inputs;
+        
+        if (Inputs.RangeBand == 2)
         {
+            // Target is too far, move closer
+            CachedDecision = EAICombatDecision::Approach;
+            AICharacter->MoveToTarget(Target);
+            RefreshNetDormancy();
+        }
+        else if (Inputs.RangeBand == 0 && ShouldTakeCover(AICharacter, Target))
+        {
+            // Target is close, take cover
+            CachedDecision = EAICombatDecision::TakeCover;
             AICharacter->FindCover(Target);
+            NotifyCombatAction(ECombatAction::CoverTaken);
         }
         else
         {
-            // Engage target
-            FireWeapon();
+            // Close or optimal range, engage
+            CachedDecision = EAICombatDecision::Engage;
         }
     }
-    else
+    
+    if (CachedDecision == EAICombatDecision::Engage)
     {
-        // Optimal range, engage
         FireWeapon();
     }
 }
@@ -522,13 +816,13 @@ bool UCombatSystem::ShouldTakeCover(AAICharacter* AICharacter, AActor* Target)
     }
     
     // Check health status
-    if (CurrentHealth < MaxHealth * 0.3f)
+    if (GetCurrentHealth() < MaxHealth * LowHealthFraction)
     {
         return true; // Low health, take cover
     }
     
     // Check if under heavy fire
-    if (GetWorld()->GetTimeSeconds() - LastDamageTime < 2.0f)
+    if (GetWorld()->GetTimeSeconds() - LastDamageTime < RecentDamageWindow)
     {
         return true; // Recently damaged, take cover
     }
@@ -539,135 +833,132 @@ bool UCombatSystem::ShouldTakeCover(AAICharacter* AICharacter, AActor* Target)
 
 void UCombatSystem::SearchForTargets(AAICharacter* AICharacter)
 {
+    CELESTIAL_COMBAT_SCOPE(SearchForTargets);
+    
     if (!AICharacter)
     {
         return;
     }
     
-    // Get all actors in perception range
-    TArray<AActor*> PerceivedActors;
-    AICharacter->GetPerceivedActors(PerceivedActors);
-    
-    // Find best target
-    AActor* BestTarget = nullptr;
-    float BestScore = 0.0f;
-    
-    for (AActor* Actor : PerceivedActors)
+    // The shared grid answers in a later frame, so queue at most one query
+    if (!bTargetQueryPending && CombatTargeting)
     {
-        if (IsValidTarget(Actor))
-        {
-            float Score = CalculateTargetScore(AICharacter, Actor);
-            if (Score > BestScore)
-            {
-                BestScore = Score;
-                BestTarget = Actor;
-            }
-        }
+        bTargetQueryPending = true;
+        CombatTargeting->RequestBestTarget(this, CombatRange);
     }
+}
+
+void UCombatSystem::HandleTargetQueryResult(AActor* Target)
+{
+    bTargetQueryPending = false;
     
     // Set new target
-    if (BestTarget)
+    AAICharacter* AICharacter = Cast<AAICharacter>(GetOwner());
+    if (AICharacter && Target && IsAlive())
     {
-        AICharacter->SetCurrentTarget(BestTarget);
+        AICharacter->SetCurrentTarget(Target);
+        CurrentTarget = Target;
+        RefreshTickEnabled();
+        RefreshNetDormancy();
+        NotifyCombatAction(ECombatAction::TargetAcquired);
     }
 }
 
-bool UCombatSystem::IsValidTarget(AActor* Actor)
+FCombatCrowdState UCombatSystem::GetCrowdState() const
 {
-    if (!Actor)
-    {
-        return false;
-    }
+    FCombatCrowdState State;
+    State.Health = GetCurrentHealth();
+    State.MaxHealth = MaxHealth;
+    State.Shield = GetCurrentShield();
+    State.ShieldCapacity = ShieldCapacity;
+    State.TeamId = TeamId;
+    State.WeaponIndex = FMath::Max(CurrentSlot, 0);
+    State.Ammo = GetCurrentAmmo();
+    State.CombatRange = CombatRange;
+    return State;
+}
+
+void UCombatSystem::ApplyCrowdState(const FCombatCrowdState& State)
+{
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    SettleRegen(WorldTime);
     
-    // Check if actor is enemy
-    if (Actor->GetTeam() == GetOwner()->GetTeam())
-    {
-        return false;
-    }
+    MaxHealth = State.MaxHealth;
+    CurrentHealth = FMath::Clamp(State.Health, 0.0f, MaxHealth);
+    ShieldCapacity = State.ShieldCapacity;
+    CurrentShield = FMath::Clamp(State.Shield, 0.0f, ShieldCapacity);
+    CombatRange = State.CombatRange;
     
-    // Check if actor has combat system
-    UCombatSystem* TargetCombat = Actor->FindComponentByClass<UCombatSystem>();
-    if (!TargetCombat)
+    // The registry keys its team at registration
+    if (TeamId != State.TeamId)
     {
-        return false;
+        TeamId = State.TeamId;
+        if (CombatRegistry)
+        {
+            CombatRegistry->UnregisterCombatant(this);
+            CombatRegistry->RegisterCombatant(this);
+        }
+        if (CombatTelemetry)
+        {
+            CombatTelemetry->UpdateCombatantTeam(TelemetryId, TeamId);
+        }
     }
     
-    // Check if target is alive
-    if (TargetCombat->GetCurrentHealth() <= 0.0f)
+    EquipWeapon(State.WeaponIndex);
+    const FWeaponData* WeaponData = GetCurrentWeaponData();
+    if (WeaponData && State.Ammo >= 0)
     {
-        return false;
+        WeaponSlots[CurrentSlot].CurrentAmmo = FMath::Min(State.Ammo, WeaponData->MaxAmmo);
     }
     
-    return true;
+    ScheduleCombatTimeout();
+    RefreshNetDormancy();
+    
+    OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+    OnShieldChanged.Broadcast(CurrentShield, ShieldCapacity);
 }
 
-float UCombatSystem::CalculateTargetScore(AAICharacter* AICharacter, AActor* Target)
+bool UCombatSystem::IsValidTarget(AActor* Actor)
 {
-    if (!AICharacter || !Target)
+    if (!Actor || !CombatRegistry)
     {
-        return 0.0f;
-    }
-    
-    float Score = 0.0f;
-    
-    // Distance factor (closer is better)
-    float Distance = FVector::Dist(AICharacter->GetActorLocation(), Target->GetActorLocation());
-    Score += 1000.0f / (Distance + 1.0f);
-    
-    // Health factor (weaker targets are better)
-    UCombatSystem* TargetCombat = Target->FindComponentByClass<UCombatSystem>();
-    if (TargetCombat)
-    {
-        float HealthPercent = TargetCombat->GetCurrentHealth() / TargetCombat->GetMaxHealth();
-        Score += (1.0f - HealthPercent) * 500.0f;
+        return false;
     }
     
-    // Threat factor (targets that are attacking us are higher priority)
-    if (Target->GetCurrentTarget() == AICharacter)
+    // Check if actor has combat system
+    const FCombatantEntry* Entry = CombatRegistry->FindCombatant(Actor);
+    if (!Entry)
     {
-        Score += 300.0f;
+        return false;
     }
     
-    return Score;
+    // Check if actor is enemy and alive
+    return Entry->TeamId != TeamId && Entry->bAlive;
 }
 
 void UCombatSystem::SpawnImpactEffects(const FHitResult& HitResult)
 {
-    if (!ImpactEffect)
+    if (!ImpactEffect || !CombatFeedback)
     {
         return;
     }
     
     // Spawn impact particle effect
-    UGameplayStatics::SpawnEmitterAtLocation(
-        GetWorld(),
-        ImpactEffect,
-        HitResult.Location,
-        HitResult.Normal.Rotation()
-    );
+    CombatFeedback->SpawnEffect(ImpactEffect, HitResult.Location, HitResult.Normal.Rotation());
     
     // Play impact sound
-    UGameplayStatics::PlaySoundAtLocation(
-        GetWorld(),
-        ImpactSound,
-        HitResult.Location
-    );
+    CombatFeedback->PlaySound(ImpactSound, HitResult.Location);
 }
 
 void UCombatSystem::SpawnDamageEffects(AActor* Target, float Damage, const FHitResult& HitResult)
 {
-    if (!Target || !DamageEffect)
+    if (!Target || !DamageEffect || !CombatFeedback)
     {
         return;
     }
     
     // Spawn damage particle effect
-    UGameplayStatics::SpawnEmitterAtLocation(
-        GetWorld(),
-        DamageEffect,
-        HitResult.Location,
-        HitResult.Normal.Rotation()
-    );
+    CombatFeedback->SpawnEffect(DamageEffect, HitResult.Location, HitResult.Normal.Rotation());
     
     // Show damage number
     ShowDamageNumber(Target, Damage, HitResult.Location);
@@ -675,145 +966,85 @@ void UCombatSystem::SpawnDamageEffects(AActor* Target, float Damage, const FHitR
 
 void UCombatSystem::ShowDamageNumber(AActor* Target, float Damage, const FVector& Location)
 {
-    // Create damage number widget
-    if (DamageNumberClass)
+    // Reuse a pooled damage number widget
+    if (DamageNumberClass && CombatFeedback)
     {
-        UDamageNumber* DamageNumber = CreateWidget<UDamageNumber>(GetWorld(), DamageNumberClass);
-        if (DamageNumber)
-        {
-            DamageNumber->SetDamage(Damage);
-            DamageNumber->SetWorldLocation(Location);
-            DamageNumber->AddToViewport();
-        }
+        CombatFeedback->ShowDamageNumber(DamageNumberClass, Damage, Location);
     }
 }
 
 void UCombatSystem::PlayWeaponEffects()
 {
-    if (!CurrentWeapon)
+    if (!CombatFeedback)
     {
         return;
     }
     
-    // Play muzzle flash
-    if (MuzzleFlashEffect)
+    // Play muzzle flash; slots without a presentation actor have no muzzle to attach to
+    if (CurrentWeapon)
     {
-        UGameplayStatics::SpawnEmitterAttached(
-            MuzzleFlashEffect,
-            CurrentWeapon->GetMeshComponent(),
-            TEXT("Muzzle")
-        );
+        CombatFeedback->SpawnEffectAttached(MuzzleFlashEffect, CurrentWeapon->GetMeshComponent(), TEXT("Muzzle"));
     }
     
     // Play weapon sound
-    if (WeaponFireSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            WeaponFireSound,
-            GetOwner()->GetActorLocation()
-        );
-    }
+    CombatFeedback->PlaySound(WeaponFireSound, GetOwner()->GetActorLocation());
 }
 
 void UCombatSystem::PlayShieldHitEffect()
 {
-    if (ShieldHitEffect)
+    if (CombatFeedback)
     {
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(),
-            ShieldHitEffect,
-            GetOwner()->GetActorLocation()
-        );
-    }
-    
-    if (ShieldHitSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            ShieldHitSound,
-            GetOwner()->GetActorLocation()
-        );
+        CombatFeedback->SpawnEffect(ShieldHitEffect, GetOwner()->GetActorLocation());
+        CombatFeedback->PlaySound(ShieldHitSound, GetOwner()->GetActorLocation());
     }
 }
 
 void UCombatSystem::PlayDamageEffect()
 {
-    if (DamageEffect)
+    if (CombatFeedback)
     {
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(),
-            DamageEffect,
-            GetOwner()->GetActorLocation()
-        );
-    }
-    
-    if (DamageSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            DamageSound,
-            GetOwner()->GetActorLocation()
-        );
+        CombatFeedback->SpawnEffect(DamageEffect, GetOwner()->GetActorLocation());
+        CombatFeedback->PlaySound(DamageSound, GetOwner()->GetActorLocation());
     }
 }
 
 void UCombatSystem::SpawnDeathEffects()
 {
-    if (DeathEffect)
+    if (CombatFeedback)
     {
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(),
-            DeathEffect,
-            GetOwner()->GetActorLocation()
-        );
-    }
-    
-    if (DeathSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            DeathSound,
-            GetOwner()->GetActorLocation()
-        );
+        CombatFeedback->SpawnEffect(DeathEffect, GetOwner()->GetActorLocation());
+        CombatFeedback->PlaySound(DeathSound, GetOwner()->GetActorLocation());
     }
 }
 
 void UCombatSystem::PlayReloadSound()
 {
-    if (ReloadSound)
+    if (CombatFeedback)
     {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            ReloadSound,
-            GetOwner()->GetActorLocation()
-        );
+        CombatFeedback->PlaySound(ReloadSound, GetOwner()->GetActorLocation());
     }
 }
 
 void UCombatSystem::PlayReloadCompleteSound()
 {
-    if (ReloadCompleteSound)
+    if (CombatFeedback)
     {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            ReloadCompleteSound,
-            GetOwner()->GetActorLocation()
-        );
+        CombatFeedback->PlaySound(ReloadCompleteSound, GetOwner()->GetActorLocation());
     }
 }
 
 bool UCombatSystem::CanFire() const
 {
-    return !bIsReloading && CurrentWeapon && CurrentWeapon->GetCurrentAmmo() > 0;
+    return !bIsReloading && GetCurrentAmmo() > 0;
 }
 
-void UCombatSystem::UpdateCombatState(float DeltaTime)
+void UCombatSystem::RefreshTickEnabled()
 {
-    // Check if out of combat
-    if (GetWorld()->GetTimeSeconds() - LastDamageTime > 10.0f)
+    // Per-frame work is aim tracking and weapon actor effects; idle combatants do not tick
+    const bool bNeedsTick = IsAlive() && (CurrentWeapon || (AIOwner && CurrentTarget));
+    if (IsComponentTickEnabled() != bNeedsTick)
     {
-        bIsInCombat = false;
+        SetComponentTickEnabled(bNeedsTick);
     }
 }
 
@@ -825,20 +1056,25 @@ void UCombatSystem::UpdateWeaponEffects(float DeltaTime)
     }
 }
 
-void UCombatSystem::UpdateCombatStats(float Damage, AActor* Target)
+FCombatStats UCombatSystem::GetCombatStats() const
 {
-    // Update statistics
-    TotalDamageDealt += Damage;
-    TargetsHit++;
-    
-    // Check for kill
-    UCombatSystem* TargetCombat = Target->FindComponentByClass<UCombatSystem>();
-    if (TargetCombat && TargetCombat->GetCurrentHealth() <= 0.0f)
+    return CombatTelemetry ? CombatTelemetry->GetCombatStats(TelemetryId) : FCombatStats();
+}
+
+void UCombatSystem::ResetCombatStats()
+{
+    if (CombatTelemetry)
     {
-        Kills++;
+        CombatTelemetry->ResetCombatant(TelemetryId);
     }
 }
 
+int32 UCombatSystem::GetTelemetryId(const AActor* Actor) const
+{
+    const UCombatSystem* Combat = CombatRegistry ? CombatRegistry->FindCombatSystem(Actor) : nullptr;
+    return Combat ? Combat->TelemetryId : INDEX_NONE;
+}
+
 void UCombatSystem::NotifyCombatAction(ECombatAction Action)
 {
     // Notify AI systems and other components
@@ -849,8 +1085,76 @@ void UCombatSystem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLif
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     
-    DOREPLIFETIME(UCombatSystem, CurrentHealth);
-    DOREPLIFETIME(UCombatSystem, CurrentShield);
-    DOREPLIFETIME(UCombatSystem, bIsInCombat);
-    DOREPLIFETIME(UCombatSystem, bIsReloading);
+    DOREPLIFETIME_CONDITION(UCombatSystem, MaxHealth, COND_InitialOnly);
+    DOREPLIFETIME_CONDITION(UCombatSystem, ShieldCapacity, COND_InitialOnly);
+    DOREPLIFETIME(UCombatSystem, ReplicatedCombatState);
+    DOREPLIFETIME_CONDITION(UCombatSystem, bIsReloading, COND_OwnerOnly);
+}
+
+void UCombatSystem::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    Super::PreReplication(ChangedPropertyTracker);
+    
+    // Clients receive regenerated values without the server applying them every frame
+    SettleRegen(GetWorld()->GetTimeSeconds());
+    PackReplicatedCombatState();
+}
+
+void UCombatSystem::PackReplicatedCombatState()
+{
+    ReplicatedCombatState = FReplicatedCombatState::Pack(CurrentHealth, MaxHealth, CurrentShield, ShieldCapacity, bIsInCombat);
+}
+
+void UCombatSystem::OnRep_ReplicatedCombatState()
+{
+    const float PreviousHealth = CurrentHealth;
+    const float PreviousShield = CurrentShield;
+    
+    CurrentHealth = ReplicatedCombatState.GetHealth(MaxHealth);
+    CurrentShield = ReplicatedCombatState.GetShield(ShieldCapacity);
+    bIsInCombat = ReplicatedCombatState.bIsInCombat;
+    
+    // Client UI hears the same events as the server's
+    if (CurrentHealth != PreviousHealth)
+    {
+        OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+    }
+    if (CurrentShield != PreviousShield)
+    {
+        OnShieldChanged.Broadcast(CurrentShield, ShieldCapacity);
+    }
+}
+
+void UCombatSystem::RefreshNetDormancy()
+{
+    AActor* Owner = GetOwner();
+    if (!bDormantWhenIdle || !AIOwner || !Owner || !Owner->HasAuthority() || !Owner->GetIsReplicated())
+    {
+        return;
+    }
+    
+    // Replicated state only changes while fighting, reloading or regenerating; approaching a target or
+    // any other movement needs the actor channel open as well
+    const bool bRegenerating = (ShieldRechargeRate > 0.0f && CurrentShield < ShieldCapacity)
+        || (HealthRegenRate > 0.0f && CurrentHealth < MaxHealth);
+    const bool bMoving = !Owner->GetVelocity().IsNearlyZero();
+    const bool bIdle = !IsAlive() || (!bIsInCombat && !bIsReloading && !bRegenerating && !CurrentTarget && !bMoving);
+    
+    if (bIdle)
+    {
+        // The last change still has to reach clients before the channel closes
+        PackReplicatedCombatState();
+        if (Owner->NetDormancy > DORM_Awake)
+        {
+            Owner->FlushNetDormancy();
+        }
+        else
+        {
+            Owner->SetNetDormancy(DORM_DormantAll);
+        }
+    }
+    else if (Owner->NetDormancy != DORM_Awake)
+    {
+        Owner->SetNetDormancy(DORM_Awake);
+    }
 } 
\ No newline at end of file
@@ -16,25 +16,22 @@
 #include "Sound/SoundBase.h"
 #include "Animation/AnimMontage.h"
 #include "Blueprint/UserWidget.h"
+#include "ReplicatedCombatState.h"
+#include "WeaponDefinitions.h"
 #include "CombatSystem.generated.h"
 
 // Forward declarations
 class AWeapon;
 class AAICharacter;
+class UCombatAISchedulerSubsystem;
+class UCombatFeedbackSubsystem;
+class UCombatHitscanSubsystem;
+class UCombatRegistrySubsystem;
+class UCombatTargetingSubsystem;
+class UCombatTelemetrySubsystem;
+class UCombatTimeoutSubsystem;
 class UDamageNumber;
 
-// Weapon types enumeration
-UENUM(BlueprintType)
-enum class EWeaponType : uint8
-{
-    PulseRifle     UMETA(DisplayName = "Pulse Rifle"),
-    PlasmaCannon   UMETA(DisplayName = "Plasma Cannon"),
-    QuantumBlaster UMETA(DisplayName = "Quantum Blaster"),
-    LaserRifle     UMETA(DisplayName = "Laser Rifle"),
-    IonCannon      UMETA(DisplayName = "Ion Cannon"),
-    MissileLauncher UMETA(DisplayName = "Missile Launcher")
-};
-
 // Combat actions enumeration
 UENUM(BlueprintType)
 enum class ECombatAction : uint8
@@ -48,46 +45,32 @@ enum class ECombatAction : uint8
     ReloadComplete UMETA(DisplayName = "Reload Complete")
 };
 
-// Weapon data structure
+// Standing AI combat decision, kept until its inputs change
+UENUM(BlueprintType)
+enum class EAICombatDecision : uint8
+{
+    None           UMETA(DisplayName = "None"),
+    Approach       UMETA(DisplayName = "Approach"),
+    TakeCover      UMETA(DisplayName = "Take Cover"),
+    Engage         UMETA(DisplayName = "Engage")
+};
+
+// Per-combatant weapon slot; the definition lives in the shared weapon table
 USTRUCT(BlueprintType)
-struct FWeaponData
+struct FWeaponSlot
 {
     GENERATED_BODY()
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    EWeaponType WeaponType;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    FString WeaponName;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    int32 MaxAmmo;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Damage;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float FireRate;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Range;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float ReloadTime;
+    int32 DefinitionIndex;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    TSubclassOf<AWeapon> WeaponClass;
+    int32 CurrentAmmo;
 
-    FWeaponData()
+    FWeaponSlot()
     {
-        WeaponType = EWeaponType::PulseRifle;
-        WeaponName = TEXT("Default Weapon");
-        MaxAmmo = 30;
-        Damage = 100.0f;
-        FireRate = 0.1f;
-        Range = 800.0f;
-        ReloadTime = 2.0f;
-        WeaponClass = nullptr;
+        DefinitionIndex = INDEX_NONE;
+        CurrentAmmo = 0;
     }
 };
 
@@ -135,6 +118,54 @@ struct FAICombatData
     }
 };
 
+// Inputs an AI combat decision depends on; the decision is re-made only when these change
+struct FAICombatDecisionInputs
+{
+    const AActor* Target;
+    uint8 RangeBand; // 0 inside TacticalRange, 1 engagement range, 2 beyond CombatRange
+    bool bLowHealth;
+    bool bRecentlyDamaged;
+
+    bool operator==(const FAICombatDecisionInputs& Other) const
+    {
+        return Target == Other.Target && RangeBand == Other.RangeBand
+            && bLowHealth == Other.bLowHealth && bRecentlyDamaged == Other.bRecentlyDamaged;
+    }
+
+    FAICombatDecisionInputs()
+    {
+        Target = nullptr;
+        RangeBand = 0;
+        bLowHealth = false;
+        bRecentlyDamaged = false;
+    }
+};
+
+// State carried between a combatant actor and its crowd entity on promotion and demotion
+struct FCombatCrowdState
+{
+    float Health;
+    float MaxHealth;
+    float Shield;
+    float ShieldCapacity;
+    int32 TeamId;
+    int32 WeaponIndex;
+    int32 Ammo;
+    float CombatRange;
+
+    FCombatCrowdState()
+    {
+        Health = 100.0f;
+        MaxHealth = 100.0f;
+        Shield = 50.0f;
+        ShieldCapacity = 50.0f;
+        TeamId = 0;
+        WeaponIndex = 0;
+        Ammo = INDEX_NONE;
+        CombatRange = 1000.0f;
+    }
+};
+
 // Combat statistics structure
 USTRUCT(BlueprintType)
 struct FCombatStats
@@ -225,6 +256,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
@@ -232,20 +264,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat|Health")
     void TakeDamage(float Damage, AActor* DamageCauser);
 
+    // Crowd fire has no causing actor; the shooting entities record their own damage dealt
+    void TakeCrowdDamage(float Damage, int32 KillerTelemetryId);
+
     UFUNCTION(BlueprintCallable, Category = "Combat|Health")
     void Heal(float Amount);
 
+    // Brings lazily regenerated health and shield up to date and notifies listeners
     UFUNCTION(BlueprintCallable, Category = "Combat|Shield")
     void RechargeShield();
 
+    // Health and shield include regeneration since the last change
     UFUNCTION(BlueprintPure, Category = "Combat|Health")
-    float GetCurrentHealth() const { return CurrentHealth; }
+    float GetCurrentHealth() const;
 
     UFUNCTION(BlueprintPure, Category = "Combat|Health")
     float GetMaxHealth() const { return MaxHealth; }
 
     UFUNCTION(BlueprintPure, Category = "Combat|Shield")
-    float GetCurrentShield() const { return CurrentShield; }
+    float GetCurrentShield() const;
 
     UFUNCTION(BlueprintPure, Category = "Combat|Shield")
     float GetMaxShield() const { return ShieldCapacity; }
@@ -266,6 +303,12 @@ public:
     UFUNCTION(BlueprintPure, Category = "Combat|Weapons")
     AWeapon* GetCurrentWeapon() const { return CurrentWeapon; }
 
+    UFUNCTION(BlueprintPure, Category = "Combat|Weapons")
+    int32 GetCurrentAmmo() const { return WeaponSlots.IsValidIndex(CurrentSlot) ? WeaponSlots[CurrentSlot].CurrentAmmo : 0; }
+
+    // Definition of the equipped weapon, or null when nothing is equipped
+    const FWeaponData* GetCurrentWeaponData() const;
+
     UFUNCTION(BlueprintPure, Category = "Combat|Weapons")
     bool IsReloading() const { return bIsReloading; }
 
@@ -285,6 +328,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat|AI")
     void MakeCombatDecision(AAICharacter* AICharacter, AActor* Target);
 
+    UFUNCTION(BlueprintPure, Category = "Combat|AI")
+    AActor* GetCurrentTarget() const { return CurrentTarget; }
+
+    // Answer to a query queued by SearchForTargets; null when no enemy was in range
+    void HandleTargetQueryResult(AActor* Target);
+
+    // Crowd promotion and demotion, see UCombatCrowdSubsystem. Apply after BeginPlay
+    FCombatCrowdState GetCrowdState() const;
+    void ApplyCrowdState(const FCombatCrowdState& State);
+
     // Combat State
     UFUNCTION(BlueprintPure, Category = "Combat|State")
     bool IsInCombat() const { return bIsInCombat; }
@@ -292,9 +345,12 @@ public:
     UFUNCTION(BlueprintPure, Category = "Combat|State")
     bool IsAlive() const { return CurrentHealth > 0.0f; }
 
+    UFUNCTION(BlueprintPure, Category = "Combat|State")
+    int32 GetTeamId() const { return TeamId; }
+
     // Combat Statistics
     UFUNCTION(BlueprintPure, Category = "Combat|Stats")
-    FCombatStats GetCombatStats() const { return CombatStats; }
+    FCombatStats GetCombatStats() const;
 
     UFUNCTION(BlueprintCallable, Category = "Combat|Stats")
     void ResetCombatStats();
@@ -304,13 +360,14 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Health", Replicated)
     float MaxHealth;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Health", Replicated)
+    // Authoritative on the server; clients unpack it from ReplicatedCombatState
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Health")
     float CurrentHealth;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Shield", Replicated)
     float ShieldCapacity;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Shield", Replicated)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Shield")
     float CurrentShield;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Shield")
@@ -319,23 +376,79 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Shield")
     float ShieldRechargeDelay;
 
-    // Weapon System
+    // Health per second after HealthRegenDelay without damage; zero disables
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Health")
+    float HealthRegenRate;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Health")
+    float HealthRegenDelay;
+
+    // Weapon System; falls back to the default definition set when unset
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Weapons")
-    TArray<AWeapon*> WeaponInventory;
+    UWeaponDefinitionSet* WeaponDefinitions;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Weapons")
+    TArray<FWeaponSlot> WeaponSlots;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|Weapons")
+    int32 CurrentSlot;
 
+    // Presentation actor of the equipped weapon; only spawned when its definition has a WeaponClass
     UPROPERTY(BlueprintReadOnly, Category = "Combat|Weapons")
     AWeapon* CurrentWeapon;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Weapons")
+    // Shared, immutable tables baked from WeaponDefinitions
+    FWeaponDefinitionTablePtr WeaponTable;
+    FBoneDamageTablePtr BoneDamageTable;
+    TWeakObjectPtr<const USkinnedAsset> BoneDamageTableMesh;
+
+    // Only the owning client needs reload state
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Weapons", Replicated)
     bool bIsReloading;
 
     // Combat State
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|State", Replicated)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|State")
     bool bIsInCombat;
 
+    // Health, shield and bIsInCombat packed for replication in PreReplication
+    UPROPERTY(ReplicatedUsing = OnRep_ReplicatedCombatState)
+    FReplicatedCombatState ReplicatedCombatState;
+
+    // AI owners go net dormant while out of combat, targetless, still and with nothing regenerating.
+    // Dormancy freezes movement replication too, so only stationary owners such as turrets should opt in
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|State")
+    bool bDormantWhenIdle;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|State")
     float LastDamageTime;
 
+    // Regeneration is evaluated from these rather than applied by timers
+    double LastDamageTakenTime;
+    double RegenSettledTime;
+
+    // Registry key, read once when the combatant registers
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|State")
+    int32 TeamId;
+
+    // Cached in BeginPlay so target resolution never walks components
+    UPROPERTY(Transient)
+    UCombatRegistrySubsystem* CombatRegistry;
+
+    UPROPERTY(Transient)
+    UCombatTargetingSubsystem* CombatTargeting;
+
+    UPROPERTY(Transient)
+    UCombatHitscanSubsystem* CombatHitscan;
+
+    UPROPERTY(Transient)
+    UCombatFeedbackSubsystem* CombatFeedback;
+
+    UPROPERTY(Transient)
+    UCombatAISchedulerSubsystem* CombatAIScheduler;
+
+    UPROPERTY(Transient)
+    UCombatTimeoutSubsystem* CombatTimeouts;
+
     // AI Combat Data
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|AI")
     FAICombatData AICombatData;
@@ -352,9 +465,27 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|AI")
     float AggressionLevel;
 
-    // Combat Statistics
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Stats")
-    FCombatStats CombatStats;
+    // Target being engaged, mirrored from the AI character for the targeting grid
+    UPROPERTY(Transient)
+    AActor* CurrentTarget;
+
+    // Set while a targeting query is queued so SearchForTargets does not queue another
+    bool bTargetQueryPending;
+
+    // Owner as an AI character, resolved once in BeginPlay; null for players
+    UPROPERTY(Transient)
+    AAICharacter* AIOwner;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|AI")
+    EAICombatDecision CachedDecision;
+
+    FAICombatDecisionInputs CachedDecisionInputs;
+
+    // Combat Statistics live in the telemetry store under this id
+    UPROPERTY(Transient)
+    UCombatTelemetrySubsystem* CombatTelemetry;
+
+    int32 TelemetryId;
 
     // Effects and Sounds
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Effects")
@@ -405,7 +536,6 @@ protected:
     TSubclassOf<UDamageNumber> DamageNumberClass;
 
     // Timers
-    FTimerHandle ShieldRechargeTimer;
     FTimerHandle ReloadTimer;
 
     // Combat Events
@@ -427,19 +557,44 @@ protected:
 private:
     // Internal helper functions
     void InitializeWeaponSystems();
-    AWeapon* CreateWeapon(const FWeaponData& WeaponData);
-    void ApplyDamage(AActor* Target, float Damage, const FHitResult& HitResult);
-    float CalculateDamage(float BaseDamage, const FHitResult& HitResult);
-    void Die(AActor* Killer);
+    const UWeaponDefinitionSet* GetWeaponDefinitions() const;
+    AWeapon* SpawnWeaponActor(const FWeaponData& WeaponData);
+    float GetBoneDamageMultiplier(const FHitResult& HitResult);
+    void ApplyDamage(AActor* Target, float Damage, float Range, const FHitResult& HitResult);
+    float CalculateDamage(float BaseDamage, float Range, const FHitResult& HitResult);
+    void ApplyIncomingDamage(float Damage, AActor* DamageCauser, int32 KillerTelemetryId);
+    void Die(AActor* Killer, int32 KillerTelemetryId);
     void FinishReload();
 
+    // AI decisions, driven by UCombatAISchedulerSubsystem
+    friend class UCombatAISchedulerSubsystem;
+    void RunScheduledAICombat(float DeltaTime);
+    int32 AIScheduleSlot;
+
+    // Shot resolution, driven by UCombatHitscanSubsystem the frame after FireWeapon
+    friend class UCombatHitscanSubsystem;
+    void ResolveHitscanShot(bool bHit, const FHitResult& HitResult, float Damage, float Range);
+
+    // Combat exit and regen completion, driven by UCombatTimeoutSubsystem
+    friend class UCombatTimeoutSubsystem;
+    void HandleCombatTimeout(double WorldTime);
+    void ScheduleCombatTimeout();
+    uint32 TimeoutGeneration;
+    double ScheduledTimeoutTime;
+
+    // Lazy regeneration
+    float EvaluateHealth(double WorldTime) const;
+    float EvaluateShield(double WorldTime) const;
+    double GetHealthRegenStartTime() const;
+    double GetShieldRegenStartTime() const;
+    void SettleRegen(double WorldTime);
+
     // AI Combat helpers
     void UpdateTargetTracking(AActor* Target);
     FVector PredictTargetLocation(const FVector& CurrentLocation, const FVector& Velocity);
     void UpdateAim(const FVector& TargetLocation);
     bool ShouldTakeCover(AAICharacter* AICharacter, AActor* Target);
     bool IsValidTarget(AActor* Actor);
-    float CalculateTargetScore(AAICharacter* AICharacter, AActor* Target);
 
     // Effect functions
     void SpawnImpactEffects(const FHitResult& HitResult);
@@ -453,11 +608,18 @@ private:
     void PlayReloadCompleteSound();
 
     // State management
-    void UpdateCombatState(float DeltaTime);
+    void RefreshTickEnabled();
     void UpdateWeaponEffects(float DeltaTime);
-    void UpdateCombatStats(float Damage, AActor* Target);
+    int32 GetTelemetryId(const AActor* Actor) const;
     void NotifyCombatAction(ECombatAction Action);
 
     // Networking
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+    UFUNCTION()
+    void OnRep_ReplicatedCombatState();
+
+    void PackReplicatedCombatState();
+    void RefreshNetDormancy();
 }; 
\ No newline at end of file
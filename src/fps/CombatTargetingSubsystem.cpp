@@ -0,0 +1,226 @@
+// CombatTargetingSubsystem.cpp
+// Combat Targeting Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements the combatant grid rebuild and the batched, time-sliced target queries
+// Feature Context: Gives AI "best target within CombatRange" without per-pair component lookups
+// Dependencies: Unreal Engine world subsystems, ParallelFor, CombatRegistrySubsystem, CombatSystem
+// Usage Example: Ticked by the world once per frame; idle while no queries are pending
+// Security: Requesters that are destroyed before their query runs are skipped
+// Performance: Grid build is two linear passes with no per-combatant allocation; queries in a batch run in parallel
+
+#include "CombatTargetingSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatRegistrySubsystem.h"
+#include "CombatSystem.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Target score weights, unchanged from the per-AI scoring they replace
+    constexpr float DistanceScoreWeight = 1000.0f;
+    constexpr float MissingHealthScoreWeight = 500.0f;
+    constexpr float ThreatScoreBonus = 300.0f;
+}
+
+UCombatTargetingSubsystem::UCombatTargetingSubsystem()
+{
+    CellSize = 1000.0f; // uu
+    GridRebuildInterval = 0.1f; // s
+    LastGridBuildTime = -1.0;
+    MaxQueriesPerFrame = 64;
+}
+
+void UCombatTargetingSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatTargeting);
+
+    if (PendingQueries.Num() == 0)
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (LastGridBuildTime < 0.0 || Now - LastGridBuildTime >= GridRebuildInterval)
+    {
+        RebuildGrid();
+        LastGridBuildTime = Now;
+    }
+
+    // Resolve this frame's slice on the game thread
+    struct FResolvedQuery
+    {
+        UCombatSystem* Requester;
+        const AActor* Self;
+        FVector Origin;
+        int32 TeamId;
+        float Range;
+        AActor* Result;
+    };
+
+    const int32 NumQueries = FMath::Min(PendingQueries.Num(), MaxQueriesPerFrame);
+    TArray<FResolvedQuery, TInlineAllocator<64>> Batch;
+    for (int32 i = 0; i < NumQueries; i++)
+    {
+        UCombatSystem* Requester = PendingQueries[i].Requester.Get();
+        const AActor* Self = Requester ? Requester->GetOwner() : nullptr;
+        if (Self)
+        {
+            Batch.Add({ Requester, Self, Self->GetActorLocation(), Requester->GetTeamId(), PendingQueries[i].Range, nullptr });
+        }
+    }
+    PendingQueries.RemoveAt(0, NumQueries, false);
+
+    // Workers read only the packed grid
+    ParallelFor(Batch.Num(), [this, &Batch](int32 Index)
+    {
+        FResolvedQuery& Query = Batch[Index];
+        Query.Result = FindBestTarget(Query.Self, Query.Origin, Query.TeamId, Query.Range);
+    });
+
+    // The grid can be GridRebuildInterval old: drop results destroyed, killed or moved to our side since
+    const UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    for (const FResolvedQuery& Query : Batch)
+    {
+        AActor* Result = Query.Result;
+        if (Result)
+        {
+            const UCombatSystem* TargetCombat = IsValid(Result) && Registry ? Registry->FindCombatSystem(Result) : nullptr;
+            if (!TargetCombat || !TargetCombat->IsAlive() || TargetCombat->GetTeamId() == Query.Requester->GetTeamId())
+            {
+                Result = nullptr;
+            }
+        }
+        Query.Requester->HandleTargetQueryResult(Result);
+    }
+}
+
+TStatId UCombatTargetingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTargetingSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatTargetingSubsystem::RequestBestTarget(UCombatSystem* Requester, float Range)
+{
+    if (Requester)
+    {
+        PendingQueries.Add({ Requester, Range });
+    }
+}
+
+FIntVector UCombatTargetingSubsystem::GetCellKey(const FVector& Position) const
+{
+    const FVector Cell = Position / CellSize;
+    return FIntVector(FMath::FloorToInt32(Cell.X), FMath::FloorToInt32(Cell.Y), FMath::FloorToInt32(Cell.Z));
+}
+
+void UCombatTargetingSubsystem::RebuildGrid()
+{
+    Cells.Reset();
+    ScratchCombatants.Reset();
+
+    const UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (!Registry)
+    {
+        Positions.Reset();
+        Teams.Reset();
+        HealthFractions.Reset();
+        CurrentTargets.Reset();
+        Actors.Reset();
+        return;
+    }
+
+    // Count live combatants per cell
+    for (UCombatSystem* Combat : Registry->GetAllCombatants())
+    {
+        if (Combat->IsAlive())
+        {
+            const FIntVector Key = GetCellKey(Combat->GetOwner()->GetActorLocation());
+            ScratchCombatants.Emplace(Combat, Key);
+            Cells.FindOrAdd(Key, { 0, 0 }).Count++;
+        }
+    }
+
+    // Give each cell its contiguous range
+    int32 NumLive = 0;
+    for (TPair<FIntVector, FCombatGridCell>& Pair : Cells)
+    {
+        Pair.Value.Start = NumLive;
+        NumLive += Pair.Value.Count;
+        Pair.Value.Count = 0;
+    }
+
+    Positions.SetNumUninitialized(NumLive);
+    Teams.SetNumUninitialized(NumLive);
+    HealthFractions.SetNumUninitialized(NumLive);
+    CurrentTargets.SetNumUninitialized(NumLive);
+    Actors.SetNumUninitialized(NumLive);
+
+    // Scatter into cell order
+    for (const TPair<UCombatSystem*, FIntVector>& Sample : ScratchCombatants)
+    {
+        const UCombatSystem* Combat = Sample.Key;
+        FCombatGridCell& Cell = Cells.FindChecked(Sample.Value);
+        const int32 Slot = Cell.Start + Cell.Count++;
+
+        Actors[Slot] = Combat->GetOwner();
+        Positions[Slot] = Actors[Slot]->GetActorLocation();
+        Teams[Slot] = Combat->GetTeamId();
+        HealthFractions[Slot] = Combat->GetMaxHealth() > 0.0f ? Combat->GetCurrentHealth() / Combat->GetMaxHealth() : 0.0f;
+        CurrentTargets[Slot] = Combat->GetCurrentTarget();
+    }
+}
+
+AActor* UCombatTargetingSubsystem::FindBestTarget(const AActor* Self, const FVector& Origin, int32 TeamId, float Range) const
+{
+    const FIntVector MinCell = GetCellKey(Origin - FVector(Range));
+    const FIntVector MaxCell = GetCellKey(Origin + FVector(Range));
+    const float RangeSquared = Range * Range;
+
+    AActor* BestTarget = nullptr;
+    float BestScore = 0.0f;
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            {
+                const FCombatGridCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+                if (!Cell)
+                {
+                    continue;
+                }
+
+                const int32 End = Cell->Start + Cell->Count;
+                for (int32 i = Cell->Start; i < End; i++)
+                {
+                    if (Teams[i] == TeamId)
+                    {
+                        continue;
+                    }
+
+                    const float DistanceSquared = FVector::DistSquared(Origin, Positions[i]);
+                    if (DistanceSquared > RangeSquared)
+                    {
+                        continue;
+                    }
+
+                    // Closer, weaker and already-engaged targets score higher
+                    float Score = DistanceScoreWeight / (FMath::Sqrt(DistanceSquared) + 1.0f);
+                    Score += (1.0f - HealthFractions[i]) * MissingHealthScoreWeight;
+                    if (CurrentTargets[i] == Self)
+                    {
+                        Score += ThreatScoreBonus;
+                    }
+
+                    if (Score > BestScore)
+                    {
+                        BestScore = Score;
+                        BestTarget = Actors[i];
+                    }
+                }
+            }
+        }
+    }
+
+    return BestTarget;
+}
@@ -0,0 +1,80 @@
+// CombatTargetingSubsystem.h
+// Combat Targeting Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the shared uniform-grid index of live combatants and its queued target queries
+// Feature Context: Replaces per-AI perception scans and pairwise scoring in UCombatSystem::SearchForTargets
+// Dependencies: Unreal Engine world subsystems, ParallelFor, CombatRegistrySubsystem, CombatSystem
+// Usage Example: UCombatSystem queues RequestBestTarget(this, CombatRange) and receives HandleTargetQueryResult
+// Security: Worker tasks read only the packed grid arrays; results are applied to combatants on the game thread
+// Performance: Each query visits only the cells its range overlaps, and at most MaxQueriesPerFrame run per frame
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTargetingSubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class UCombatSystem;
+
+// Contiguous run of combatants sharing one grid cell
+struct FCombatGridCell
+{
+    int32 Start;
+    int32 Count;
+};
+
+// Queued request for the best enemy within range of a combatant
+struct FCombatTargetQuery
+{
+    TWeakObjectPtr<UCombatSystem> Requester;
+    float Range;
+};
+
+// World-level target acquisition for AI combatants
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatTargetingSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatTargetingSubsystem();
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Queues a query; the answer (possibly null) arrives through Requester->HandleTargetQueryResult
+    void RequestBestTarget(UCombatSystem* Requester, float Range);
+
+    int32 GetNumPendingQueries() const { return PendingQueries.Num(); }
+
+private:
+    // Grid cell edge (uu); sized to the default CombatRange so a query spans at most 3x3x3 cells
+    float CellSize;
+
+    // The grid is rebuilt at most this often (s), and only while queries are pending
+    float GridRebuildInterval;
+    double LastGridBuildTime;
+
+    // Queries answered per frame; the rest wait for later frames
+    int32 MaxQueriesPerFrame;
+
+    TArray<FCombatTargetQuery> PendingQueries;
+
+    // Live combatants in cell order, one entry per combatant in each array
+    TArray<FVector> Positions;
+    TArray<int32> Teams;
+    TArray<float> HealthFractions;
+    TArray<const AActor*> CurrentTargets;
+    TArray<AActor*> Actors;
+
+    TMap<FIntVector, FCombatGridCell> Cells;
+
+    // Registry combatant and cell key of each live combatant, reused across rebuilds
+    TArray<TPair<UCombatSystem*, FIntVector>> ScratchCombatants;
+
+    FIntVector GetCellKey(const FVector& Position) const;
+    void RebuildGrid();
+    AActor* FindBestTarget(const AActor* Self, const FVector& Origin, int32 TeamId, float Range) const;
+};
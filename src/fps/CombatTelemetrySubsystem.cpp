@@ -0,0 +1,339 @@
+// CombatTelemetrySubsystem.cpp
+// Combat Telemetry Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements event recording, draining into the stats store and batched analytics export
+// Feature Context: Gives UCombatSystem::GetCombatStats real shot, hit, damage and kill counts
+// Dependencies: Unreal Engine world subsystems, HTTP and JSON modules, cloud analytics service (/api/analytics/track-batch)
+// Usage Example: Ticked by the world once per frame to drain rings; exports every ExportInterval seconds and on Deinitialize
+// Security: Events naming unregistered ids are dropped when applied rather than trusted
+// Performance: Each thread's first event allocates its ring; every later event is a copy and two atomic operations
+
+#include "CombatTelemetrySubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatSystem.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    std::atomic<uint32> NextTelemetryStreamId{ 1 };
+
+    // Rings this thread has created, by owning subsystem; entries of destroyed subsystems never match again
+    struct FThreadTelemetryRing
+    {
+        uint32 StreamId;
+        FCombatTelemetryRing* Ring;
+    };
+
+    constexpr int32 MaxCachedThreadRings = 8;
+    thread_local TArray<FThreadTelemetryRing, TInlineAllocator<MaxCachedThreadRings>> ThreadTelemetryRings;
+}
+
+UCombatTelemetrySubsystem::UCombatTelemetrySubsystem()
+{
+    ExportInterval = 30.0f; // s
+    MaxRecordsPerBatch = 500;
+
+    StreamId = 0;
+    NextExportTime = 0.0;
+    NumDroppedEvents = 0;
+}
+
+void UCombatTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    StreamId = NextTelemetryStreamId.fetch_add(1, std::memory_order_relaxed);
+    MatchId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+    NextExportTime = ExportInterval;
+}
+
+void UCombatTelemetrySubsystem::Deinitialize()
+{
+    // The match is over: send whatever the last interval collected
+    DrainEvents();
+    ExportStats();
+
+    FScopeLock Lock(&RingLock);
+    Rings.Reset();
+
+    Super::Deinitialize();
+}
+
+void UCombatTelemetrySubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatTelemetry);
+
+    DrainEvents();
+
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+    if (WorldTime >= NextExportTime)
+    {
+        ExportStats();
+        NextExportTime = WorldTime + ExportInterval;
+    }
+}
+
+TStatId UCombatTelemetrySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+int32 UCombatTelemetrySubsystem::RegisterCombatant(const UCombatSystem* Combat)
+{
+    const AActor* Owner = Combat ? Combat->GetOwner() : nullptr;
+    return RegisterCombatant(Owner ? Owner->GetName() : FString(), Combat ? Combat->GetTeamId() : 0);
+}
+
+int32 UCombatTelemetrySubsystem::RegisterCombatant(const FString& Name, int32 TeamId)
+{
+    check(IsInGameThread());
+
+    Names.Add(Name);
+    TeamIds.Add(TeamId);
+    Kills.Add(0);
+    Deaths.Add(0);
+    ShotsFired.Add(0);
+    ShotsHit.Add(0);
+    DamageDealt.Add(0.0f);
+    DamageTaken.Add(0.0f);
+    Dirty.Add(true);
+
+    return Names.Num() - 1;
+}
+
+void UCombatTelemetrySubsystem::UpdateCombatantTeam(int32 CombatantId, int32 TeamId)
+{
+    check(IsInGameThread());
+
+    if (TeamIds.IsValidIndex(CombatantId) && TeamIds[CombatantId] != TeamId)
+    {
+        TeamIds[CombatantId] = TeamId;
+        Dirty[CombatantId] = true;
+    }
+}
+
+void UCombatTelemetrySubsystem::RecordEvent(ECombatTelemetryEventType Type, int32 Instigator, int32 Target, float Amount)
+{
+    FCombatTelemetryEvent Event;
+    Event.Instigator = Instigator;
+    Event.Target = Target;
+    Event.Amount = Amount;
+    Event.Type = Type;
+
+    if (FCombatTelemetryRing* Ring = GetThreadRing())
+    {
+        Ring->Push(Event);
+    }
+}
+
+FCombatStats UCombatTelemetrySubsystem::GetCombatStats(int32 CombatantId) const
+{
+    FCombatStats Stats;
+    if (!Names.IsValidIndex(CombatantId))
+    {
+        return Stats;
+    }
+
+    Stats.Kills = Kills[CombatantId];
+    Stats.Deaths = Deaths[CombatantId];
+    Stats.ShotsFired = ShotsFired[CombatantId];
+    Stats.ShotsHit = ShotsHit[CombatantId];
+    Stats.TargetsHit = ShotsHit[CombatantId];
+    Stats.TotalDamageDealt = DamageDealt[CombatantId];
+    Stats.TotalDamageTaken = DamageTaken[CombatantId];
+    Stats.UpdateAccuracy();
+    Stats.UpdateKDRatio();
+    return Stats;
+}
+
+void UCombatTelemetrySubsystem::ResetCombatant(int32 CombatantId)
+{
+    if (!Names.IsValidIndex(CombatantId))
+    {
+        return;
+    }
+
+    // Events still in flight land on the cleared counters
+    Kills[CombatantId] = 0;
+    Deaths[CombatantId] = 0;
+    ShotsFired[CombatantId] = 0;
+    ShotsHit[CombatantId] = 0;
+    DamageDealt[CombatantId] = 0.0f;
+    DamageTaken[CombatantId] = 0.0f;
+    Dirty[CombatantId] = true;
+}
+
+void UCombatTelemetrySubsystem::ExportStats()
+{
+    if (!IsExportEnabled())
+    {
+        return;
+    }
+
+    if (NumDroppedEvents > 0)
+    {
+        UE_LOG(LogCelestialCombat, Warning, TEXT("Combat telemetry dropped %lld events; stats for match %s are incomplete"), NumDroppedEvents, *MatchId);
+    }
+
+    // Records carry cumulative totals, so a lost batch is corrected by the next one
+    TArray<TSharedPtr<FJsonValue>> Records;
+    const int32 BatchSize = FMath::Clamp(MaxRecordsPerBatch, 1, 1000);
+    auto SendBatch = [this, &Records]()
+    {
+        TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+        Body->SetArrayField(TEXT("events"), Records);
+
+        FString Content;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
+        FJsonSerializer::Serialize(Body, Writer);
+
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+        Request->SetURL(AnalyticsEndpoint);
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        Request->SetHeader(TEXT("X-Server-Key"), AnalyticsServerKey);
+        Request->SetContentAsString(Content);
+        Request->ProcessRequest();
+
+        Records.Reset();
+    };
+
+    for (TConstSetBitIterator<> It(Dirty); It; ++It)
+    {
+        const int32 Id = It.GetIndex();
+        const FCombatStats Stats = GetCombatStats(Id);
+
+        TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("matchId"), MatchId);
+        Data->SetNumberField(TEXT("combatantId"), Id);
+        Data->SetStringField(TEXT("name"), Names[Id]);
+        Data->SetNumberField(TEXT("teamId"), TeamIds[Id]);
+        Data->SetNumberField(TEXT("kills"), Stats.Kills);
+        Data->SetNumberField(TEXT("deaths"), Stats.Deaths);
+        Data->SetNumberField(TEXT("shotsFired"), Stats.ShotsFired);
+        Data->SetNumberField(TEXT("shotsHit"), Stats.ShotsHit);
+        Data->SetNumberField(TEXT("damageDealt"), Stats.TotalDamageDealt);
+        Data->SetNumberField(TEXT("damageTaken"), Stats.TotalDamageTaken);
+        Data->SetNumberField(TEXT("accuracy"), Stats.Accuracy);
+        Data->SetNumberField(TEXT("killDeathRatio"), Stats.KillDeathRatio);
+
+        TSharedRef<FJsonObject> Record = MakeShared<FJsonObject>();
+        Record->SetStringField(TEXT("event"), TEXT("combat_stats"));
+        Record->SetObjectField(TEXT("data"), Data);
+        Records.Add(MakeShared<FJsonValueObject>(Record));
+
+        if (Records.Num() >= BatchSize)
+        {
+            SendBatch();
+        }
+    }
+
+    if (Records.Num() > 0)
+    {
+        SendBatch();
+    }
+
+    Dirty.SetRange(0, Dirty.Num(), false);
+}
+
+FCombatTelemetryRing* UCombatTelemetrySubsystem::GetThreadRing()
+{
+    for (const FThreadTelemetryRing& Cached : ThreadTelemetryRings)
+    {
+        if (Cached.StreamId == StreamId)
+        {
+            return Cached.Ring;
+        }
+    }
+
+    // First event from this thread for this world
+    FCombatTelemetryRing* Ring = nullptr;
+    {
+        FScopeLock Lock(&RingLock);
+        Ring = Rings.Add_GetRef(MakeUnique<FCombatTelemetryRing>()).Get();
+    }
+
+    if (ThreadTelemetryRings.Num() >= MaxCachedThreadRings)
+    {
+        ThreadTelemetryRings.RemoveAt(0);
+    }
+    ThreadTelemetryRings.Add({ StreamId, Ring });
+    return Ring;
+}
+
+void UCombatTelemetrySubsystem::DrainEvents()
+{
+    FScopeLock Lock(&RingLock);
+    for (const TUniquePtr<FCombatTelemetryRing>& Ring : Rings)
+    {
+        Ring->Drain([this](const FCombatTelemetryEvent& Event)
+        {
+            ApplyEvent(Event);
+        });
+        NumDroppedEvents += Ring->NumDropped.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+void UCombatTelemetrySubsystem::ApplyEvent(const FCombatTelemetryEvent& Event)
+{
+    const bool bValidInstigator = Names.IsValidIndex(Event.Instigator);
+    const bool bValidTarget = Names.IsValidIndex(Event.Target);
+
+    switch (Event.Type)
+    {
+    case ECombatTelemetryEventType::Shot:
+        if (bValidInstigator)
+        {
+            ShotsFired[Event.Instigator]++;
+        }
+        break;
+
+    case ECombatTelemetryEventType::Hit:
+        if (bValidInstigator)
+        {
+            ShotsHit[Event.Instigator]++;
+        }
+        break;
+
+    case ECombatTelemetryEventType::Damage:
+        if (bValidInstigator)
+        {
+            DamageDealt[Event.Instigator] += Event.Amount;
+        }
+        if (bValidTarget)
+        {
+            DamageTaken[Event.Target] += Event.Amount;
+        }
+        break;
+
+    case ECombatTelemetryEventType::Kill:
+        if (bValidInstigator && Event.Instigator != Event.Target)
+        {
+            Kills[Event.Instigator]++;
+        }
+        if (bValidTarget)
+        {
+            Deaths[Event.Target]++;
+        }
+        break;
+    }
+
+    if (bValidInstigator)
+    {
+        Dirty[Event.Instigator] = true;
+    }
+    if (bValidTarget)
+    {
+        Dirty[Event.Target] = true;
+    }
+}
+
+bool UCombatTelemetrySubsystem::IsExportEnabled() const
+{
+    const UWorld* World = GetWorld();
+    return !AnalyticsEndpoint.IsEmpty() && World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
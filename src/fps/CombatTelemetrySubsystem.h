@@ -0,0 +1,157 @@
+// CombatTelemetrySubsystem.h
+// Combat Telemetry Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the per-thread combat event rings and the per-match stats store they drain into
+// Feature Context: Replaces UCombatSystem::UpdateCombatStats, whose counters never reached the stats GetCombatStats returned
+// Dependencies: Unreal Engine world subsystems, HTTP and JSON modules, cloud analytics service (/api/analytics/track-batch)
+// Usage Example: CombatTelemetry->RecordEvent(ECombatTelemetryEventType::Shot, TelemetryId, INDEX_NONE)
+// Security: Only servers export; records carry combatant names and counters, never player credentials
+// Performance: Recording is a ring write with no lock or allocation; the store is drained and exported on the game thread
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+#include "CombatTelemetrySubsystem.generated.h"
+
+// Forward declarations
+class UCombatSystem;
+struct FCombatStats;
+
+enum class ECombatTelemetryEventType : uint8
+{
+    Shot,
+    Hit,
+    Damage,
+    Kill
+};
+
+// 16 bytes; ids come from UCombatTelemetrySubsystem::RegisterCombatant
+struct FCombatTelemetryEvent
+{
+    int32 Instigator;
+    int32 Target;
+    float Amount;
+    ECombatTelemetryEventType Type;
+};
+
+// Single-producer ring owned by one thread; the game thread is the only consumer
+struct FCombatTelemetryRing
+{
+    static constexpr uint32 Capacity = 4096; // power of two
+
+    FCombatTelemetryEvent Events[Capacity];
+    std::atomic<uint32> Head{ 0 };
+    std::atomic<uint32> Tail{ 0 };
+    std::atomic<uint32> NumDropped{ 0 };
+
+    // False, and counted, when the consumer has fallen a full ring behind
+    bool Push(const FCombatTelemetryEvent& Event)
+    {
+        const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+        if (CurrentHead - Tail.load(std::memory_order_acquire) >= Capacity)
+        {
+            NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Events[CurrentHead & (Capacity - 1)] = Event;
+        Head.store(CurrentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename FunctorType>
+    void Drain(FunctorType&& Functor)
+    {
+        const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+        const uint32 CurrentHead = Head.load(std::memory_order_acquire);
+        for (uint32 Index = CurrentTail; Index != CurrentHead; Index++)
+        {
+            Functor(Events[Index & (Capacity - 1)]);
+        }
+        Tail.store(CurrentHead, std::memory_order_release);
+    }
+};
+
+// World-level combat telemetry and per-match stats
+UCLASS(Config = Game)
+class CELESTIALSYNDICATE_API UCombatTelemetrySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatTelemetrySubsystem();
+
+    // USubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Game thread. Ids are never reused within a match, so stats outlive their combatant
+    int32 RegisterCombatant(const UCombatSystem* Combat);
+    int32 RegisterCombatant(const FString& Name, int32 TeamId);
+
+    // Game thread. For combatants whose team changed after registration, e.g. on crowd promotion
+    void UpdateCombatantTeam(int32 CombatantId, int32 TeamId);
+
+    // Any thread. INDEX_NONE marks an absent instigator or target
+    void RecordEvent(ECombatTelemetryEventType Type, int32 Instigator, int32 Target, float Amount = 0.0f);
+
+    // Stats as of the last drain
+    FCombatStats GetCombatStats(int32 CombatantId) const;
+    void ResetCombatant(int32 CombatantId);
+
+    // Sends every combatant whose stats changed since the last export
+    void ExportStats();
+
+    int32 GetNumCombatants() const { return Names.Num(); }
+    int64 GetNumDroppedEvents() const { return NumDroppedEvents; }
+
+    // Batch endpoint of the cloud analytics service; export is disabled when empty
+    UPROPERTY(Config)
+    FString AnalyticsEndpoint;
+
+    // Sent as X-Server-Key; the batch endpoint rejects requests without the service's server key
+    UPROPERTY(Config)
+    FString AnalyticsServerKey;
+
+    // Seconds between exports; the remainder is sent when the world ends
+    UPROPERTY(Config)
+    float ExportInterval;
+
+    // Records per request, within the service's batch limit
+    UPROPERTY(Config)
+    int32 MaxRecordsPerBatch;
+
+private:
+    FCombatTelemetryRing* GetThreadRing();
+    void DrainEvents();
+    void ApplyEvent(const FCombatTelemetryEvent& Event);
+    bool IsExportEnabled() const;
+
+    // Distinguishes this subsystem in each thread's ring cache; never reused
+    uint32 StreamId;
+
+    // Taken when a thread creates its ring and once per drain, never per event
+    FCriticalSection RingLock;
+    TArray<TUniquePtr<FCombatTelemetryRing>> Rings;
+
+    // Stats store, one entry per registered combatant
+    TArray<FString> Names;
+    TArray<int32> TeamIds;
+    TArray<int32> Kills;
+    TArray<int32> Deaths;
+    TArray<int32> ShotsFired;
+    TArray<int32> ShotsHit;
+    TArray<float> DamageDealt;
+    TArray<float> DamageTaken;
+    TBitArray<> Dirty;
+
+    FString MatchId;
+    double NextExportTime;
+    int64 NumDroppedEvents;
+};
@@ -0,0 +1,58 @@
+// CombatTimeoutSubsystem.cpp
+// Combat Timeout Subsystem for Celestial Syndicate
+// Quantum Documentation: Implements the heap of combatant wake-ups and their dispatch
+// Feature Context: Lets idle combatants cost nothing per frame between damage, regen and leaving combat
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: Ticked by the world once per frame; dispatches every wake-up that is due
+// Security: Superseded entries are recognised by generation and skipped
+// Performance: The loop exits on the first entry still in the future
+
+#include "CombatTimeoutSubsystem.h"
+#include "CombatProfiling.h"
+#include "CombatSystem.h"
+#include "Engine/World.h"
+
+void UCombatTimeoutSubsystem::Tick(float DeltaTime)
+{
+    CELESTIAL_COMBAT_SCOPE(CombatTimeouts);
+
+    const double WorldTime = GetWorld()->GetTimeSeconds();
+
+    while (Timeouts.Num() > 0 && Timeouts.HeapTop().WorldTime <= WorldTime)
+    {
+        FCombatTimeout Timeout;
+        Timeouts.HeapPop(Timeout, false);
+
+        UCombatSystem* Combat = Timeout.Combat.Get();
+        if (!Combat || Combat->TimeoutGeneration != Timeout.Generation)
+        {
+            continue;
+        }
+
+        Combat->ScheduledTimeoutTime = 0.0;
+        Combat->HandleCombatTimeout(WorldTime);
+    }
+}
+
+TStatId UCombatTimeoutSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTimeoutSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatTimeoutSubsystem::ScheduleTimeout(UCombatSystem* Combat, double WorldTime)
+{
+    if (!Combat || (Combat->ScheduledTimeoutTime > 0.0 && Combat->ScheduledTimeoutTime <= WorldTime))
+    {
+        return;
+    }
+
+    // An earlier wake-up supersedes the queued one
+    Combat->TimeoutGeneration++;
+    Combat->ScheduledTimeoutTime = WorldTime;
+
+    FCombatTimeout Timeout;
+    Timeout.WorldTime = WorldTime;
+    Timeout.Combat = Combat;
+    Timeout.Generation = Combat->TimeoutGeneration;
+    Timeouts.HeapPush(Timeout);
+}
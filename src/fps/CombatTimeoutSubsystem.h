@@ -0,0 +1,47 @@
+// CombatTimeoutSubsystem.h
+// Combat Timeout Subsystem Header for Celestial Syndicate
+// Quantum Documentation: Describes the world-level queue that wakes combatants when a combat timeout or regen ends
+// Feature Context: Replaces UCombatSystem's looping shield timer, per-hit timer resets and per-tick combat-state polling
+// Dependencies: Unreal Engine world subsystems, CombatSystem
+// Usage Example: UCombatSystem::ScheduleCombatTimeout calls ScheduleTimeout with the earliest time its state can change
+// Security: Game-thread only; entries hold weak pointers and are dropped once their combatant is gone
+// Performance: One heap entry per combatant at most; a hit that only extends a timeout costs a comparison
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTimeoutSubsystem.generated.h"
+
+// Forward declarations
+class UCombatSystem;
+
+// Queued wake-up, ordered by world time
+struct FCombatTimeout
+{
+    double WorldTime;
+    TWeakObjectPtr<UCombatSystem> Combat;
+    uint32 Generation;
+
+    bool operator<(const FCombatTimeout& Other) const { return WorldTime < Other.WorldTime; }
+};
+
+// World-level combat timeout scheduler
+UCLASS()
+class CELESTIALSYNDICATE_API UCombatTimeoutSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Wakes Combat at WorldTime; ignored when an earlier wake-up is already queued, which reschedules itself
+    void ScheduleTimeout(UCombatSystem* Combat, double WorldTime);
+
+    int32 GetNumQueuedTimeouts() const { return Timeouts.Num(); }
+
+private:
+    TArray<FCombatTimeout> Timeouts;
+};
@@ -0,0 +1,60 @@
+// ReplicatedCombatState.cpp
+// Compact Replicated Combat State for Celestial Syndicate
+// Quantum Documentation: Implements quantization of combat state to and from its wire form
+// Feature Context: Serialized whenever UCombatSystem::ReplicatedCombatState changes
+// Dependencies: Unreal Engine networking (NetSerialize)
+// Usage Example: Client: CurrentHealth = ReplicatedCombatState.GetHealth(MaxHealth)
+// Security: Fractions decode into [0, 1] of the receiver's own maxima
+// Performance: No allocation; two fixed-point conversions per field
+
+#include "ReplicatedCombatState.h"
+
+namespace
+{
+    uint16 QuantizeFraction(float Value, float Max)
+    {
+        const float Fraction = Max > 0.0f ? FMath::Clamp(Value / Max, 0.0f, 1.0f) : 0.0f;
+        return static_cast<uint16>(FMath::RoundToInt(Fraction * MAX_uint16));
+    }
+
+    float DequantizeFraction(uint16 Value, float Max)
+    {
+        return static_cast<float>(Value) / MAX_uint16 * Max;
+    }
+}
+
+FReplicatedCombatState FReplicatedCombatState::Pack(float InHealth, float MaxHealth, float InShield, float MaxShield, bool bInCombat)
+{
+    FReplicatedCombatState Result;
+    Result.Health = QuantizeFraction(InHealth, MaxHealth);
+    if (InHealth > 0.0f && Result.Health == 0)
+    {
+        Result.Health = 1;
+    }
+    Result.Shield = QuantizeFraction(InShield, MaxShield);
+    Result.bIsInCombat = bInCombat;
+    return Result;
+}
+
+float FReplicatedCombatState::GetHealth(float MaxHealth) const
+{
+    return DequantizeFraction(Health, MaxHealth);
+}
+
+float FReplicatedCombatState::GetShield(float MaxShield) const
+{
+    return DequantizeFraction(Shield, MaxShield);
+}
+
+bool FReplicatedCombatState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Ar << Health;
+    Ar << Shield;
+
+    uint8 bInCombatBit = bIsInCombat ? 1 : 0;
+    Ar.SerializeBits(&bInCombatBit, 1);
+    bIsInCombat = bInCombatBit != 0;
+
+    bOutSuccess = true;
+    return true;
+}
@@ -0,0 +1,53 @@
+// ReplicatedCombatState.h
+// Compact Replicated Combat State Header for Celestial Syndicate
+// Quantum Documentation: Describes the quantized health, shield and combat flag sent to clients as one property
+// Feature Context: Replaces independent CurrentHealth, CurrentShield and bIsInCombat replication on UCombatSystem
+// Dependencies: Unreal Engine networking (NetSerialize)
+// Usage Example: ReplicatedCombatState = FReplicatedCombatState::Pack(Health, MaxHealth, Shield, ShieldCapacity, bIsInCombat)
+// Security: Quantized fractions are clamped on read, so a malformed packet cannot exceed the receiver's maxima
+// Performance: 33 bits per update; health and shield always arrive together, so OnRep sees a consistent pair
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicatedCombatState.generated.h"
+
+// Health and shield as 16-bit fractions of their maxima, plus the combat flag
+USTRUCT()
+struct CELESTIALSYNDICATE_API FReplicatedCombatState
+{
+    GENERATED_BODY()
+
+    uint16 Health;
+    uint16 Shield;
+    bool bIsInCombat;
+
+    FReplicatedCombatState()
+    {
+        Health = MAX_uint16;
+        Shield = MAX_uint16;
+        bIsInCombat = false;
+    }
+
+    // Living combatants never quantize to zero health
+    static FReplicatedCombatState Pack(float InHealth, float MaxHealth, float InShield, float MaxShield, bool bInCombat);
+    float GetHealth(float MaxHealth) const;
+    float GetShield(float MaxShield) const;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FReplicatedCombatState& Other) const
+    {
+        return Health == Other.Health && Shield == Other.Shield && bIsInCombat == Other.bIsInCombat;
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedCombatState> : public TStructOpsTypeTraitsBase2<FReplicatedCombatState>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true
+    };
+};
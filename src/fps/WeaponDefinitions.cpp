@@ -0,0 +1,102 @@
+// WeaponDefinitions.cpp
+// Weapon Definitions for Celestial Syndicate
+// Quantum Documentation: Implements baking of weapon definitions and per-skeleton bone damage tables
+// Feature Context: Gives every combatant the same loadout without copying or re-parsing it
+// Dependencies: Unreal Engine data assets and data tables, skinned mesh reference skeletons
+// Usage Example: UCombatSystem::InitializeWeaponSystems calls GetWeaponTable; CalculateDamage calls GetBoneDamageTable
+// Security: Baking reads only asset properties and produces new immutable tables
+// Performance: Bone rules are matched against each skeleton's bone names once, then never again
+
+#include "WeaponDefinitions.h"
+#include "Engine/SkinnedAsset.h"
+
+UWeaponDefinitionSet::UWeaponDefinitionSet()
+{
+    WeaponTable = nullptr;
+
+    // Default loadout
+    Weapons.Add(FWeaponData(EWeaponType::PulseRifle, TEXT("PulseRifle"), 30, 100.0f, 0.1f, 800.0f));
+    Weapons.Add(FWeaponData(EWeaponType::PlasmaCannon, TEXT("PlasmaCannon"), 10, 200.0f, 0.5f, 600.0f));
+    Weapons.Add(FWeaponData(EWeaponType::QuantumBlaster, TEXT("QuantumBlaster"), 5, 500.0f, 1.0f, 1200.0f));
+
+    // Head, body, then limbs
+    BoneDamageRules.Add(FBoneDamageRule(TEXT("head"), true, 2.0f));
+    BoneDamageRules.Add(FBoneDamageRule(TEXT("spine_01"), true, 1.5f));
+    BoneDamageRules.Add(FBoneDamageRule(TEXT("spine_02"), true, 1.5f));
+    BoneDamageRules.Add(FBoneDamageRule(TEXT("arm"), false, 0.7f));
+    BoneDamageRules.Add(FBoneDamageRule(TEXT("leg"), false, 0.7f));
+}
+
+FWeaponDefinitionTablePtr UWeaponDefinitionSet::GetWeaponTable() const
+{
+    if (!CachedWeaponTable.IsValid())
+    {
+        CachedWeaponTable = BakeWeaponTable();
+    }
+    return CachedWeaponTable;
+}
+
+FBoneDamageTablePtr UWeaponDefinitionSet::GetBoneDamageTable(const USkinnedAsset* Mesh) const
+{
+    if (!Mesh)
+    {
+        return nullptr;
+    }
+
+    FBoneDamageTablePtr& Table = CachedBoneDamageTables.FindOrAdd(Mesh);
+    if (!Table.IsValid())
+    {
+        Table = BakeBoneDamageTable(Mesh);
+    }
+    return Table;
+}
+
+FWeaponDefinitionTablePtr UWeaponDefinitionSet::BakeWeaponTable() const
+{
+    TSharedRef<FWeaponDefinitionTable, ESPMode::ThreadSafe> Table = MakeShared<FWeaponDefinitionTable, ESPMode::ThreadSafe>();
+
+    if (WeaponTable && WeaponTable->GetRowStruct() && WeaponTable->GetRowStruct()->IsChildOf(FWeaponData::StaticStruct()))
+    {
+        TArray<FWeaponData*> Rows;
+        WeaponTable->GetAllRows<FWeaponData>(TEXT("UWeaponDefinitionSet::BakeWeaponTable"), Rows);
+
+        Table->Weapons.Reserve(Rows.Num());
+        for (const FWeaponData* Row : Rows)
+        {
+            Table->Weapons.Add(*Row);
+        }
+    }
+    else
+    {
+        Table->Weapons = Weapons;
+    }
+
+    return Table;
+}
+
+FBoneDamageTablePtr UWeaponDefinitionSet::BakeBoneDamageTable(const USkinnedAsset* Mesh) const
+{
+    TSharedRef<FBoneDamageTable, ESPMode::ThreadSafe> Table = MakeShared<FBoneDamageTable, ESPMode::ThreadSafe>();
+
+    const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+    const int32 NumBones = RefSkeleton.GetNum();
+    Table->Multipliers.Init(1.0f, NumBones);
+
+    for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+    {
+        const FString BoneName = RefSkeleton.GetBoneName(BoneIndex).ToString();
+        for (const FBoneDamageRule& Rule : BoneDamageRules)
+        {
+            const bool bMatches = Rule.bExactMatch
+                ? BoneName.Equals(Rule.BoneName, ESearchCase::IgnoreCase)
+                : BoneName.Contains(Rule.BoneName);
+            if (bMatches)
+            {
+                Table->Multipliers[BoneIndex] = Rule.Multiplier;
+                break;
+            }
+        }
+    }
+
+    return Table;
+}
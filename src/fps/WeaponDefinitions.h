@@ -0,0 +1,173 @@
+// WeaponDefinitions.h
+// Weapon Definitions Header for Celestial Syndicate
+// Quantum Documentation: Describes weapon definition assets and the immutable tables they bake into
+// Feature Context: Replaces the loadout hard-coded in UCombatSystem::InitializeWeaponSystems and its per-hit bone name checks
+// Dependencies: Unreal Engine data assets and data tables, skinned mesh reference skeletons
+// Usage Example: Assign a definition set to UCombatSystem::WeaponDefinitions; combatants share its baked tables
+// Security: Baked tables are immutable and shared, so worker threads read them without locking
+// Performance: Weapon stats and bone multipliers are array lookups; bone names are matched once per skeleton
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/DataTable.h"
+#include "WeaponDefinitions.generated.h"
+
+// Forward declarations
+class AWeapon;
+class USkinnedAsset;
+
+// Weapon types enumeration
+UENUM(BlueprintType)
+enum class EWeaponType : uint8
+{
+    PulseRifle     UMETA(DisplayName = "Pulse Rifle"),
+    PlasmaCannon   UMETA(DisplayName = "Plasma Cannon"),
+    QuantumBlaster UMETA(DisplayName = "Quantum Blaster"),
+    LaserRifle     UMETA(DisplayName = "Laser Rifle"),
+    IonCannon      UMETA(DisplayName = "Ion Cannon"),
+    MissileLauncher UMETA(DisplayName = "Missile Launcher")
+};
+
+// Weapon data structure; also the row type of weapon data tables
+USTRUCT(BlueprintType)
+struct FWeaponData : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EWeaponType WeaponType;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString WeaponName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MaxAmmo;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Damage;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float FireRate;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Range;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float ReloadTime;
+
+    // Presentation only; spawned while the weapon is equipped. May be left empty
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSubclassOf<AWeapon> WeaponClass;
+
+    FWeaponData()
+    {
+        WeaponType = EWeaponType::PulseRifle;
+        WeaponName = TEXT("Default Weapon");
+        MaxAmmo = 30;
+        Damage = 100.0f;
+        FireRate = 0.1f;
+        Range = 800.0f;
+        ReloadTime = 2.0f;
+        WeaponClass = nullptr;
+    }
+
+    FWeaponData(EWeaponType InWeaponType, const FString& InWeaponName, int32 InMaxAmmo, float InDamage, float InFireRate, float InRange)
+        : FWeaponData()
+    {
+        WeaponType = InWeaponType;
+        WeaponName = InWeaponName;
+        MaxAmmo = InMaxAmmo;
+        Damage = InDamage;
+        FireRate = InFireRate;
+        Range = InRange;
+    }
+};
+
+// Damage multiplier for bones whose name equals, or contains, BoneName (case-insensitive)
+USTRUCT(BlueprintType)
+struct FBoneDamageRule
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString BoneName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bExactMatch;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Multiplier;
+
+    FBoneDamageRule()
+    {
+        bExactMatch = true;
+        Multiplier = 1.0f;
+    }
+
+    FBoneDamageRule(const FString& InBoneName, bool bInExactMatch, float InMultiplier)
+    {
+        BoneName = InBoneName;
+        bExactMatch = bInExactMatch;
+        Multiplier = InMultiplier;
+    }
+};
+
+// Contiguous weapon definitions; combatants refer to entries by index
+struct CELESTIALSYNDICATE_API FWeaponDefinitionTable
+{
+    TArray<FWeaponData> Weapons;
+
+    const FWeaponData* Find(int32 Index) const
+    {
+        return Weapons.IsValidIndex(Index) ? &Weapons[Index] : nullptr;
+    }
+};
+
+typedef TSharedPtr<const FWeaponDefinitionTable, ESPMode::ThreadSafe> FWeaponDefinitionTablePtr;
+
+// Damage multiplier per bone index of one skeleton
+struct CELESTIALSYNDICATE_API FBoneDamageTable
+{
+    TArray<float> Multipliers;
+
+    float GetMultiplier(int32 BoneIndex) const
+    {
+        return Multipliers.IsValidIndex(BoneIndex) ? Multipliers[BoneIndex] : 1.0f;
+    }
+};
+
+typedef TSharedPtr<const FBoneDamageTable, ESPMode::ThreadSafe> FBoneDamageTablePtr;
+
+// Loadout and hit-location rules shared by every combatant that references the asset
+UCLASS(BlueprintType)
+class CELESTIALSYNDICATE_API UWeaponDefinitionSet : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UWeaponDefinitionSet();
+
+    // FWeaponData rows; when set, replaces Weapons
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapons")
+    UDataTable* WeaponTable;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapons")
+    TArray<FWeaponData> Weapons;
+
+    // First matching rule wins; unmatched bones take 1.0
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapons")
+    TArray<FBoneDamageRule> BoneDamageRules;
+
+    // Baked on first call and shared afterwards. Game thread only
+    FWeaponDefinitionTablePtr GetWeaponTable() const;
+    FBoneDamageTablePtr GetBoneDamageTable(const USkinnedAsset* Mesh) const;
+
+private:
+    FWeaponDefinitionTablePtr BakeWeaponTable() const;
+    FBoneDamageTablePtr BakeBoneDamageTable(const USkinnedAsset* Mesh) const;
+
+    mutable FWeaponDefinitionTablePtr CachedWeaponTable;
+    mutable TMap<TWeakObjectPtr<const USkinnedAsset>, FBoneDamageTablePtr> CachedBoneDamageTables;
+};